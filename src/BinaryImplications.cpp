@@ -0,0 +1,85 @@
+/**
+ * @file BinaryImplications.cpp
+ * @author Anton Reinhard
+ * @brief Binary implication graph implementation
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "BinaryImplications.h"
+
+#include <algorithm>
+#include <iterator>
+#include <cstdlib>
+
+namespace preppy::cnf {
+
+   void BinaryImplications::add(const ClauseRef clause, const int first, const int second) {
+      const std::size_t variable = static_cast<std::size_t>(std::max(std::abs(first), std::abs(second)));
+      if (2 * variable + 2 > this->lists.size()) {
+         this->lists.resize(2 * variable + 2);
+      }
+      this->lists[literalIndex(-first)].push_back({second, clause});
+      this->lists[literalIndex(-second)].push_back({first, clause});
+      ++this->clauses;
+   }
+
+   void BinaryImplications::remove(const ClauseRef clause, const int first, const int second) {
+      const bool removedFirst = this->removeImplication(-first, clause);
+      const bool removedSecond = this->removeImplication(-second, clause);
+      if (removedFirst || removedSecond) {
+         --this->clauses;
+      }
+      else if (nullptr != this->shared) {
+         // the implications are part of the shared lists, which can't be changed
+         ++this->removedShared;
+      }
+   }
+
+   void BinaryImplications::restore(const ClauseRef clause, const int first, const int second) {
+      const std::vector<Implication>& list = this->getShared(-first);
+      const bool isShared = std::any_of(list.begin(), list.end(), [clause](const Implication& implication) {
+         return implication.clause == clause;
+      });
+      if (isShared && 0 != this->removedShared) {
+         --this->removedShared;
+      }
+      else {
+         this->add(clause, first, second);
+      }
+   }
+
+   void BinaryImplications::clear(const unsigned maxVariable) {
+      for (auto& list : this->lists) {
+         list.clear();
+      }
+      if (this->lists.size() < 2 * static_cast<std::size_t>(maxVariable) + 2) {
+         this->lists.resize(2 * static_cast<std::size_t>(maxVariable) + 2);
+      }
+      this->clauses = 0;
+      this->shared.reset();
+      this->removedShared = 0;
+   }
+
+   bool BinaryImplications::removeImplication(const int literal, const ClauseRef clause) {
+      const std::size_t index = literalIndex(literal);
+      if (index >= this->lists.size()) {
+         return false;
+      }
+
+      // recently added clauses are removed most often, e.g. when a formula is used as a stack, so search from the back
+      auto& list = this->lists[index];
+      const auto position = std::find_if(list.rbegin(), list.rend(), [clause](const Implication& implication) {
+         return implication.clause == clause;
+      });
+      if (position == list.rend()) {
+         return false;
+      }
+      list.erase(std::next(position).base());
+      return true;
+   }
+
+}
@@ -0,0 +1,274 @@
+/**
+ * @file BinaryImplications.h
+ * @author Anton Reinhard
+ * @brief Binary implication graph header
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include "definitions.h"
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <cstddef>
+
+namespace preppy::cnf {
+
+   /**
+    * @brief A single edge of the implication graph
+    *
+    */
+   struct Implication {
+      /**
+       * @brief The literal that has to be true as well
+       *
+       */
+      int literal;
+
+      /**
+       * @brief The binary clause the implication comes from
+       *
+       */
+      ClauseRef clause;
+   };
+
+   /**
+    * @brief The implication graph of the binary clauses of a formula, indexed by literalIndex()
+    *
+    * @details A binary clause (a b) is stored as the two implications -a -> b and -b -> a, so the list of a literal
+    * holds every literal that becomes true when the literal is set to true. Unlike the watch lists, entries are removed
+    * right away when their clause is removed, so the lists never have to be checked against the clauses.
+    *
+    * The lists can be shared with the implications of a snapshot, see share(). Both then keep the shared lists
+    * unchanged and only add to lists of their own, so users have to visit getShared() as well as operator[]. Unlike the
+    * own lists the shared lists can contain implications of removed clauses.
+    */
+   class BinaryImplications {
+   public:
+
+      /**
+       * @brief Construct an empty implication graph
+       *
+       */
+      BinaryImplications() = default;
+
+      /**
+       * @brief Adds the implications of a binary clause
+       *
+       * @param clause The reference of the clause
+       * @param first The first literal of the clause
+       * @param second The second literal of the clause
+       */
+      void add(ClauseRef clause, int first, int second);
+
+      /**
+       * @brief Removes the implications of a binary clause, does nothing for implications that are not stored. The
+       * implications of a shared clause are only counted as removed
+       *
+       * @param clause The reference of the clause
+       * @param first The first literal of the clause
+       * @param second The second literal of the clause
+       */
+      void remove(ClauseRef clause, int first, int second);
+
+      /**
+       * @brief Adds the implications of a removed binary clause back. Implications that are still part of the shared
+       * lists are only counted as not removed anymore
+       *
+       * @param clause The reference of the clause
+       * @param first The first literal of the clause
+       * @param second The second literal of the clause
+       */
+      void restore(ClauseRef clause, int first, int second);
+
+      /**
+       * @brief Removes all implications and makes room for the literals of the given number of variables
+       *
+       * @param maxVariable The maximum variable that will occur
+       */
+      void clear(unsigned maxVariable = 0);
+
+      /**
+       * @brief Get the literals implied by a literal
+       *
+       * @param literal The literal that is set to true
+       * @return const std::vector<Implication>& The literals that have to be true as well, with their clauses
+       */
+      inline const std::vector<Implication>& operator[](const int literal) const {
+         const std::size_t index = literalIndex(literal);
+         return index < this->lists.size() ? this->lists[index] : this->none;
+      }
+
+      /**
+       * @brief Get the number of binary clauses in the graph
+       *
+       * @return std::size_t The number of binary clauses
+       */
+      inline std::size_t size() const {
+         return (nullptr != this->shared) ? this->clauses + this->shared->clauses - this->removedShared : this->clauses;
+      }
+
+      /**
+       * @brief Checks whether there are no binary clauses in the graph
+       *
+       * @return bool True if there are no implications
+       */
+      inline bool empty() const {
+         return 0 == this->size();
+      }
+
+      /**
+       * @brief Moves all implications into lists that are shared with the returned implications. Both continue with
+       * empty lists of their own on top of the shared ones, which stay unchanged as long as they are shared
+       *
+       * @param isRemoved Returns true for the reference of every removed clause
+       * @return BinaryImplications Implications with the same clauses
+       */
+      template<typename Predicate>
+      BinaryImplications share(Predicate isRemoved) {
+         if (nullptr != this->shared && (0 != this->clauses || 0 != this->removedShared)) {
+            // the own lists changed the shared ones, one level of sharing keeps visiting the implications cheap
+            this->unshare(isRemoved);
+         }
+         if (nullptr == this->shared) {
+            this->shared = std::make_shared<BinaryImplications>();
+            this->shared->lists = std::move(this->lists);
+            this->shared->clauses = this->clauses;
+            this->lists.clear();
+            this->clauses = 0;
+         }
+
+         BinaryImplications copy;
+         copy.shared = this->shared;
+         return copy;
+      }
+
+      /**
+       * @brief Merges the shared lists back into the own lists, dropping the implications of removed clauses. They are
+       * taken over if no other implications use them anymore, otherwise they are copied
+       *
+       * @param isRemoved Returns true for the reference of every removed clause
+       */
+      template<typename Predicate>
+      void unshare(Predicate isRemoved) {
+         if (nullptr == this->shared) {
+            return;
+         }
+
+         std::vector<std::vector<Implication>> merged;
+         if (this->isLastSharer()) {
+            merged = std::move(this->shared->lists);
+         }
+         else {
+            merged = this->shared->lists;
+         }
+         if (0 != this->removedShared) {
+            for (auto& list : merged) {
+               list.erase(std::remove_if(list.begin(), list.end(), [&isRemoved](const Implication& implication) {
+                  return isRemoved(implication.clause);
+               }), list.end());
+            }
+         }
+         if (merged.size() < this->lists.size()) {
+            merged.resize(this->lists.size());
+         }
+         // the own implications were added after the shared ones, so they stay behind them
+         for (std::size_t i = 0; i < this->lists.size(); ++i) {
+            merged[i].insert(merged[i].end(), this->lists[i].begin(), this->lists[i].end());
+         }
+
+         this->clauses = this->size();
+         this->lists = std::move(merged);
+         this->shared.reset();
+         this->removedShared = 0;
+      }
+
+      /**
+       * @brief Checks whether these are the only implications still using their shared lists
+       *
+       * @return bool True if unshare() doesn't need to copy
+       */
+      inline bool isLastSharer() const {
+         return nullptr != this->shared && 1 == this->shared.use_count();
+      }
+
+      /**
+       * @brief Checks whether there are shared lists
+       *
+       * @return bool True if getShared() has to be visited as well
+       */
+      inline bool hasShared() const {
+         return nullptr != this->shared;
+      }
+
+      /**
+       * @brief Get the shared implications of a literal, visited before the own ones
+       *
+       * @param literal The literal that is set to true
+       * @return const std::vector<Implication>& The shared implications, check whether their clause was removed
+       */
+      inline const std::vector<Implication>& getShared(const int literal) const {
+         const std::size_t index = literalIndex(literal);
+         return (nullptr != this->shared && index < this->shared->lists.size()) ? this->shared->lists[index] : this->none;
+      }
+
+      /**
+       * @brief Get the number of literal indices covered by the lists, every literal with an implication has a smaller
+       * literalIndex()
+       *
+       * @return std::size_t The number of covered literal indices, own and shared
+       */
+      inline std::size_t getIndexRange() const {
+         return (nullptr != this->shared) ? std::max(this->lists.size(), this->shared->lists.size()) : this->lists.size();
+      }
+
+   private:
+
+      /**
+       * @brief Removes one implication of a clause from the list of a literal
+       *
+       * @param literal The implying literal
+       * @param clause The clause the implication comes from
+       * @return bool True if the implication was found
+       */
+      bool removeImplication(int literal, ClauseRef clause);
+
+      /**
+       * @brief The implications of every literal, indexed by literalIndex()
+       *
+       */
+      std::vector<std::vector<Implication>> lists;
+
+      /**
+       * @brief The number of binary clauses in the own lists
+       *
+       */
+      std::size_t clauses = 0;
+
+      /**
+       * @brief Implications that are shared with other implications, never changed while they are shared
+       *
+       */
+      std::shared_ptr<BinaryImplications> shared;
+
+      /**
+       * @brief The number of shared binary clauses that were removed
+       *
+       */
+      std::size_t removedShared = 0;
+
+      /**
+       * @brief Returned for literals that are not covered by the lists
+       *
+       */
+      std::vector<Implication> none;
+
+   };
+
+}
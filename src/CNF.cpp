@@ -12,44 +12,466 @@
 #include "CNF.h"
 #include "Clause.h"
 #include "Utility.h"
+#include "io/MappedFile.h"
+#include "io/DimacsParser.h"
+#include "io/StreamingInput.h"
+#include "io/DimacsWriter.h"
+#include "io/BinaryCnf.h"
 
 #include <vector>
 #include <set>
 #include <fstream>
 #include <string>
 #include <sstream>
+#include <iostream>
+#include <numeric>
+#include <thread>
+#include <utility>
 
 namespace preppy::cnf {
 
    CNF::CNF() 
-      : variablesDirtyBit(true) 
-      , maxVariableDirtyBit(true)
-      , totalProcessingTime(0)
+      : totalProcessingTime(0)
       , equivalence(EQUIVALENCE_TYPE::EQUIVALENT) {
 
    }
 
-   CNF::CNF(const cnf::CNF& other) {
-      *this = other;
-   }
-
-   cnf::CNF& CNF::operator=(const cnf::CNF& other) {
-      if (&other == this) {
-         return *this;
+   CNF::CNF(std::initializer_list<cnf::Clause> l)
+      : CNF() {
+      for (const auto& clause : l) {
+         this->push_back(clause);
       }
+   }
 
+   CNF::CNF(const cnf::CNF& other)
+      : CNF() {
       this->name = other.name;
       this->source = other.source;
       this->totalProcessingTime = other.totalProcessingTime;
       this->procedures = other.procedures;
       this->equivalence = other.equivalence;
+      this->compressionInformation = other.compressionInformation;
+      this->variableOccurrences = other.variableOccurrences;
+      this->variables = other.variables;
+      this->maxVariable = other.maxVariable;
+      this->maxVariableDirtyBit = other.maxVariableDirtyBit;
+      this->literals = other.literals;
+      this->occurrenceListsEnabled = other.occurrenceListsEnabled;
+
+      if (!other.isShared() && !other.arena->isFragmented()) {
+         // copy the clause storage in one piece, the references of the clauses stay valid
+         this->arena = std::make_shared<ClauseArena>(*other.arena);
+         this->clauses = other.clauses;
+         this->tombstone = other.tombstone;
+         this->firstClause = other.firstClause;
+         this->removedClauses = other.removedClauses;
+      }
+      else {
+         // the storage also holds removed clauses or the ones of snapshots, so only copy the clauses of other
+         this->arena->reserve(other.size(), other.getLiterals());
+         this->clauses.reserve(other.size());
+         for (const auto& clause : other) {
+            this->clauses.push_back(this->arena->add(clause.begin(), clause.end()));
+         }
+      }
+      this->rebuildImplications();
+      this->rebuildOccurrenceLists();
+   }
+
+   CNF::CNF(cnf::CNF&& other)
+      : CNF() {
+      this->swapContent(other);
+   }
+
+   cnf::CNF& CNF::operator=(const cnf::CNF& other) {
+      if (&other == this) {
+         return *this;
+      }
+      cnf::CNF copy(other);
+      return *this = std::move(copy);
+   }
 
-      for (const auto& clause : other) {
-         this->push_back(std::make_unique<cnf::Clause>(*clause));
+   cnf::CNF& CNF::operator=(cnf::CNF&& other) {
+      if (&other == this) {
+         return *this;
       }
+      this->recordReplacement();
+      this->swapContent(other);
       return *this;
    }
 
+   CNF::CNF(const cnf::CNF& base, SnapshotTag)
+      : CNF() {
+      this->name = base.name;
+      this->source = base.source;
+      this->totalProcessingTime = base.totalProcessingTime;
+      this->procedures = base.procedures;
+      this->equivalence = base.equivalence;
+      this->compressionInformation = base.compressionInformation;
+      this->variableOccurrences = base.variableOccurrences;
+      this->variables = base.variables;
+      this->maxVariable = base.maxVariable;
+      this->maxVariableDirtyBit = base.maxVariableDirtyBit;
+      this->literals = base.literals;
+
+      // only the references are copied, the clauses stay where they are
+      base.arena->share();
+      this->arena = base.arena;
+      this->snapshotClauses = this->arena->getClauses();
+      this->clauses = base.clauses;
+      this->firstClause = base.firstClause;
+      this->removedClauses = base.removedClauses;
+      this->removedSharedClauses = base.removedSharedClauses;
+      this->tombstone = base.tombstone;
+
+      this->implicationsDirtyBit = base.implicationsDirtyBit;
+      if (!base.implicationsDirtyBit) {
+         this->binaryImplications = base.binaryImplications.share([&base](const ClauseRef ref) {
+            return base.isRemoved(ref);
+         });
+      }
+
+      // the occurrence lists are changed in place, so they can't be shared
+      this->occurrenceListsEnabled = base.occurrenceListsEnabled;
+      this->rebuildOccurrenceLists();
+   }
+
+   CNF::~CNF() {
+      if (this->isShared()) {
+         this->releaseClauses();
+      }
+   }
+
+   CNF CNF::snapshot() const {
+      return CNF(*this, SnapshotTag());
+   }
+
+   void CNF::detachClauses() {
+      if (!this->isShared()) {
+         return;
+      }
+      // the copy keeps every clause at its place, so references and implications stay valid
+      std::shared_ptr<ClauseArena> copy = std::make_shared<ClauseArena>(*this->arena);
+      copy->unshare();
+      // the shared clauses this formula removed can be marked as removed in its own copy
+      for (const ClauseRef clause : this->removedSharedClauses) {
+         copy->remove(clause);
+      }
+      this->removedSharedClauses.clear();
+      this->releaseClauses();
+      this->arena = std::move(copy);
+      this->snapshotClauses = 0;
+      this->addedClauses = 0;
+   }
+
+   ClauseRef CNF::getTombstone() {
+      if (NO_CLAUSE == this->tombstone) {
+         const int none = 0;
+         this->tombstone = this->arena->add(&none, &none);
+         this->arena->remove(this->tombstone);
+         ++this->addedClauses;
+      }
+      return this->tombstone;
+   }
+
+   ClauseRef CNF::copySharedClause(const size_type index) {
+      const ClauseRef clause = this->clauses[index];
+      const ClauseRef copy = this->arena->add(this->arena->begin(clause), this->arena->end(clause));
+      ++this->addedClauses;
+      this->removedSharedClauses.insert(clause);
+      this->clauses[index] = copy;
+      // the entries of the shared clause are dropped lazily, like the ones of removed clauses
+      this->removeClauseFromOccurrences(clause);
+      this->addClauseToOccurrences(copy);
+      return copy;
+   }
+
+   CNF::size_type CNF::getPosition(const ClauseRef clause) {
+      if (clause >= this->positions.size() || this->positions[clause] >= this->clauses.size() || this->clauses[this->positions[clause]] != clause) {
+         this->positions.assign(this->arena->getClauses(), 0);
+         for (size_type i = 0; i < this->clauses.size(); ++i) {
+            this->positions[this->clauses[i]] = i;
+         }
+      }
+      return this->positions[clause];
+   }
+
+   void CNF::releaseClauses() noexcept {
+      ClauseArena& arena = *this->arena;
+      if (!arena.isShared(static_cast<ClauseRef>(this->snapshotClauses)) && this->snapshotClauses + this->addedClauses == arena.getClauses()) {
+         // every clause behind the snapshot was added by this formula and nobody else uses them
+         arena.truncate(static_cast<ClauseRef>(this->snapshotClauses));
+         return;
+      }
+      for (const ClauseRef clause : this->clauses) {
+         if (!arena.isShared(clause) && !arena.isDeleted(clause)) {
+            arena.remove(clause);
+         }
+      }
+   }
+
+   void CNF::beginTransaction() {
+      this->transactions.push_back({this->edits.size()});
+   }
+
+   bool CNF::commit() {
+      if (this->transactions.empty()) {
+         return false;
+      }
+      this->transactions.pop_back();
+      if (this->transactions.empty()) {
+         // nothing can be rolled back anymore
+         this->edits.clear();
+         this->trimmedReferences.clear();
+         this->droppedReferences.clear();
+         this->replacedFormulas.clear();
+      }
+      return true;
+   }
+
+   bool CNF::rollback() {
+      if (this->transactions.empty()) {
+         return false;
+      }
+      const Transaction transaction = this->transactions.back();
+      while (this->edits.size() > transaction.edits) {
+         this->undo(this->edits.back());
+         this->edits.pop_back();
+      }
+      this->transactions.pop_back();
+      return true;
+   }
+
+   void CNF::recordReplacement() {
+      if (!this->isRecording()) {
+         return;
+      }
+      if (!this->edits.empty() && EDIT::FORMULA_REPLACED == this->edits.back().type && this->edits.size() > this->transactions.back().edits) {
+         // the formula is restored to before the previous replacement anyways
+         return;
+      }
+      // the snapshot keeps every reference, so the changes recorded before stay valid for it
+      this->replacedFormulas.push_back(std::unique_ptr<cnf::CNF>(new CNF(*this, SnapshotTag())));
+      this->edits.push_back({EDIT::FORMULA_REPLACED});
+   }
+
+   void CNF::undo(const Edit& edit) {
+      // a shared clause that was only removed from this formula is given back without changing the storage
+      const bool removedShared = EDIT::CLAUSE_REMOVED == edit.type && 0 != this->removedSharedClauses.count(edit.clause);
+      if (EDIT::FORMULA_REPLACED != edit.type && EDIT::REFERENCES_DROPPED != edit.type && !removedShared && this->isSharedClause(edit.clause)) {
+         this->detachClauses();
+      }
+
+      switch (edit.type) {
+      case EDIT::CLAUSE_ADDED:
+         // the clause was added last, the arena keeps its slots until the next compaction
+         this->arena->remove(edit.clause);
+         this->removeClauseFromImplications(edit.clause);
+         this->removeClauseFromOccurrences(edit.clause);
+         this->removeClauseFromStatistics(edit.clause);
+         this->clauses.pop_back();
+         if (this->clauses.empty()) {
+            this->firstClause = 0;
+         }
+         break;
+      case EDIT::CLAUSE_REMOVED: {
+         this->clauses.insert(this->clauses.end(), this->trimmedReferences.end() - edit.trimmed, this->trimmedReferences.end());
+         this->trimmedReferences.resize(this->trimmedReferences.size() - edit.trimmed);
+         this->removedClauses += edit.trimmed;
+         --this->removedClauses;
+         this->firstClause = edit.firstClause;
+         if (removedShared) {
+            this->removedSharedClauses.erase(edit.clause);
+         }
+         else {
+            this->arena->restore(edit.clause);
+         }
+         // the position might hold the tombstone instead of the clause
+         this->clauses[edit.index] = edit.clause;
+         this->addClauseToStatistics(edit.clause);
+
+         // the binary implications were removed right away, so they are restored as well
+         const std::uint32_t size = this->arena->size(edit.clause);
+         const int* literals = this->arena->begin(edit.clause);
+         if (2 == size) {
+            this->binaryImplications.restore(edit.clause, literals[0], literals[1]);
+         }
+         if (this->occurrenceListsEnabled) {
+            this->occurrences.restore(edit.clause, literals, literals + size);
+         }
+         break;
+      }
+      case EDIT::LITERAL_ERASED: {
+         ClauseView view = this->getClause(edit.clause);
+         // a clause that became binary was added to the binary implications, which might be shared
+         if (2 == view.size()) {
+            this->binaryImplications.unshare([this](const ClauseRef ref) {
+               return this->isRemoved(ref);
+            });
+            this->binaryImplications.remove(edit.clause, view[0], view[1]);
+         }
+         const bool occurred = view.containsLiteral(edit.literal);
+         view.insert(view.begin() + edit.index, edit.literal);
+         this->addLiteralToStatistics(edit.literal);
+         // a clause that is binary again goes back to the binary implications, like eraseLiteral() does
+         this->addClauseToImplications(edit.clause);
+         if (this->occurrenceListsEnabled && !occurred) {
+            this->occurrences.addLiteral(edit.clause, edit.literal);
+         }
+         break;
+      }
+      case EDIT::REFERENCES_DROPPED:
+         this->clauses = std::move(this->droppedReferences.back());
+         this->droppedReferences.pop_back();
+         this->removedClauses = edit.index;
+         this->firstClause = edit.firstClause;
+         break;
+      case EDIT::FORMULA_REPLACED:
+         this->swapContent(*this->replacedFormulas.back());
+         this->replacedFormulas.pop_back();
+         break;
+      }
+   }
+
+   void CNF::swapContent(cnf::CNF& other) {
+      std::swap(this->arena, other.arena);
+      std::swap(this->snapshotClauses, other.snapshotClauses);
+      std::swap(this->addedClauses, other.addedClauses);
+      std::swap(this->clauses, other.clauses);
+      std::swap(this->firstClause, other.firstClause);
+      std::swap(this->removedClauses, other.removedClauses);
+      std::swap(this->removedSharedClauses, other.removedSharedClauses);
+      std::swap(this->tombstone, other.tombstone);
+      std::swap(this->positions, other.positions);
+      std::swap(this->name, other.name);
+      std::swap(this->source, other.source);
+      std::swap(this->equivalence, other.equivalence);
+      std::swap(this->totalProcessingTime, other.totalProcessingTime);
+      std::swap(this->procedures, other.procedures);
+      std::swap(this->variableOccurrences, other.variableOccurrences);
+      std::swap(this->variables, other.variables);
+      std::swap(this->maxVariable, other.maxVariable);
+      std::swap(this->maxVariableDirtyBit, other.maxVariableDirtyBit);
+      std::swap(this->literals, other.literals);
+      std::swap(this->compressionInformation, other.compressionInformation);
+      std::swap(this->compressionMap, other.compressionMap);
+      std::swap(this->decompressionMap, other.decompressionMap);
+      std::swap(this->compressionValues, other.compressionValues);
+      std::swap(this->compressionMapsDirtyBit, other.compressionMapsDirtyBit);
+      std::swap(this->binaryImplications, other.binaryImplications);
+      std::swap(this->implicationsDirtyBit, other.implicationsDirtyBit);
+      std::swap(this->occurrences, other.occurrences);
+      std::swap(this->occurrenceListsEnabled, other.occurrenceListsEnabled);
+   }
+
+   void CNF::compact() {
+      this->recordReplacement();
+      this->detachClauses();
+      // the replacement gives back the references as well. Recording their removal would restore them into the
+      // compacted storage first, where they point to the wrong clauses
+      this->clauses.erase(
+         std::remove_if(this->clauses.begin(), this->clauses.end(), [this](const ClauseRef clause) {
+            return this->arena->isDeleted(clause);
+         }),
+         this->clauses.end()
+      );
+      this->firstClause = 0;
+      this->removedClauses = 0;
+      this->arena->compact(this->clauses);
+      // the references of removed clauses are gone with the compaction
+      this->removedSharedClauses.clear();
+      this->tombstone = NO_CLAUSE;
+      this->rebuildImplications();
+      this->rebuildOccurrenceLists();
+   }
+
+   void CNF::collectGarbage() {
+      if (this->arena->isFragmented()) {
+         this->compact();
+      }
+      else {
+         this->dropRemovedReferences();
+      }
+   }
+
+   void CNF::dropRemovedReferences() {
+      if (0 == this->removedClauses) {
+         return;
+      }
+      if (this->isRecording()) {
+         this->edits.push_back({EDIT::REFERENCES_DROPPED, 0, 0, this->removedClauses, this->firstClause});
+         this->droppedReferences.push_back(this->clauses);
+      }
+      this->clauses.erase(
+         std::remove_if(this->clauses.begin(), this->clauses.end(), [this](const ClauseRef clause) {
+            return this->arena->isDeleted(clause);
+         }),
+         this->clauses.end()
+      );
+      this->firstClause = 0;
+      this->removedClauses = 0;
+   }
+
+   void CNF::rebuildImplications() {
+      this->binaryImplications.clear(this->getMaxVariable());
+      for (const ClauseRef clause : this->clauses) {
+         if (!this->arena->isDeleted(clause)) {
+            this->addClauseToImplications(clause);
+         }
+      }
+      this->implicationsDirtyBit = false;
+   }
+
+   void CNF::rebuildOccurrenceLists() {
+      if (!this->occurrenceListsEnabled) {
+         return;
+      }
+      this->occurrences.clear(this->getMaxVariable());
+      for (const ClauseRef clause : this->clauses) {
+         if (!this->arena->isDeleted(clause)) {
+            this->addClauseToOccurrences(clause);
+         }
+      }
+   }
+
+   void CNF::enableOccurrenceLists() {
+      if (this->occurrenceListsEnabled) {
+         return;
+      }
+      this->occurrenceListsEnabled = true;
+      this->rebuildOccurrenceLists();
+   }
+
+   void CNF::disableOccurrenceLists() {
+      this->occurrenceListsEnabled = false;
+      this->occurrences = OccurrenceLists();
+   }
+
+   void CNF::eraseLiteral(const ClauseRef clause, const int literal) {
+      if (this->isSharedClause(clause)) {
+         this->detachClauses();
+      }
+      ClauseView view = this->getClause(clause);
+      const auto position = std::find(view.begin(), view.end(), literal);
+      this->recordEdit({EDIT::LITERAL_ERASED, clause, literal, static_cast<size_type>(position - view.begin())});
+      if (2 == view.size()) {
+         // the clause becomes a unit clause, so its implications don't hold anymore. They can't be removed from
+         // implications shared with a snapshot, which would keep them alive for a clause that is not removed
+         this->binaryImplications.unshare([this](const ClauseRef ref) {
+            return this->isRemoved(ref);
+         });
+         this->binaryImplications.remove(clause, view[0], view[1]);
+      }
+      view.erase(position);
+      this->removeLiteralFromStatistics(literal);
+
+      if (this->occurrenceListsEnabled && !view.containsLiteral(literal)) {
+         this->occurrences.removeLiteral(clause, literal);
+      }
+      // a clause that became binary is added to the binary implications
+      this->addClauseToImplications(clause);
+   }
+
    CNF CNF::getMetadataCopy() const {
       CNF copy;
       copy.name = this->name;
@@ -57,108 +479,296 @@ namespace preppy::cnf {
       copy.totalProcessingTime = this->totalProcessingTime;
       copy.procedures = this->procedures;
       copy.equivalence = this->equivalence;
+      copy.compressionInformation = this->compressionInformation;
       return copy;
    }
 
+   CNF CNF::clone() const {
+      return CNF(*this);
+   }
+
    void CNF::compress() {
-      util::Utility::logDebug("Compressing CNF by ", this->getMaxVariable() - this->getVariables(), " variables");
+      const unsigned maxVar = this->getMaxVariable();
+      const unsigned variables = this->getVariables();
+      const std::vector<unsigned>& used = this->variableOccurrences;
+
+      util::Utility::logDebug("Compressing CNF by ", maxVar - variables, " variables");
 
       if (this->isCompressed()) {
          return;
       }
 
-      // collect all variables used in the formula
-      std::set<unsigned> variables;
-      for (const auto& clause : *this) {
-         for (const int var : *clause) {
-            variables.insert(std::abs(var));
+      // the highest variable takes the lowest unused name, until the names meet in the middle
+      std::vector<unsigned> newNames(maxVar + 1);
+      std::iota(newNames.begin(), newNames.end(), 0u);
+      std::size_t renamed = 0;
+      unsigned gap = 1;
+      unsigned variable = maxVar;
+      while (true) {
+         while (gap < variable && 0 != used[gap]) {
+            ++gap;
          }
+         while (variable > gap && 0 == used[variable]) {
+            --variable;
+         }
+         if (gap >= variable) {
+            break;
+         }
+         newNames[variable] = gap;
+         ++renamed;
+         ++gap;
+         --variable;
       }
 
-      // compress
-      for (unsigned i = 1; !variables.empty() && i < *(variables.rbegin()); ++i) {
-         const int maxVar = *(variables.rbegin());
-         
-         // if this variable is missing -> compress
-         if (variables.find(i) == variables.end()) {
-            variables.erase(maxVar);
-            this->renameVariable(maxVar, i);
-            this->compressionInformation.emplace_back(maxVar, i, false);
+      this->renameVariables(newNames);
+
+      // the steps are recorded in the order of the gaps, i.e. starting with the highest variable
+      this->compressionInformation.reserve(this->compressionInformation.size() + renamed);
+      for (unsigned i = maxVar; renamed > 0; --i) {
+         if (newNames[i] != i) {
+            this->compressionInformation.emplace_back(i, newNames[i], false);
+            --renamed;
          }
       }
-      this->maxVariableDirtyBit = true;
+      this->compressionMapsDirtyBit = true;
    }
 
    int CNF::compress(int literal) {
-      bool sign = (literal > 0);
-      literal = std::abs(literal);
-      for (const auto& step : this->compressionInformation) {
-         if (literal == static_cast<int>(std::get<0>(step))) {
-            literal = std::get<1>(step);
-         }
+      this->updateCompressionMaps();
+      const std::size_t variable = static_cast<std::size_t>(std::abs(literal));
+      if (variable >= this->compressionMap.size()) {
+         return literal;
       }
-
-      return sign ? literal : -literal;
+      const int compressed = static_cast<int>(this->compressionMap[variable]);
+      return (literal > 0) ? compressed : -compressed;
    }
 
    void CNF::compress(cnf::Model& model) {
-      for (const auto& step : this->compressionInformation) {
-         model[std::get<1>(step)] = model[std::get<0>(step)];
-         model.erase(model.begin() + std::get<0>(step));
-      }
+      this->updateCompressionMaps();
+      model.renameVariables(this->compressionMap);
    }
 
    void CNF::decompress() {
-      // TODO
+      this->updateCompressionMaps();
+      if (this->compressionInformation.empty()) {
+         return;
+      }
+
+      // the names of removed variables don't occur anymore, so mapping them to 0 doesn't matter
+      this->renameVariables(this->decompressionMap);
+      this->compressionInformation.clear();
+      this->compressionMapsDirtyBit = true;
    }
 
    int CNF::decompress(int literal) {
-      bool sign = (literal > 0);
-      literal = std::abs(literal);
-      
-      for (auto step = this->compressionInformation.rbegin(); step != this->compressionInformation.rend(); ++step) {
-         if (literal == static_cast<int>(std::get<1>(*step))) {
-            literal = std::get<0>(*step);
-         }
+      this->updateCompressionMaps();
+      const std::size_t variable = static_cast<std::size_t>(std::abs(literal));
+      if (variable >= this->decompressionMap.size()) {
+         return literal;
       }
-
-      return sign ? literal : -literal;
+      const int decompressed = static_cast<int>(this->decompressionMap[variable]);
+      return (literal > 0) ? decompressed : -decompressed;
    }
 
    void CNF::decompress(cnf::Model& model) {
-      //for (auto step = this->compressionInformation.rbegin(); step != this->compressionInformation.rend(); ++step) {
-      for (auto step : this->compressionInformation) {
-         model.insert(model.begin() + std::get<1>(step), std::get<2>(step));
+      this->updateCompressionMaps();
+      model.renameVariables(this->decompressionMap);
+      // the removed variables get the values they were fixed to
+      model.resize(std::max(model.size(), this->compressionMap.size()));
+      for (std::size_t variable = 1; variable < this->compressionMap.size(); ++variable) {
+         if (0 == this->compressionMap[variable]) {
+            model.assign(variable, this->compressionValues[variable]);
+         }
       }
    }
 
+   void CNF::updateCompressionMaps() {
+      if (!this->compressionMapsDirtyBit) {
+         return;
+      }
+
+      std::size_t size = 1;
+      for (const auto& [original, renamed, value] : this->compressionInformation) {
+         size = std::max<std::size_t>(size, std::max(original, renamed) + 1);
+      }
+      this->compressionMap.resize(size);
+      this->decompressionMap.resize(size);
+      std::iota(this->compressionMap.begin(), this->compressionMap.end(), 0u);
+      std::iota(this->decompressionMap.begin(), this->decompressionMap.end(), 0u);
+      this->compressionValues.assign(size, false);
+
+      // the steps renamed the variables one after another, so following them once gives the final names
+      for (const auto& [original, renamed, value] : this->compressionInformation) {
+         // the variable that had the new name before is not part of the formula anymore
+         const unsigned replaced = this->decompressionMap[renamed];
+         if (0 != replaced) {
+            this->compressionMap[replaced] = 0;
+            this->compressionValues[replaced] = value;
+         }
+         if (original == renamed) {
+            this->decompressionMap[renamed] = 0;
+            continue;
+         }
+         const unsigned variable = this->decompressionMap[original];
+         if (0 != variable) {
+            this->compressionMap[variable] = renamed;
+         }
+         this->decompressionMap[renamed] = variable;
+         this->decompressionMap[original] = 0;
+      }
+      this->compressionMapsDirtyBit = false;
+   }
+
    void CNF::renameVariable(const unsigned variable, const unsigned newName) {
-      for (auto& clause : *this) {
-         clause->renameVariable(variable, newName);
+      this->renameVariableInClauses(variable, newName);
+   }
+
+   void CNF::renameVariableInClauses(const unsigned variable, const unsigned newName) {
+      this->recordReplacement();
+      if (this->occurrenceListsEnabled) {
+         // only visit the clauses the variable occurs in. Copying a shared clause adds the copy to the lists
+         for (const int literal : {static_cast<int>(variable), -static_cast<int>(variable)}) {
+            const std::vector<ClauseRef> listed = this->occurrences[literal];
+            for (const ClauseRef clause : listed) {
+               if (this->isRemoved(clause)) {
+                  continue;
+               }
+               const ClauseRef renamed = this->isSharedClause(clause) ? this->copySharedClause(this->getPosition(clause)) : clause;
+               this->getClause(renamed).renameVariable(variable, newName);
+            }
+         }
+         if (0 == this->occurrences.count(static_cast<int>(newName)) && 0 == this->occurrences.count(-static_cast<int>(newName))) {
+            this->occurrences.renameVariable(variable, newName);
+         }
+         else {
+            // clauses with both variables would be listed twice after moving the lists
+            this->rebuildOccurrenceLists();
+         }
+      }
+      else {
+         for (size_type i = this->firstClause; i < this->clauses.size(); ++i) {
+            ClauseRef clause = this->clauses[i];
+            if (this->arena->isDeleted(clause)) {
+               continue;
+            }
+            if (this->isSharedClause(clause)) {
+               const ClauseView view = this->getClause(clause);
+               if (!view.containsLiteral(static_cast<int>(variable)) && !view.containsLiteral(-static_cast<int>(variable))) {
+                  continue;
+               }
+               clause = this->copySharedClause(i);
+            }
+            this->getClause(clause).renameVariable(variable, newName);
+         }
+      }
+      // the binary implications still point to the literals before renaming
+      this->implicationsDirtyBit = true;
+
+      // move the occurrences of the variable over to its new name
+      if (variable == newName || variable >= this->variableOccurrences.size() || 0 == this->variableOccurrences[variable]) {
+         return;
+      }
+      if (newName >= this->variableOccurrences.size()) {
+         this->variableOccurrences.resize(newName + 1, 0);
+      }
+      if (0 != this->variableOccurrences[newName]) {
+         --this->variables;
+      }
+      this->variableOccurrences[newName] += this->variableOccurrences[variable];
+      this->variableOccurrences[variable] = 0;
+      if (newName > this->maxVariable) {
+         this->maxVariable = newName;
+         this->maxVariableDirtyBit = false;
+      }
+      else if (variable == this->maxVariable) {
+         this->maxVariableDirtyBit = true;
       }
-      this->maxVariableDirtyBit = true;
-      this->variablesDirtyBit = true;
+   }
+
+   void CNF::renameVariables(const std::vector<unsigned>& newNames) {
+      this->recordReplacement();
+      this->detachClauses();
+
+      const auto renameRange = [this, &newNames](const std::size_t first, const std::size_t last) {
+         for (std::size_t i = first; i < last; ++i) {
+            if (!this->arena->isDeleted(this->clauses[i])) {
+               this->getClause(this->clauses[i]).renameVariables(newNames);
+            }
+         }
+      };
+
+      // every clause is renamed on its own, so the threads can work on separate ranges of clauses
+      const std::size_t threads = std::min<std::size_t>(util::Utility::getThreads(), this->clauses.size() / 65536 + 1);
+      if (threads <= 1) {
+         renameRange(0, this->clauses.size());
+      }
+      else {
+         const std::size_t rangeSize = (this->clauses.size() + threads - 1) / threads;
+         std::vector<std::thread> workers;
+         workers.reserve(threads - 1);
+         for (std::size_t first = rangeSize; first < this->clauses.size(); first += rangeSize) {
+            workers.emplace_back(renameRange, first, std::min(first + rangeSize, this->clauses.size()));
+         }
+         renameRange(0, std::min(rangeSize, this->clauses.size()));
+         for (auto& worker : workers) {
+            worker.join();
+         }
+      }
+
+      // the binary implications still point to the literals before renaming
+      this->implicationsDirtyBit = true;
+      this->rebuildOccurrenceLists();
+
+      // the literals only changed their names, so the occurrences move along with them
+      std::vector<unsigned> occurrences(this->variableOccurrences.size(), 0);
+      this->variables = 0;
+      this->maxVariable = 0;
+      this->maxVariableDirtyBit = false;
+      for (std::size_t variable = 1; variable < this->variableOccurrences.size(); ++variable) {
+         const std::size_t newName = (variable < newNames.size()) ? newNames[variable] : variable;
+         if (0 == newName || 0 == this->variableOccurrences[variable]) {
+            continue;
+         }
+         if (newName >= occurrences.size()) {
+            occurrences.resize(newName + 1, 0);
+         }
+         if (0 == occurrences[newName]) {
+            ++this->variables;
+            this->maxVariable = std::max(this->maxVariable, static_cast<unsigned>(newName));
+         }
+         occurrences[newName] += this->variableOccurrences[variable];
+      }
+      this->variableOccurrences.swap(occurrences);
    }
 
    void CNF::joinFormula(const cnf::CNF& formula) {
+      this->reserve(this->size() + formula.size());
       for (const auto& clause : formula) {
-         this->push_back(std::make_unique<cnf::Clause>(*clause));
+         this->push_back(clause);
       }
-      this->maxVariableDirtyBit = true;
-      this->variablesDirtyBit = true;
    }
 
    void CNF::setLiteralBackpropagated(int literal) {
       // literal is not part of the formula anymore, so take biggest variable and rename it to literal's variable name
-      
-      for (auto& clause : *this) {
-         clause->renameVariable(this->getMaxVariable(), std::abs(literal));
-      }
-      this->maxVariable--;
-      this->compressionInformation.emplace_back(this->getMaxVariable(), std::abs(literal), (literal>0));
+      const unsigned maxVar = this->getMaxVariable();
+      this->renameVariableInClauses(maxVar, std::abs(literal));
+      this->compressionInformation.emplace_back(maxVar, std::abs(literal), (literal>0));
+      this->compressionMapsDirtyBit = true;
    }
 
-   bool CNF::readFromFile(const std::string& filepath) {
+   bool CNF::readFromFile(const std::string& filepath, const unsigned threads, const bool normalize) {
+      if ("-" == filepath) {
+         this->name = "stdin";
+         this->source.clear();
+
+         io::StreamingInput input;
+         if (!input.openStandardInput()) {
+            util::Utility::logError("Standard input couldn't be opened");
+            return false;
+         }
+         return this->readFromInput(input, normalize);
+      }
+
       this->name = filepath;
       this->source = filepath;
       if (!util::Utility::fileExists(filepath)) {
@@ -166,63 +776,83 @@ namespace preppy::cnf {
          return false;
       }
 
-      std::fstream file(filepath);
-      if (!file.is_open()) {
+      if (io::isBinaryCnf(filepath)) {
+         return this->readFromBinary(filepath);
+      }
+
+      const io::COMPRESSION compression = io::detectCompression(filepath);
+      if (io::COMPRESSION::NONE != compression) {
+         // compressed input is decompressed in the background while the previous block is parsed
+         io::StreamingInput input;
+         if (!input.open(filepath)) {
+            util::Utility::logError("File ", filepath, " couldn't be opened");
+            return false;
+         }
+         return this->readFromInput(input, normalize);
+      }
+
+      io::MappedFile file;
+      if (!file.open(filepath)) {
          util::Utility::logError("File ", filepath, " couldn't be opened");
          return false;
       }
 
-      // collects all the lines containing clauses
-      std::stringstream clausestream;
-      unsigned variables, clauses;
+      // parse the whole mapped file in place
+      io::DimacsParser parser(file.size(), normalize);
+      const bool parsed = (threads > 1)
+         ? parser.parseParallel(file.data(), file.data() + file.size(), threads)
+         : parser.parse(file.data(), file.data() + file.size());
+      if (!parsed || !parser.finish()) {
+         util::Utility::logError("Couldn't parse cnf file \"", this->name, "\"");
+         return false;
+      }
+      file.close();
 
-      std::string line;
-      bool problemLineFound = false;
-      while (!file.eof()) {
-         std::getline(file, line);
-         if ('c' == line[0]) {            // comment line
-         }
-         else if ('p' == line[0]) {       // problem line
-            if (problemLineFound) {
-               util::Utility::logError("Multiple problem lines found in cnf file \"", this->name, "\"");
-               return false;
-            }
-            std::stringstream ss(line);
-            std::string discard;
-            ss >> discard;                // "p"
-            ss >> discard;                // "cnf"
-            ss >> variables;
-            ss >> clauses;
-            util::Utility::logInfo("Read problem line: ", variables, " variables and ", clauses, " clauses");
-            
-            this->reserve(clauses * 1.2);
-            problemLineFound = true;
-         }
-         else {
-            clausestream << line;
+      return this->readFromParser(parser);
+   }
+
+   bool CNF::readFromInput(io::StreamingInput& input, const bool normalize) {
+      io::DimacsParser parser(0, normalize);
+      const char* begin;
+      const char* end;
+      while (input.nextBlock(begin, end)) {
+         if (!parser.parse(begin, end)) {
+            util::Utility::logError("Couldn't parse cnf file \"", this->name, "\"");
+            return false;
          }
       }
+      if (input.failed() || !parser.finish()) {
+         util::Utility::logError("Couldn't read ", io::compressionToString(input.getCompression()), " cnf input \"", this->name, "\"");
+         return false;
+      }
 
-      if (!problemLineFound) {
+      return this->readFromParser(parser);
+   }
+
+   bool CNF::readFromParser(io::DimacsParser& parser) {
+      if (!parser.hasProblemLine()) {
          util::Utility::logWarning("There was no problem line to read");
          return false;
       }
 
-      std::vector<std::string> clausestrings = util::Utility::tokenizeString(clausestream.str(), " 0");
+      const unsigned variables = parser.getHeaderVariables();
+      const unsigned clauses = parser.getHeaderClauses();
 
-      unsigned maxVar = 0;
-      for (const auto& clausestring : clausestrings) {
-         this->push_back(std::make_unique<Clause>(clausestring));
-         
-         unsigned v = this->back()->getMaxVariable();
-         
-         if (v >= maxVar) {
-            maxVar = v;
-         }
+      // the parser terminates every clause with a 0 just like the arena, so its buffer is taken over without copying
+      this->clear();
+      this->arena->adopt(std::move(parser.getLiterals()), parser.getClauses());
+      this->clauses.resize(this->arena->getClauses());
+      for (std::size_t i = 0; i < this->clauses.size(); ++i) {
+         this->clauses[i] = static_cast<ClauseRef>(i);
       }
 
-      this->maxVariableDirtyBit = false;
+      // the parser already counted the occurrences of every variable, no need to scan the clauses again
+      const unsigned maxVar = parser.getMaxVariable();
+      this->variableOccurrences = parser.getVariableOccurrences();
+      this->variables = parser.getVariables();
       this->maxVariable = maxVar;
+      this->literals = std::accumulate(this->variableOccurrences.begin(), this->variableOccurrences.end(), std::size_t(0));
+      this->rebuildImplications();
 
       if (this->size() != clauses) {
          util::Utility::logWarning("Number of clauses read (", this->size(), ") differs from number of clauses in header (", clauses, ")");
@@ -239,6 +869,56 @@ namespace preppy::cnf {
       return true;
    }
 
+   bool CNF::readFromBinary(const std::string& filepath) {
+      io::BinaryCnfReader reader;
+      if (!reader.open(filepath)) {
+         return false;
+      }
+
+      this->clear();
+      this->arena->reserve(reader.getClauses(), reader.getLiterals());
+      this->reserve(reader.getClauses());
+      for (std::size_t i = 0; i < reader.getClauses(); ++i) {
+         this->clauses.push_back(this->arena->add(reader.clauseBegin(i), reader.clauseEnd(i)));
+      }
+
+      const io::BinaryCnfMetadata& metadata = reader.getMetadata();
+      this->name = metadata.name;
+      this->equivalence = metadata.equivalence;
+      this->totalProcessingTime = metadata.processingTime;
+      this->procedures.insert(metadata.procedures.begin(), metadata.procedures.end());
+      this->compressionInformation = metadata.compressionInformation;
+      this->compressionMapsDirtyBit = true;
+
+      this->rebuildStatistics();
+      this->rebuildImplications();
+
+      util::Utility::logInfo("Successfully read ", this->getVariables(), " variables and ", this->size(), " clauses from binary file");
+
+      return true;
+   }
+
+   bool CNF::writeBinary(const std::string& filepath) {
+      io::BinaryCnfMetadata metadata;
+      metadata.name = this->name;
+      metadata.procedures.assign(this->procedures.begin(), this->procedures.end());
+      metadata.equivalence = this->equivalence;
+      metadata.processingTime = this->totalProcessingTime;
+      metadata.variables = this->getVariables();
+      metadata.maxVariable = this->getMaxVariable();
+      metadata.compressionInformation = this->compressionInformation;
+
+      if ("-" == filepath) {
+         return io::writeBinaryCnf(std::cout, metadata, *this);
+      }
+
+      std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+      if (!file.is_open()) {
+         return false;
+      }
+      return io::writeBinaryCnf(file, metadata, *this);
+   }
+
    std::string CNF::toString() const {
       std::stringstream ss;
       for (const auto& clause : *this) {
@@ -247,9 +927,16 @@ namespace preppy::cnf {
       return ss.str();
    }
 
-   bool CNF::writeToFile(const std::string& path, const bool force) {
+   bool CNF::writeToFile(const std::string& path, const bool force, const unsigned threads, bool binary) {
       std::filesystem::path filePath;
 
+      // the writers access the clauses by index
+      this->dropRemovedReferences();
+
+      if ("-" == path) {
+         return this->writeToStandardOutput(threads, binary);
+      }
+
       if (util::Utility::isDirectory(path)) {
          std::string origFileName;
          if (!this->source.has_stem()) {
@@ -260,11 +947,12 @@ namespace preppy::cnf {
          }
          origFileName += "out";
          filePath = path + origFileName;
-         filePath.replace_extension("cnf");
+         filePath.replace_extension(binary ? "pcnf" : "cnf");
       }
       else {
          // assume it's a file
          filePath = path;
+         binary = binary || io::hasBinaryCnfExtension(path);
       }
 
       util::Utility::logDebug("Writing CNF to file ", filePath);
@@ -274,8 +962,16 @@ namespace preppy::cnf {
          return false;
       }
 
-      std::ofstream file(filePath);
-      if (!file.is_open()) {
+      if (binary) {
+         if (!this->writeBinary(filePath)) {
+            util::Utility::logError("Couldn't write file ", filePath);
+            return false;
+         }
+         return true;
+      }
+
+      io::DimacsWriter file(1 << 20, threads);
+      if (!file.open(filePath)) {
          if (util::Utility::fileExists(path)) {
             util::Utility::logError("Couldn't open file ", filePath);
          }
@@ -285,13 +981,40 @@ namespace preppy::cnf {
          return false;
       }
 
-      file << this->getFileHeader();
+      file.write(this->getFileHeader());
+      file.writeClauses(*this);
 
-      for (const auto& clause : *this) {
-         file << clause->toCNFLine();
+      if (!file.close()) {
+         util::Utility::logError("Couldn't write file ", filePath);
+         return false;
       }
+      return true;
+   }
 
-      file.close();
+   bool CNF::writeToStandardOutput(const unsigned threads, const bool binary) {
+      util::Utility::logDebug("Writing CNF to standard output");
+
+      if (binary) {
+         if (!this->writeBinary("-")) {
+            util::Utility::logError("Couldn't write to standard output");
+            return false;
+         }
+         return true;
+      }
+
+      io::DimacsWriter output(1 << 20, threads);
+      if (!output.openStandardOutput()) {
+         util::Utility::logError("Couldn't open standard output");
+         return false;
+      }
+
+      output.write(this->getFileHeader());
+      output.writeClauses(*this);
+
+      if (!output.close()) {
+         util::Utility::logError("Couldn't write to standard output");
+         return false;
+      }
       return true;
    }
 
@@ -336,29 +1059,16 @@ namespace preppy::cnf {
    }
 
    unsigned CNF::getVariables() {
-      if (this->variablesDirtyBit) {
-         std::set<unsigned> variables;
-         for (const auto& clause : *this) {
-            for (const int var : *clause) {
-               variables.insert(std::abs(var));
-            }
-         }
-         this->variables = variables.size();
-         this->variablesDirtyBit = false;
-      }
-
       return this->variables;
    }
 
    unsigned CNF::getMaxVariable() {
       if (this->maxVariableDirtyBit) {
-         unsigned maxVar = 0;
-         for (const auto& clause : *this) {
-            if (clause->getMaxVariable() > maxVar) {
-               maxVar = clause->getMaxVariable();
-            }
+         // the maximum only ever decreases while it is dirty, so the next occurring variable below it is the new one
+         while (0 != this->maxVariable && 0 == this->variableOccurrences[this->maxVariable]) {
+            --this->maxVariable;
          }
-         this->maxVariable = maxVar;
+         this->variableOccurrences.resize(this->maxVariable + 1);
          this->maxVariableDirtyBit = false;
       }
 
@@ -370,11 +1080,7 @@ namespace preppy::cnf {
    }
 
    unsigned CNF::getLiterals() const {
-      unsigned totalLiterals = 0;
-      for (const auto& clause : *this) {
-         totalLiterals += clause->size();
-      }
-      return totalLiterals;
+      return static_cast<unsigned>(this->literals);
    }
 
    bool CNF::isCompressed() {
@@ -382,18 +1088,25 @@ namespace preppy::cnf {
    }
 
    void CNF::setDirtyBitsTrue() {
-      this->maxVariableDirtyBit = true;
-      this->variablesDirtyBit = true;
+      this->rebuildStatistics();
    }
 
-   std::vector<unsigned> CNF::countVariables() {
-      std::vector<unsigned> varCount(this->getMaxVariable() + 1);
-      for (const auto& clause : *this) {
-         for (const auto& literal : *clause) {
-            varCount[std::abs(literal)]++;
+   void CNF::rebuildStatistics() {
+      this->variableOccurrences.clear();
+      this->variables = 0;
+      this->maxVariable = 0;
+      this->maxVariableDirtyBit = false;
+      this->literals = 0;
+      for (const ClauseRef clause : this->clauses) {
+         if (!this->arena->isDeleted(clause)) {
+            this->addClauseToStatistics(clause);
          }
       }
+   }
 
+   std::vector<unsigned> CNF::countVariables() {
+      std::vector<unsigned> varCount(this->variableOccurrences);
+      varCount.resize(this->getMaxVariable() + 1, 0);
       return varCount;
    }
 
@@ -411,8 +1124,12 @@ namespace preppy::cnf {
       this->totalProcessingTime += duration;
    }
 
-   WatchedLiteralsT& CNF::getWatchedLiterals() {
-      return this->watchedLiterals;
+   const BinaryImplications& CNF::getBinaryImplications() {
+      if (this->implicationsDirtyBit) {
+         this->rebuildImplications();
+      }
+      this->reclaimSharedImplications();
+      return this->binaryImplications;
    }
 
    std::string equivalenceTypeToString(cnf::EQUIVALENCE_TYPE eqType) {
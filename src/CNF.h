@@ -11,20 +11,32 @@
 
 #pragma once
 #include "Clause.h"
+#include "ClauseArena.h"
+#include "BinaryImplications.h"
+#include "OccurrenceLists.h"
 #include "Model.h"
 #include "definitions.h"
 
 #include <vector>
 #include <set>
+#include <unordered_set>
 #include <filesystem>
 #include <initializer_list>
 #include <tuple>
 #include <algorithm>
+#include <stdexcept>
+#include <memory>
+#include <limits>
+
+namespace preppy::io {
+   class DimacsParser;
+   class StreamingInput;
+}
 
 namespace preppy::cnf {
 
    /**
-    * @brief Represents a CNF Formula. Derived from a vector of Clauses
+    * @brief Represents a CNF Formula. Exposes its clauses like a vector of clauses, they are stored in a ClauseArena
     * 
     */
    class CNF {
@@ -41,23 +53,109 @@ namespace preppy::cnf {
        * 
        * @param l initializer list of clauses
        */
-      CNF(std::initializer_list<Clauses::value_type> l);
+      CNF(std::initializer_list<cnf::Clause> l);
 
       /**
-       * @brief Copy a CNF
+       * @brief Copy a CNF. The clause storage is copied as a whole when it holds few removed clauses, otherwise the
+       * clauses are copied back to back. The binary implications and occurrence lists are built in one pass afterwards
        * 
        * @param other The CNF to copy
        */
       CNF(const cnf::CNF& other);
 
       /**
-       * @brief Copy other to this
+       * @brief Move a CNF, takes over the clauses, binary implications and occurrence lists without copying
+       * 
+       * @param other The CNF to move, empty afterwards. It must not have an open transaction
+       */
+      CNF(cnf::CNF&& other);
+
+      /**
+       * @brief Copy other to this, see CNF(const cnf::CNF&)
        * 
        * @param other The CNF to copy
        * @return CNF& A reference to this
        */
       CNF& operator=(const cnf::CNF& other);
 
+      /**
+       * @brief Move other to this in constant time. Use this to replace a formula by a simplified one
+       * 
+       * @param other The CNF to move, it gets the previous content of this. It must not have an open transaction
+       * @return CNF& A reference to this
+       */
+      CNF& operator=(cnf::CNF&& other);
+
+      /**
+       * @brief Destroy the CNF, giving the storage of its own clauses back if it shares the clause storage
+       * 
+       */
+      ~CNF();
+
+      /**
+       * @brief Get a snapshot of this formula, a CNF with the same clauses that can be changed independently of this one.
+       * Instead of copying, the snapshot shares the clause storage and binary implications with this formula and only
+       * records what is added or removed afterwards
+       * 
+       * @return CNF The snapshot
+       * 
+       * @details Adding and removing clauses stays cheap for both formulas, a clause they still share is only removed
+       * from the formula removing it. Changing a shared clause with eraseIf() or renameVariable() gives the changing
+       * formula its own copy of just that clause, eraseLiteral(), renameVariables() and compact() first copy the whole
+       * clause storage. Clauses must therefore only be changed through the functions of the CNF, not through the
+       * ClauseViews of a formula that shares its storage
+       */
+      CNF snapshot() const;
+
+      /**
+       * @brief Starts a transaction. Until it is committed or rolled back every change of the clauses is recorded, so
+       * rollback() can undo it. Transactions can be nested
+       * 
+       * @details Adding, removing and erasing literals from single clauses is undone in time proportional to the
+       * number of changes. Changes of the whole formula, like eraseIf(), compact() or renaming a variable, keep a
+       * snapshot of the formula from before the change
+       */
+      void beginTransaction();
+
+      /**
+       * @brief Ends the innermost transaction and keeps its changes. They are still undone if an enclosing transaction
+       * is rolled back
+       * 
+       * @return bool True if there was a transaction to commit
+       */
+      bool commit();
+
+      /**
+       * @brief Ends the innermost transaction and undoes its changes, restoring the clauses, binary implications,
+       * occurrence lists and statistics from when it was started
+       * 
+       * @return bool True if there was a transaction to roll back
+       */
+      bool rollback();
+
+      /**
+       * @brief Rewrites the clause storage so the clauses are stored back to back in their current order, freeing
+       * the space of removed clauses and literals. Invalidates all ClauseViews and ClauseRefs of this formula
+       * 
+       */
+      void compact();
+
+      /**
+       * @brief Drops the references of removed clauses, so indexed access is constant time again, and compacts the
+       * clause storage if more than half of it is unused. Invalidates all iterators, and all ClauseViews and ClauseRefs
+       * if the storage was compacted
+       * 
+       */
+      void collectGarbage();
+
+      /**
+       * @brief Get an independent copy of this formula, see CNF(const cnf::CNF&). Unlike snapshot() the copy doesn't
+       * share anything with this formula
+       * 
+       * @return CNF The copy
+       */
+      CNF clone() const;
+
       /**
        * @brief Get a CNF with the same Metadata as this CNF, but no clauses
        * 
@@ -66,8 +164,11 @@ namespace preppy::cnf {
       CNF getMetadataCopy() const;
 
       /**
-       * @brief Compresses this formula
+       * @brief Compresses this formula, renaming the highest variables to the unused names in between so the variables
+       * are dense afterwards
        * 
+       * @details Takes one pass over the literals to find the unused names and one to rename the variables, so it runs
+       * in linear time regardless of the number of unused names
        */
       void compress();
 
@@ -75,7 +176,7 @@ namespace preppy::cnf {
        * @brief Compresses a single literal from the original formula to this version, i.e. it looks up what the given literal in the original is called now
        * 
        * @param literal The literal to compress
-       * @return int The compressed literal
+       * @return int The compressed literal, 0 if its variable is not part of this formula anymore
        */
       int compress(int literal);
 
@@ -87,7 +188,8 @@ namespace preppy::cnf {
       void compress(cnf::Model& model);
 
       /**
-       * @brief Decompresses this formula using the saved compressionInformation
+       * @brief Decompresses this formula using the saved compressionInformation, giving every variable its original
+       * name again. Variables that were removed from the formula stay removed
        * 
        */
       void decompress();
@@ -101,7 +203,8 @@ namespace preppy::cnf {
       int decompress(int literal);
 
       /**
-       * @brief Decompresses a model from this version of the formula to the original
+       * @brief Decompresses a model from this version of the formula to the original. Variables that were removed from
+       * the formula get the value they were removed with
        * 
        * @param model The Model to decompress
        */
@@ -137,23 +240,30 @@ namespace preppy::cnf {
       std::string toString() const;
 
       /**
-       * @brief Create this object from a given cnf file
+       * @brief Create this object from a given cnf file. gzip, xz and zstd compressed files are decompressed on the fly,
+       * binary cnf files are detected and mapped directly
        * 
-       * @param filepath The path to the cnf file to read
+       * @param filepath The path to the cnf file to read, - to read from the standard input
+       * @param threads The number of threads to parse an uncompressed file with
+       * @param normalize When set the literals of every clause in a DIMACS input are sorted and duplicate literals are
+       * removed while parsing
        * @return bool True if successfull
        */
-      bool readFromFile(const std::string& filepath);
+      bool readFromFile(const std::string& filepath, unsigned threads = 1, bool normalize = false);
 
       /**
        * @brief Writes this formula to a path
        * 
-       * @param filepath A file path or directory to write to. 
+       * @param filepath A file path or directory to write to, - to write to the standard output
        * @param force When set any existing file will be overriden
+       * @param threads The number of threads to format the clauses with
+       * @param binary When set the binary cnf format is written instead of DIMACS
        * @return bool True on success
        * 
-       * In case of a directory the original file name + out.cnf will be used. In case of a file the exact path will be used
+       * In case of a directory the original file name + out.cnf (out.pcnf for binary) will be used. In case of a file the exact 
+       * path will be used, files with the .pcnf extension are always written in the binary format
        */
-      bool writeToFile(const std::string& filepath, const bool force = false);
+      bool writeToFile(const std::string& filepath, const bool force = false, unsigned threads = 1, bool binary = false);
 
       /**
        * @brief Helper function for writing the File
@@ -199,8 +309,9 @@ namespace preppy::cnf {
       bool isCompressed();
 
       /**
-       * @brief Sets the dirty bits to true.
-       * Call this when changing the formula from the outside.
+       * @brief Recounts the statistics of the formula in one pass over the clauses.
+       * Call this when changing the literals of clauses from the outside, e.g. through a ClauseView. Changes made through
+       * the functions of the formula, including eraseIf(), keep the statistics up to date on their own
        * 
        */
       void setDirtyBitsTrue();
@@ -235,134 +346,313 @@ namespace preppy::cnf {
       void addProcessingTime(const util::clock::duration& duration);
 
       /**
-       * @brief Get a reference to this formula's watched literals
+       * @brief Get the implication graph of the binary clauses of this formula, without the longer clauses
+       * 
+       * @return const BinaryImplications& The implications of every literal
+       * 
+       * @note The implications shared with a snapshot have to be visited as well, see BinaryImplications::getShared()
+       */
+      const BinaryImplications& getBinaryImplications();
+
+      /**
+       * @brief Builds the occurrence lists of this formula, from then on they are kept up to date by every change of
+       * the formula until disableOccurrenceLists() is called. Does nothing if they already exist
+       * 
+       */
+      void enableOccurrenceLists();
+
+      /**
+       * @brief Drops the occurrence lists of this formula
+       * 
+       */
+      void disableOccurrenceLists();
+
+      /**
+       * @brief Checks whether this formula keeps occurrence lists
+       * 
+       * @return bool True if the occurrence lists are enabled
+       */
+      bool hasOccurrenceLists() const {
+         return this->occurrenceListsEnabled;
+      }
+
+      /**
+       * @brief Get the clauses a literal occurs in. Requires enabled occurrence lists
+       * 
+       * @param literal The literal
+       * @return const std::vector<ClauseRef>& The clauses containing the literal
+       * 
+       * @note Entries of removed clauses are only removed lazily, check isRemoved() before using a clause
+       */
+      const std::vector<ClauseRef>& getOccurrences(int literal) const {
+         return this->occurrences[literal];
+      }
+
+      /**
+       * @brief Get the number of clauses a literal occurs in. Requires enabled occurrence lists
+       * 
+       * @param literal The literal
+       * @return unsigned The number of clauses containing the literal
+       */
+      unsigned getOccurrenceCount(int literal) const {
+         return this->occurrences.count(literal);
+      }
+
+      /**
+       * @brief Erases a literal from a clause of this formula, keeping the occurrence lists and binary implications up to date
+       * 
+       * @param clause The reference of the clause
+       * @param literal The literal to erase, has to be part of the clause
+       */
+      void eraseLiteral(ClauseRef clause, int literal);
+
+      /**
+       * @brief Checks whether a clause was removed from this formula
+       * 
+       * @param ref The reference of the clause
+       * @return bool True if the clause was removed
+       */
+      bool isRemoved(ClauseRef ref) const {
+         return this->arena->isDeleted(ref) || (!this->removedSharedClauses.empty() && 0 != this->removedSharedClauses.count(ref));
+      }
+
+      /**
+       * @brief Checks whether this formula shares its clause storage with another formula, see snapshot()
        * 
-       * @return WatchedLiteralsT& The reference to the watched literals
+       * @return bool True if the clause storage is shared
        */
-      WatchedLiteralsT& getWatchedLiterals();
+      bool isShared() const {
+         return this->arena.use_count() > 1;
+      }
+
+      /**
+       * @brief Get a clause by its reference, e.g. from the binary implications
+       * 
+       * @param ref The reference of the clause
+       * @return ClauseView A view of the clause
+       */
+      ClauseView getClause(ClauseRef ref) {
+         return ClauseView(this->arena.get(), ref);
+      }
 
 #pragma region vectorfunctions
    //Put function definitions here for compiler optimizations and inlining
+   //Removing clauses only marks them as removed, iterators skip removed clauses until they are dropped by a push_back,
+   //eraseIf, collectGarbage or compact
 
-   Clauses::iterator begin() noexcept {
-      return this->clauses.begin();
+   typedef ClauseIterator iterator;
+   typedef ClauseIterator const_iterator;
+   typedef std::vector<ClauseRef>::size_type size_type;
+
+   iterator begin() noexcept {
+      return iterator(this->arena.get(), this->clauses.data() + this->firstClause, this->clauses.data() + this->clauses.size());
    }
 
-   Clauses::const_iterator begin() const noexcept {
-      return this->clauses.begin();
+   const_iterator begin() const noexcept {
+      return const_iterator(this->arena.get(), this->clauses.data() + this->firstClause, this->clauses.data() + this->clauses.size());
    }
 
-   Clauses::iterator end() noexcept {
-      return this->clauses.end();
+   iterator end() noexcept {
+      return iterator(this->arena.get(), this->clauses.data() + this->clauses.size(), this->clauses.data() + this->clauses.size());
    }
 
-   Clauses::const_iterator end() const noexcept {
-      return this->clauses.end();
+   const_iterator end() const noexcept {
+      return const_iterator(this->arena.get(), this->clauses.data() + this->clauses.size(), this->clauses.data() + this->clauses.size());
    }
    
-   Clauses::reference front() {
-      return this->clauses.front();
+   ClauseView front() {
+      return ClauseView(this->arena.get(), this->clauses[this->firstClause]);
    }
 
-   Clauses::const_reference front() const {
-      return this->clauses.front();
+   const ClauseView front() const {
+      return ClauseView(this->arena.get(), this->clauses[this->firstClause]);
    }
 
-   Clauses::reference back() {
-      return this->clauses.back();
+   ClauseView back() {
+      return ClauseView(this->arena.get(), this->clauses.back());
    }
    
-   Clauses::const_reference back() const {
-      return this->clauses.back();
+   const ClauseView back() const {
+      return ClauseView(this->arena.get(), this->clauses.back());
    }
    
-   Clauses::reference operator[](Clauses::size_type n) {
-      return this->clauses[n];
+   /**
+    * @note Constant time as long as no clause was removed from the middle of the formula since the last collectGarbage()
+    */
+   ClauseView operator[](size_type n) {
+      return ClauseView(this->arena.get(), this->clauses[this->getIndex(n)]);
    }
 
-   Clauses::const_reference operator[](Clauses::size_type n) const {
-      return this->clauses[n];
+   const ClauseView operator[](size_type n) const {
+      return ClauseView(this->arena.get(), this->clauses[this->getIndex(n)]);
    }
    
-   Clauses::reference at(const Clauses::size_type n) {
-      return this->clauses.at(n);
+   ClauseView at(const size_type n) {
+      if (n >= this->size()) {
+         throw std::out_of_range("CNF::at");
+      }
+      return (*this)[n];
    }
 
-   Clauses::const_reference at(const Clauses::size_type n) const {
-      return this->clauses.at(n);
+   const ClauseView at(const size_type n) const {
+      if (n >= this->size()) {
+         throw std::out_of_range("CNF::at");
+      }
+      return (*this)[n];
    }
 
-   void push_back(const Clauses::value_type& val) {
-      this->clauses.push_back(std::make_unique<cnf::Clause>(*val));
-      this->addClauseToWatchLiterals(this->clauses.back().get());
+   void push_back(const cnf::Clause& val) {
+      this->dropRemovedReferencesIfWasteful();
+      this->clauses.push_back(this->arena->add(val.data(), val.data() + val.size()));
+      ++this->addedClauses;
+      this->addClauseToImplications(this->clauses.back());
+      this->addClauseToOccurrences(this->clauses.back());
+      this->addClauseToStatistics(this->clauses.back());
+      this->recordEdit({EDIT::CLAUSE_ADDED, this->clauses.back()});
    }
 
-   void push_back(Clauses::value_type&& val) {
-      this->clauses.push_back(std::move(val));
-      this->addClauseToWatchLiterals(this->clauses.back().get());
+   void push_back(const cnf::ClauseView& val) {
+      this->dropRemovedReferencesIfWasteful();
+      this->clauses.push_back(this->arena->add(val.begin(), val.end()));
+      ++this->addedClauses;
+      this->addClauseToImplications(this->clauses.back());
+      this->addClauseToOccurrences(this->clauses.back());
+      this->addClauseToStatistics(this->clauses.back());
+      this->recordEdit({EDIT::CLAUSE_ADDED, this->clauses.back()});
    }
 
    void pop_back() {
-      this->removeClauseFromWatchLiterals(this->clauses.back().get());
-      this->clauses.pop_back();
+      this->removeAt(this->clauses.size() - 1);
    }
 
-   Clauses::iterator erase(Clauses::const_iterator position) {
-      this->removeClauseFromWatchLiterals((*this)[position - this->begin()].get());
-      return this->clauses.erase(position);
+   /**
+    * @brief Marks the clause at position as removed in constant time
+    * 
+    * @return iterator The next clause. Other iterators stay valid
+    */
+   iterator erase(const_iterator position) {
+      const size_type index = static_cast<size_type>(position.getPosition() - this->clauses.data());
+      this->removeAt(index);
+      // removed references at the end are dropped right away, so index + 1 might be behind the new end
+      const ClauseRef* end = this->clauses.data() + this->clauses.size();
+      return iterator(this->arena.get(), std::min<const ClauseRef*>(this->clauses.data() + index + 1, end), end);
    }
 
-   Clauses::iterator erase(Clauses::const_iterator first, Clauses::const_iterator last) {
-      auto it = first;
-      while (it != last) {
-         this->removeClauseFromWatchLiterals((*this)[it - this->begin()].get());
-         ++it;
+   iterator erase(const_iterator first, const_iterator last) {
+      const size_type firstIndex = static_cast<size_type>(first.getPosition() - this->clauses.data());
+      const size_type lastIndex = static_cast<size_type>(last.getPosition() - this->clauses.data());
+      for (size_type i = firstIndex; i < lastIndex && i < this->clauses.size(); ++i) {
+         if (!this->arena->isDeleted(this->clauses[i])) {
+            this->removeAt(i);
+         }
       }
-      return this->clauses.erase(first, last);
-   }
-/*
-   Clauses::iterator insert(Clauses::const_iterator position, const Clauses::value_type& val) {
-      return this->clauses.insert(position, val);
+      const ClauseRef* end = this->clauses.data() + this->clauses.size();
+      return iterator(this->arena.get(), std::min<const ClauseRef*>(this->clauses.data() + lastIndex, end), end);
    }
 
-   Clauses::iterator insert(Clauses::const_iterator position, Clauses::size_type n, const Clauses::value_type& val) {
-      return this->clauses.insert(position, n, val);
-   }
+   /**
+    * @brief Removes every clause the predicate returns true for. The predicate may change the clauses it is given
+    * 
+    * @param predicate Called with a ClauseView of every clause in order
+    * 
+    * @details This is a single pass over the formula, the binary implications and occurrence lists are rebuilt once afterwards and the clause
+    * storage is compacted if more than half of it is unused. The predicate is given a copy of every clause shared with
+    * another formula, which is only kept if the predicate changed it
+    */
+   template<typename Predicate>
+   void eraseIf(Predicate predicate) {
+      // the predicate may change every clause
+      this->recordReplacement();
+
+      auto kept = this->clauses.begin();
+      for (const ClauseRef ref : this->clauses) {
+         if (this->arena->isDeleted(ref)) {
+            continue;
+         }
+         // the clause is counted again with the literals the predicate left it with
+         this->removeClauseFromStatistics(ref);
+         if (!this->isSharedClause(ref)) {
+            if (predicate(ClauseView(this->arena.get(), ref))) {
+               this->arena->remove(ref);
+            }
+            else {
+               this->addClauseToStatistics(ref);
+               *kept++ = ref;
+            }
+            continue;
+         }
 
-   Clauses::iterator insert(Clauses::const_iterator position, Clauses::value_type&& val) {
-      return this->clauses.insert(position, val);
-   }
+         // the other formulas keep the shared clause as it is, the copy was added last so it can be dropped again
+         const ClauseRef copy = this->arena->add(this->arena->begin(ref), this->arena->end(ref));
+         const bool removed = predicate(ClauseView(this->arena.get(), copy));
+         if (!removed && !std::equal(this->arena->begin(ref), this->arena->end(ref), this->arena->begin(copy), this->arena->end(copy))) {
+            ++this->addedClauses;
+            this->removedSharedClauses.insert(ref);
+            this->addClauseToStatistics(copy);
+            *kept++ = copy;
+            continue;
+         }
+         this->arena->truncate(copy);
+         if (removed) {
+            this->removedSharedClauses.insert(ref);
+         }
+         else {
+            this->addClauseToStatistics(ref);
+            *kept++ = ref;
+         }
+      }
+      this->clauses.erase(kept, this->clauses.end());
+      this->firstClause = 0;
+      this->removedClauses = 0;
 
-   Clauses::iterator insert(Clauses::const_iterator position, std::initializer_list<Clauses::value_type> il) {
-      return this->clauses.insert(position, il);
-   }*/
+      if (this->arena->isFragmented()) {
+         this->compact();
+      }
+      else {
+         this->rebuildImplications();
+         this->rebuildOccurrenceLists();
+      }
+   }
 
-   void clear() noexcept {
+   void clear() {
+      this->recordReplacement();
+      if (this->isShared()) {
+         // the other formulas keep using the shared storage
+         this->releaseClauses();
+         this->arena = std::make_shared<ClauseArena>();
+      }
+      else {
+         this->arena->clear();
+      }
       this->clauses.clear();
-      this->watchedLiterals.clear();
+      this->firstClause = 0;
+      this->removedClauses = 0;
+      this->removedSharedClauses.clear();
+      this->tombstone = NO_CLAUSE;
+      this->snapshotClauses = 0;
+      this->addedClauses = 0;
+      this->binaryImplications.clear();
+      this->occurrences.clear();
+      this->variableOccurrences.clear();
+      this->variables = 0;
+      this->maxVariable = 0;
+      this->maxVariableDirtyBit = false;
+      this->literals = 0;
    }
 
-   void reserve(Clauses::size_type n) {
+   void reserve(size_type n) {
       this->clauses.reserve(n);
    }
 
-   Clauses::size_type capacity() const noexcept {
+   size_type capacity() const noexcept {
       return this->clauses.capacity();
    }
 
-   void resize(Clauses::size_type n) {
-      this->clauses.resize(n);
-   }
-
-   /*void resize(Clauses::size_type n, const Clauses::value_type& val) {
-      this->clauses.resize(n, val);
-   }*/
-
-   Clauses::size_type size() const noexcept {
-      return this->clauses.size();
+   size_type size() const noexcept {
+      return this->clauses.size() - this->removedClauses;
    }
 
-   Clauses::size_type max_size() const noexcept {
+   size_type max_size() const noexcept {
       return this->clauses.max_size();
    }
 
@@ -371,47 +661,527 @@ namespace preppy::cnf {
    protected:
 
       /**
-       * @brief Adds a clause to the watched literals.
-       * @note Is only called by the vector functions to keep the watched literals accurate at all times
+       * @brief The kinds of changes recorded while a transaction is open
+       * 
+       */
+      enum class EDIT {
+         CLAUSE_ADDED,
+         CLAUSE_REMOVED,
+         LITERAL_ERASED,
+         REFERENCES_DROPPED,
+         FORMULA_REPLACED
+      };
+
+      /**
+       * @brief A recorded change, with what is needed to undo it
+       * 
+       */
+      struct Edit {
+         /**
+          * @brief The kind of change
+          * 
+          */
+         EDIT type;
+
+         /**
+          * @brief The changed clause
+          * 
+          */
+         ClauseRef clause = 0;
+
+         /**
+          * @brief The erased literal
+          * 
+          */
+         int literal = 0;
+
+         /**
+          * @brief The position of the erased literal, or removedClauses before the references were dropped
+          * 
+          */
+         size_type index = 0;
+
+         /**
+          * @brief firstClause before the change
+          * 
+          */
+         size_type firstClause = 0;
+
+         /**
+          * @brief The number of references of removed clauses that were dropped from the end of clauses
+          * 
+          */
+         size_type trimmed = 0;
+      };
+
+      /**
+       * @brief An open transaction
+       * 
+       */
+      struct Transaction {
+         /**
+          * @brief The number of recorded edits when the transaction was started
+          * 
+          */
+         size_type edits;
+      };
+
+      /**
+       * @brief Checks whether changes are recorded, i.e. whether a transaction is open
+       * 
+       * @return bool True if there is an open transaction
+       */
+      bool isRecording() const {
+         return !this->transactions.empty();
+      }
+
+      /**
+       * @brief Records a change if a transaction is open
+       * 
+       * @param edit The change
+       */
+      void recordEdit(const Edit& edit) {
+         if (this->isRecording()) {
+            this->edits.push_back(edit);
+         }
+      }
+
+      /**
+       * @brief Keeps a snapshot of the formula to undo a change of the whole formula, if a transaction is open. Has to
+       * be called before the change
+       * 
+       */
+      void recordReplacement();
+
+      /**
+       * @brief Undoes a recorded change, the formula has to be in the state right after the change
+       * 
+       * @param edit The change
+       */
+      void undo(const Edit& edit);
+
+      /**
+       * @brief Takes over the clauses, binary implications, occurrence lists, statistics and metadata of another formula,
+       * giving it the ones of this formula in return
+       * 
+       * @param other The formula to swap with
+       */
+      void swapContent(cnf::CNF& other);
+
+      /**
+       * @brief Selects the constructor creating a snapshot
+       * 
+       */
+      struct SnapshotTag {};
+
+      /**
+       * @brief Creates a snapshot of a formula, see snapshot()
+       * 
+       * @param base The formula to share the clauses with
+       */
+      CNF(const cnf::CNF& base, SnapshotTag);
+
+      /**
+       * @brief Creates the clauses of this formula from a parser that finished reading a cnf input
+       * 
+       * @param parser The parser, its literal buffer is consumed
+       * @return bool True if successfull
+       */
+      bool readFromParser(io::DimacsParser& parser);
+
+      /**
+       * @brief Parses a streamed, optionally compressed cnf input and creates the clauses of this formula from it
+       * 
+       * @param input The opened input to read
+       * @param normalize When set the literals of every clause are sorted and duplicate literals are removed
+       * @return bool True if successfull
+       */
+      bool readFromInput(io::StreamingInput& input, bool normalize);
+
+      /**
+       * @brief Creates this formula, including its metadata, from a binary cnf file
+       * 
+       * @param filepath The path to the binary cnf file
+       * @return bool True if successfull
+       */
+      bool readFromBinary(const std::string& filepath);
+
+      /**
+       * @brief Writes this formula, including its metadata, to a binary cnf file
        * 
-       * @param clause The pointer to the clause to add
+       * @param filepath The file to write to, - for the standard output
+       * @return bool True on success
+       */
+      bool writeBinary(const std::string& filepath);
+
+      /**
+       * @brief Writes this formula to the standard output
+       * 
+       * @param threads The number of threads to format the clauses with
+       * @param binary When set the binary cnf format is written instead of DIMACS
+       * @return bool True on success
        */
-      void addClauseToWatchLiterals(cnf::Clause* clause) {
-         if (clause->size() <= 1) {
+      bool writeToStandardOutput(unsigned threads, bool binary);
+
+      /**
+       * @brief Adds a binary clause to the binary implications, other clauses are not kept track of
+       * @note Is only called by the vector functions to keep the binary implications accurate at all times
+       * 
+       * @param clause The reference of the clause to add
+       */
+      void addClauseToImplications(const cnf::ClauseRef clause) {
+         if (2 != this->arena->size(clause)) {
             // nothing to be done
             return;
          }
 
-         //if there's at least 2 literals, add the first two literals of the clause to the watched literals
-         this->watchedLiterals[(*clause)[0]].push_back(clause);
-         this->watchedLiterals[(*clause)[1]].push_back(clause);
+         const int* literals = this->arena->begin(clause);
+         this->binaryImplications.add(clause, literals[0], literals[1]);
       }
 
       /**
-       * @brief Removes a clause from the watched literals.
-       * @note Is only called by vector functions to keep the watched literals accurate at all times
+       * @brief Removes a binary clause from the binary implications
+       * @note Is only called by vector functions to keep the binary implications accurate at all times
        * 
-       * @param clause The pointer to the clause to remove. The clause has to still exist when calling this
+       * @param clause The reference of the clause to remove. Has to be called after the clause was removed from the arena
        */
-      void removeClauseFromWatchLiterals(cnf::Clause* clause) {
-         for (int literal : *clause) {
-            auto& clauses = this->watchedLiterals[literal];
-            clauses.erase(
-               std::remove_if(clauses.begin(), clauses.end(), [&clause](cnf::Clause* c)->bool{
-                  return c == clause;
-               }),
-               clauses.end()
-            );
+      void removeClauseFromImplications(const cnf::ClauseRef clause) {
+         if (2 != this->arena->size(clause)) {
+            return;
          }
+         // once the snapshots are gone the removed clause can be dropped right away again
+         this->reclaimSharedImplications();
+         const int* literals = this->arena->begin(clause);
+         this->binaryImplications.remove(clause, literals[0], literals[1]);
       }
 
+      /**
+       * @brief Takes back the binary implications that were shared with snapshots once no snapshot uses them anymore,
+       * so removed clauses can be dropped from them again
+       * 
+       */
+      void reclaimSharedImplications() {
+         if (this->binaryImplications.isLastSharer()) {
+            this->binaryImplications.unshare([this](const ClauseRef ref) {
+               return this->isRemoved(ref);
+            });
+         }
+      }
+
+      /**
+       * @brief Checks whether changing or removing a clause would change it for another formula as well
+       * 
+       * @param clause The reference of the clause
+       * @return bool True if the clause is shared with another formula
+       */
+      bool isSharedClause(const cnf::ClauseRef clause) const {
+         return this->isShared() && this->arena->isShared(clause);
+      }
+
+      /**
+       * @brief Gives this formula its own copy of the clause storage if it is shared, has to be called before a shared
+       * clause is changed or removed. All references stay valid
+       * 
+       */
+      void detachClauses();
+
+      /**
+       * @brief Get a removed clause of this formula's own, which takes the place of the shared clauses it removed in
+       * clauses. It is added to the storage when it is first needed
+       * 
+       * @return ClauseRef The reference of the removed clause
+       */
+      ClauseRef getTombstone();
+
+      /**
+       * @brief Gives this formula its own copy of a shared clause, which takes the place of the shared clause in clauses
+       * and the occurrence lists. The shared clause is only removed from this formula. The binary implications are not
+       * updated, the caller has to rebuild them
+       * 
+       * @param index The position of the shared clause in clauses
+       * @return ClauseRef The reference of the copy
+       */
+      ClauseRef copySharedClause(size_type index);
+
+      /**
+       * @brief Get the position of a clause in clauses
+       * 
+       * @param clause The reference of the clause, has to be part of this formula
+       * @return size_type The position in clauses
+       */
+      size_type getPosition(ClauseRef clause);
+
+      /**
+       * @brief Gives the space of the clauses only this formula uses back to the shared clause storage
+       * 
+       * @details Clauses added since the snapshot are dropped from the end of the storage if no other formula added
+       * clauses since, otherwise they are marked as removed
+       */
+      void releaseClauses() noexcept;
+
+      /**
+       * @brief Clears the binary implications and adds every binary clause of the formula again
+       * 
+       */
+      void rebuildImplications();
+
+      /**
+       * @brief Marks the clause at the given position of clauses as removed
+       * 
+       * @param index The position in clauses, has to reference a clause that was not removed yet
+       * 
+       * @details The first and the last reference in clauses are kept pointing to clauses that were not removed, so
+       * removing clauses from the front or the back, e.g. when using the formula as a queue, stays constant time. A
+       * clause shared with another formula stays in the storage and is only removed from this formula
+       */
+      void removeAt(const size_type index) {
+         const ClauseRef clause = this->clauses[index];
+         if (this->isSharedClause(clause)) {
+            this->removedSharedClauses.insert(clause);
+            this->clauses[index] = this->getTombstone();
+         }
+         else {
+            this->arena->remove(clause);
+         }
+         this->removeClauseFromImplications(clause);
+         this->removeClauseFromOccurrences(clause);
+         this->removeClauseFromStatistics(clause);
+         ++this->removedClauses;
+
+         size_type kept = this->clauses.size();
+         while (kept > 0 && this->arena->isDeleted(this->clauses[kept - 1])) {
+            --kept;
+         }
+         if (this->isRecording()) {
+            // the references dropped from the end are kept, so they can be put back in the same order
+            this->trimmedReferences.insert(this->trimmedReferences.end(), this->clauses.begin() + kept, this->clauses.end());
+            this->edits.push_back({EDIT::CLAUSE_REMOVED, clause, 0, index, this->firstClause, this->clauses.size() - kept});
+         }
+         this->removedClauses -= this->clauses.size() - kept;
+         this->clauses.resize(kept);
+         while (this->firstClause < this->clauses.size() && this->arena->isDeleted(this->clauses[this->firstClause])) {
+            ++this->firstClause;
+         }
+         if (this->clauses.empty()) {
+            this->firstClause = 0;
+         }
+      }
+
+      /**
+       * @brief Get the position in clauses of the nth clause that was not removed
+       * 
+       * @param n The number of the clause
+       * @return size_type The position in clauses
+       */
+      size_type getIndex(const size_type n) const {
+         // when all removed clauses are at the front, the position can be computed directly
+         if (this->removedClauses == this->firstClause) {
+            return this->firstClause + n;
+         }
+         size_type remaining = n;
+         for (size_type i = this->firstClause; ; ++i) {
+            if (!this->arena->isDeleted(this->clauses[i]) && 0 == remaining--) {
+               return i;
+            }
+         }
+      }
+
+      /**
+       * @brief Removes the references of removed clauses from clauses, keeping the order of the remaining ones
+       * 
+       */
+      void dropRemovedReferences();
+
+      /**
+       * @brief Calls dropRemovedReferences() once at least half of the references belong to removed clauses
+       * 
+       */
+      void dropRemovedReferencesIfWasteful() {
+         if (2 * this->removedClauses > this->clauses.size()) {
+            this->dropRemovedReferences();
+         }
+      }
+
+      /**
+       * @brief Adds a clause to the occurrence lists, if they are enabled
+       * 
+       * @param clause The reference of the clause to add
+       */
+      void addClauseToOccurrences(const cnf::ClauseRef clause) {
+         if (this->occurrenceListsEnabled) {
+            this->occurrences.add(clause, this->arena->begin(clause), this->arena->end(clause));
+         }
+      }
+
+      /**
+       * @brief Removes a clause from the occurrence lists, if they are enabled
+       * 
+       * @param clause The reference of the clause to remove. Has to be called after the clause was removed from the arena
+       */
+      void removeClauseFromOccurrences(const cnf::ClauseRef clause) {
+         if (this->occurrenceListsEnabled) {
+            this->occurrences.remove(this->arena->begin(clause), this->arena->end(clause), [this](const ClauseRef ref) {
+               return this->isRemoved(ref);
+            });
+         }
+      }
+
+      /**
+       * @brief Counts a literal that was added to a clause of the formula
+       * 
+       * @param literal The literal
+       */
+      void addLiteralToStatistics(const int literal) {
+         ++this->literals;
+         const std::size_t variable = static_cast<std::size_t>(std::abs(literal));
+         if (0 == variable) {
+            // the literal of an unsatisfied clause, see ClauseView::setLiteral()
+            return;
+         }
+         if (variable >= this->variableOccurrences.size()) {
+            this->variableOccurrences.resize(variable + 1, 0);
+         }
+         if (0 == this->variableOccurrences[variable]++) {
+            ++this->variables;
+            this->maxVariable = std::max(this->maxVariable, static_cast<unsigned>(variable));
+         }
+      }
+
+      /**
+       * @brief Stops counting a literal that was removed from a clause of the formula
+       * 
+       * @param literal The literal
+       */
+      void removeLiteralFromStatistics(const int literal) {
+         --this->literals;
+         const std::size_t variable = static_cast<std::size_t>(std::abs(literal));
+         if (0 != variable && 0 == --this->variableOccurrences[variable]) {
+            --this->variables;
+            // the next smaller variable is only searched when it's asked for
+            this->maxVariableDirtyBit = this->maxVariableDirtyBit || variable == this->maxVariable;
+         }
+      }
+
+      /**
+       * @brief Counts the literals of a clause that was added to the formula
+       * 
+       * @param clause The reference of the clause
+       */
+      void addClauseToStatistics(const cnf::ClauseRef clause) {
+         for (const int* literal = this->arena->begin(clause); literal != this->arena->end(clause); ++literal) {
+            this->addLiteralToStatistics(*literal);
+         }
+      }
+
+      /**
+       * @brief Stops counting the literals of a clause that was removed from the formula
+       * 
+       * @param clause The reference of the clause, its literals have to be unchanged since it was counted
+       */
+      void removeClauseFromStatistics(const cnf::ClauseRef clause) {
+         for (const int* literal = this->arena->begin(clause); literal != this->arena->end(clause); ++literal) {
+            this->removeLiteralFromStatistics(*literal);
+         }
+      }
+
+      /**
+       * @brief Counts the variables and literals of all clauses again
+       * 
+       */
+      void rebuildStatistics();
+
+      /**
+       * @brief Clears the occurrence lists and adds every clause of the formula again, if they are enabled
+       * 
+       */
+      void rebuildOccurrenceLists();
+
+      /**
+       * @brief Renames a variable in every clause it occurs in
+       * 
+       * @param variable The variable to rename
+       * @param newName The name to rename the variable to
+       */
+      void renameVariableInClauses(unsigned variable, unsigned newName);
+
+      /**
+       * @brief Renames all variables in one pass over the clauses, split between the threads set on the command line
+       * 
+       * @param newNames The new name of every variable, indexed by the current name. Variables behind its end keep
+       * their name
+       */
+      void renameVariables(const std::vector<unsigned>& newNames);
+
+      /**
+       * @brief Rebuilds compressionMap, decompressionMap and compressionValues from the compressionInformation, if they
+       * are out of date
+       * 
+       */
+      void updateCompressionMaps();
+
    private:
 
       /**
-       * @brief The clauses in this formula. Exposed using the standard vector functions
+       * @brief Stores the literals of all clauses of this formula in one contiguous buffer, shared with snapshots
+       * 
+       */
+      std::shared_ptr<ClauseArena> arena = std::make_shared<ClauseArena>();
+
+      /**
+       * @brief Number of clauses in the storage when this formula was created by snapshot(), 0 otherwise
+       * 
+       */
+      std::size_t snapshotClauses = 0;
+
+      /**
+       * @brief Number of clauses this formula added to the storage since it was created
+       * 
+       */
+      std::size_t addedClauses = 0;
+
+      /**
+       * @brief References to the clauses in this formula, in order. Exposed using the standard vector functions
+       * 
+       */
+      std::vector<ClauseRef> clauses;
+
+      /**
+       * @brief Position of the first reference in clauses that belongs to a clause that was not removed
        * 
        */
-      Clauses clauses;
+      size_type firstClause = 0;
+
+      /**
+       * @brief Number of references in clauses that belong to removed clauses
+       * 
+       */
+      size_type removedClauses = 0;
+
+      /**
+       * @brief Reference used for clauses that don't exist
+       * 
+       */
+      static constexpr ClauseRef NO_CLAUSE = std::numeric_limits<ClauseRef>::max();
+
+      /**
+       * @brief The shared clauses this formula removed or replaced by a copy of its own. The other formulas keep using
+       * them, so they are not marked as removed in the storage
+       * 
+       */
+      std::unordered_set<ClauseRef> removedSharedClauses;
+
+      /**
+       * @brief The removed clause in place of the removed shared clauses in clauses, NO_CLAUSE until it is needed
+       * 
+       */
+      ClauseRef tombstone = NO_CLAUSE;
+
+      /**
+       * @brief The position of every clause in clauses, indexed by reference. Built when getPosition() finds it out of
+       * date, which only happens after the positions changed
+       * 
+       */
+      std::vector<size_type> positions;
 
       /**
        * @brief Name of the formula
@@ -445,28 +1215,36 @@ namespace preppy::cnf {
       std::set<std::string> procedures;
 
       /**
-       * @brief Number of variables in this formula, stored so it does not need to be recalculated every time it is asked
+       * @brief How often every variable occurs in the clauses, indexed by variable. Kept up to date on every change of
+       * the clauses, so the statistics never have to be recalculated
        * 
        */
-      unsigned variables;
+      std::vector<unsigned> variableOccurrences;
 
       /**
-       * @brief Dirty bit for variables count, if true "variables" might be wrong
+       * @brief Number of variables in this formula, i.e. the number of non zero variableOccurrences
        * 
        */
-      bool variablesDirtyBit = true;
+      unsigned variables = 0;
 
       /**
-       * @brief The maximum variable in this formula, stored so it does not need to be recalculated every time it is asked
+       * @brief The maximum variable in this formula
        * 
        */
-      unsigned maxVariable;
+      unsigned maxVariable = 0;
 
       /**
-       * @brief Dirty bit for the maxVariable, if true "maVariable" might be wrong
+       * @brief Dirty bit for the maxVariable, if true the variable "maxVariable" doesn't occur anymore and the actual
+       * maximum is smaller
        * 
        */
-      bool maxVariableDirtyBit = true;
+      bool maxVariableDirtyBit = false;
+
+      /**
+       * @brief The number of literals in all clauses
+       * 
+       */
+      std::size_t literals = 0;
 
       /**
        * @brief Compression information for compressing original models and decompressing models of this to the original
@@ -476,12 +1254,85 @@ namespace preppy::cnf {
       std::vector<std::tuple<unsigned, unsigned, bool>> compressionInformation;
 
       /**
-       * @brief Saves pointers to clauses, each clause is in here exactly twice (except for unit clauses)
+       * @brief The current name of every variable of the original formula, 0 if it's not part of this formula anymore.
+       * Variables behind its end were never renamed
+       * 
+       */
+      std::vector<unsigned> compressionMap;
+
+      /**
+       * @brief The original name of every variable of this formula, 0 if the name is not used anymore. Variables behind
+       * its end were never renamed
+       * 
+       */
+      std::vector<unsigned> decompressionMap;
+
+      /**
+       * @brief The value of every variable of the original formula that is not part of this formula anymore
+       * 
+       */
+      std::vector<bool> compressionValues;
+
+      /**
+       * @brief Dirty bit for the compression maps, if true they don't match the compressionInformation
+       * 
+       */
+      bool compressionMapsDirtyBit = true;
+
+      /**
+       * @brief The binary clauses of this formula as implications between their literals. Mutable since sharing them
+       * with a snapshot doesn't change them
+       * 
+       */
+      mutable BinaryImplications binaryImplications;
+
+      /**
+       * @brief Dirty bit for the binary implications, set when literals of clauses were renamed in place
+       * 
+       */
+      bool implicationsDirtyBit = false;
+
+      /**
+       * @brief The clauses every literal occurs in, only kept while occurrenceListsEnabled is set
+       * 
+       */
+      OccurrenceLists occurrences;
+
+      /**
+       * @brief Whether the occurrence lists are kept up to date
+       * 
+       */
+      bool occurrenceListsEnabled = false;
+
+      /**
+       * @brief The open transactions, innermost last
+       * 
+       */
+      std::vector<Transaction> transactions;
+
+      /**
+       * @brief The changes recorded since the outermost transaction was started, in order
+       * 
+       */
+      std::vector<Edit> edits;
+
+      /**
+       * @brief References of removed clauses that were dropped from the end of clauses while recording
+       * 
+       */
+      std::vector<ClauseRef> trimmedReferences;
+
+      /**
+       * @brief The references in clauses before they were dropped while recording
+       * 
+       */
+      std::vector<std::vector<ClauseRef>> droppedReferences;
+
+      /**
+       * @brief Snapshots of the formula before it was changed as a whole while recording
        * 
-       * @details This is used primarily by the BooleanConstraintPropagation procedure. It is stored in this class because
-       * otherwise the procedure has to rebuild it in every iteration, which is very slow.
        */
-      WatchedLiteralsT watchedLiterals;
+      std::vector<std::unique_ptr<cnf::CNF>> replacedFormulas;
 
    };
 
@@ -18,11 +18,18 @@
 #include <vector>
 #include <initializer_list>
 #include <algorithm>
+#include <charconv>
 
 namespace preppy::cnf {
 
    Clause::Clause(std::initializer_list<preppy::cnf::Literals::value_type> l) 
-      : literals(l) {
+      : literals(l)
+      , signature(computeSignature(l.begin(), l.end())) {
+   }
+
+   Clause::Clause(const Literals::value_type* first, const Literals::value_type* last)
+      : literals(first, last)
+      , signature(computeSignature(first, last)) {
    }
 
    Clause::Clause(const std::string& line) {
@@ -41,26 +48,57 @@ namespace preppy::cnf {
       }
    }
 
+   void Clause::normalize() {
+      this->literals.erase(normalizeLiterals(this->literals.begin(), this->literals.end()), this->literals.end());
+      this->normalized = true;
+   }
+
+   void Clause::insertSorted(const int literal) {
+      const auto position = std::lower_bound(this->literals.begin(), this->literals.end(), literal, literalLess);
+      if (position == this->literals.end() || *position != literal) {
+         this->literals.insert(position, literal);
+         this->signature |= literalSignature(literal);
+      }
+   }
+
+   void Clause::checkNormalized(LiteralStorage::const_iterator first, LiteralStorage::const_iterator last) {
+      if (!this->normalized) {
+         return;
+      }
+      // only the added literals and their direct neighbours can be out of order
+      first = (first == this->literals.begin()) ? first : first - 1;
+      last = (last == this->literals.end()) ? last : last + 1;
+      this->normalized = cnf::isNormalized(first, last);
+   }
+
    bool Clause::containsLiteral(const int literal) const {
-      return std::find(this->begin(), this->end(), literal) != this->end();
+      if (0 == (this->signature & literalSignature(literal))) {
+         return false;
+      }
+      return findLiteral(this->begin(), this->end(), literal, this->normalized) != this->end();
    }
 
    bool Clause::setLiteral(const int literal) {
+      // neither the literal nor its negation can be part of the clause
+      if (0 == (this->signature & (literalSignature(literal) | literalSignature(-literal)))) {
+         return false;
+      }
+
       // if the literal is found -> the clause is satisfied
-      if (std::find(this->begin(), this->end(), literal) != this->end()) {
-         this->literals = {};
+      if (findLiteral(this->begin(), this->end(), literal, this->normalized) != this->end()) {
+         this->clear();
          return true;
       }
 
       // if the negated literal is found -> remove that literal
-      auto litPos = std::find(this->begin(), this->end(), -literal);
+      const int* litPos = findLiteral(this->begin(), this->end(), -literal, this->normalized);
       if (litPos != this->end()) {
          this->erase(litPos);
       }
 
       // if the last literal was just set to false this clause is now unsatisfied
       if (this->size() == 0) {
-         this->literals = {0};
+         this->push_back(0);
       }
 
       return false;
@@ -77,8 +115,9 @@ namespace preppy::cnf {
    }
 
    bool Clause::isSatisfied(const cnf::Literals& literals) const {
-      for (const auto& lit : this->literals) {
-         if (std::find(literals.begin(), literals.end(), lit) != literals.end()) {
+      // the signature rejects almost all literals that are not part of the clause without scanning it
+      for (const auto& lit : literals) {
+         if (this->containsLiteral(lit)) {
             return true;
          }
       }
@@ -100,6 +139,10 @@ namespace preppy::cnf {
             lit = (lit < 0) ? -newVar : newVar;
          }
       }
+      if (this->normalized) {
+         this->normalize();
+      }
+      this->updateSignature();
    }
 
    std::string Clause::toString() const {
@@ -116,12 +159,32 @@ namespace preppy::cnf {
    }
 
    std::string Clause::toCNFLine() const {
-      std::ostringstream ss;
-      for (auto literal : *this) {
-         ss << literal << " ";
+      // "-2147483648 " is the longest possible literal
+      std::string line((this->size() + 1) * 12, '\0');
+      char* position = line.data();
+      for (const int literal : *this) {
+         position = std::to_chars(position, position + 12, literal).ptr;
+         *position++ = ' ';
       }
-      ss << "0\n";
-      return ss.str();
+      *position++ = '0';
+      *position++ = '\n';
+      line.resize(static_cast<std::size_t>(position - line.data()));
+      return line;
+   }
+
+   bool Clause::subsumes(const cnf::Clause& other) const {
+      if (0 != (this->signature & ~other.signature)) {
+         return false;
+      }
+      if (this->normalized && other.normalized) {
+         return std::includes(other.begin(), other.end(), this->begin(), this->end(), literalLess);
+      }
+      for (const int literal : *this) {
+         if (!other.containsLiteral(literal)) {
+            return false;
+         }
+      }
+      return true;
    }
 
    unsigned Clause::getMaxVariable() const {
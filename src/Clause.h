@@ -12,6 +12,7 @@
 #pragma once
 
 #include "definitions.h"
+#include "SmallVector.h"
 
 #include <string>
 #include <vector>
@@ -27,12 +28,48 @@ namespace preppy::cnf {
    class Clause {
    public:
 
+      /**
+       * @brief The container of the literals, clauses of up to 4 literals don't need a heap allocation
+       * 
+       */
+      typedef util::SmallVector<int, 4> LiteralStorage;
+
       /**
        * @brief Construct empty Clause
        * 
        */
       Clause() = default;
 
+      /**
+       * @brief Copy a Clause
+       * 
+       * @param other The Clause to copy
+       */
+      Clause(const Clause& other) = default;
+
+      /**
+       * @brief Move a Clause, takes over the heap storage of longer clauses instead of copying it
+       * 
+       * @param other The Clause to move, empty afterwards
+       */
+      Clause(Clause&& other) noexcept = default;
+
+      /**
+       * @brief Copy other to this
+       * 
+       * @param other The Clause to copy
+       * @return Clause& A reference to this
+       */
+      Clause& operator=(const Clause& other) = default;
+
+      /**
+       * @brief Move other to this
+       * 
+       * @param other The Clause to move, empty afterwards
+       * @return Clause& A reference to this
+       */
+      Clause& operator=(Clause&& other) noexcept = default;
+
       /**
        * @brief Constructs clause with given literals
        * 
@@ -40,6 +77,14 @@ namespace preppy::cnf {
        */
       Clause(std::initializer_list<Literals::value_type> l);
 
+      /**
+       * @brief Constructs clause with the literals in the range [first, last)
+       * 
+       * @param first Pointer to the first literal
+       * @param last Pointer behind the last literal
+       */
+      Clause(const Literals::value_type* first, const Literals::value_type* last);
+
       /**
        * @brief Construct this Clause from a line in a cnf file
        * 
@@ -115,118 +160,189 @@ namespace preppy::cnf {
        */
       unsigned getMaxVariable() const;
 
+      /**
+       * @brief Checks whether every literal of this clause is part of another clause
+       * 
+       * @param other The other clause
+       * @return bool True if this clause is a subset of other
+       */
+      bool subsumes(const cnf::Clause& other) const;
+
+      /**
+       * @brief Get the signature of this clause. Every literal of the clause has its bit set, but removing literals
+       * doesn't always clear their bit
+       * 
+       * @return Signature The signature
+       */
+      Signature getSignature() const {
+         return this->signature;
+      }
+
+      /**
+       * @brief Recomputes the signature from the literals, has to be called after literals were written through a reference.
+       * Also ends the normalization if the literals are not in order anymore
+       * 
+       */
+      void updateSignature() {
+         this->signature = computeSignature(this->literals.data(), this->literals.data() + this->literals.size());
+         this->normalized = this->normalized && cnf::isNormalized(this->literals.begin(), this->literals.end());
+      }
+
+      /**
+       * @brief Sorts the literals by literalLess() and removes duplicates. While the clause is normalized push_back()
+       * keeps it that way and lookups use binary searches. The other functions end the normalization if they break the order
+       * 
+       */
+      void normalize();
+
+      /**
+       * @brief Checks whether the clause is normalized, see normalize()
+       * 
+       * @return bool True if the literals are sorted and free of duplicates
+       */
+      bool isNormalized() const {
+         return this->normalized;
+      }
+
 #pragma region vectorfunctions
    //Put function definitions here for compiler optimizations and inlining
 
-   Literals::iterator begin() noexcept {
+   LiteralStorage::iterator begin() noexcept {
       return this->literals.begin();
    }
 
-   Literals::const_iterator begin() const noexcept {
+   LiteralStorage::const_iterator begin() const noexcept {
       return this->literals.begin();
    }
 
-   Literals::iterator end() noexcept {
+   LiteralStorage::iterator end() noexcept {
       return this->literals.end();
    }
 
-   Literals::const_iterator end() const noexcept {
+   LiteralStorage::const_iterator end() const noexcept {
       return this->literals.end();
    }
    
-   Literals::reference front() {
+   LiteralStorage::reference front() {
       return this->literals.front();
    }
 
-   Literals::const_reference front() const {
+   LiteralStorage::const_reference front() const {
       return this->literals.front();
    }
 
-   Literals::reference back() {
+   LiteralStorage::reference back() {
       return this->literals.back();
    }
    
-   Literals::const_reference back() const {
+   LiteralStorage::const_reference back() const {
       return this->literals.back();
    }
    
-   Literals::reference operator[](Literals::size_type n) {
+   LiteralStorage::reference operator[](LiteralStorage::size_type n) {
       return this->literals[n];
    }
 
-   Literals::const_reference operator[](Literals::size_type n) const {
+   LiteralStorage::const_reference operator[](LiteralStorage::size_type n) const {
       return this->literals[n];
    }
    
-   Literals::reference at(const Literals::size_type n) {
+   LiteralStorage::reference at(const LiteralStorage::size_type n) {
       return this->literals.at(n);
    }
 
-   Literals::const_reference at(const Literals::size_type n) const {
+   LiteralStorage::const_reference at(const LiteralStorage::size_type n) const {
       return this->literals.at(n);
    }
 
-   void push_back(const Literals::value_type& val) {
-      this->literals.push_back(val);
-   }
-
-   void push_back(Literals::value_type&& val) {
+   /**
+    * @brief Appends a literal. A normalized clause inserts it at its sorted position instead, if it is not
+    * already part of the clause
+    * 
+    * @param val The literal
+    */
+   void push_back(const LiteralStorage::value_type& val) {
+      if (this->normalized) {
+         this->insertSorted(val);
+         return;
+      }
       this->literals.push_back(val);
+      this->signature |= literalSignature(val);
    }
 
    void pop_back() {
       this->literals.pop_back();
    }
 
-   Literals::iterator erase(Literals::const_iterator position) {
-      return this->literals.erase(position);
+   LiteralStorage::iterator erase(LiteralStorage::const_iterator position) {
+      const auto next = this->literals.erase(position);
+      this->updateSignature();
+      return next;
    }
 
-   Literals::iterator erase(Literals::const_iterator first, Literals::const_iterator last) {
-      return this->literals.erase(first, last);
+   LiteralStorage::iterator erase(LiteralStorage::const_iterator first, LiteralStorage::const_iterator last) {
+      const auto next = this->literals.erase(first, last);
+      this->updateSignature();
+      return next;
    }
 
-   Literals::iterator insert(Literals::const_iterator position, const Literals::value_type& val) {
-      return this->literals.insert(position, val);
+   LiteralStorage::iterator insert(LiteralStorage::const_iterator position, const LiteralStorage::value_type& val) {
+      return this->insert(position, 1, val);
    }
 
-   Literals::iterator insert(Literals::const_iterator position, Literals::size_type n, const Literals::value_type& val) {
-      return this->literals.insert(position, n, val);
+   LiteralStorage::iterator insert(LiteralStorage::const_iterator position, LiteralStorage::size_type n, const LiteralStorage::value_type& val) {
+      this->signature |= literalSignature(val);
+      const auto inserted = this->literals.insert(position, n, val);
+      this->checkNormalized(inserted, inserted + n);
+      return inserted;
    }
 
-   Literals::iterator insert(Literals::const_iterator position, Literals::value_type&& val) {
-      return this->literals.insert(position, val);
-   }
-
-   Literals::iterator insert(Literals::const_iterator position, std::initializer_list<Literals::value_type> il) {
-      return this->literals.insert(position, il);
+   LiteralStorage::iterator insert(LiteralStorage::const_iterator position, std::initializer_list<LiteralStorage::value_type> il) {
+      this->signature |= computeSignature(il.begin(), il.end());
+      const auto inserted = this->literals.insert(position, il);
+      this->checkNormalized(inserted, inserted + il.size());
+      return inserted;
    }
 
    void clear() noexcept {
       this->literals.clear();
+      this->signature = 0;
    }
 
-   void reserve(Literals::size_type n) {
+   void reserve(LiteralStorage::size_type n) {
       this->literals.reserve(n);
    }
 
-   Literals::size_type capacity() const noexcept {
+   LiteralStorage::size_type capacity() const noexcept {
       return this->literals.capacity();
    }
 
-   void resize(Literals::size_type n) {
-      this->literals.resize(n);
+   void resize(LiteralStorage::size_type n) {
+      this->resize(n, 0);
    }
 
-   void resize(Literals::size_type n, const Literals::value_type& val) {
+   void resize(LiteralStorage::size_type n, const LiteralStorage::value_type& val) {
+      const LiteralStorage::size_type oldSize = this->literals.size();
       this->literals.resize(n, val);
+      if (n > oldSize) {
+         this->checkNormalized(this->literals.begin() + oldSize, this->literals.end());
+      }
+      this->updateSignature();
    }
 
-   Literals::size_type size() const noexcept {
+   LiteralStorage::size_type size() const noexcept {
       return this->literals.size();
    }
 
-   Literals::size_type max_size() const noexcept {
+   LiteralStorage::value_type* data() noexcept {
+      return this->literals.data();
+   }
+
+   const LiteralStorage::value_type* data() const noexcept {
+      return this->literals.data();
+   }
+
+   LiteralStorage::size_type max_size() const noexcept {
       return this->literals.max_size();
    }
 
@@ -237,11 +353,38 @@ namespace preppy::cnf {
 
    private:
 
+      /**
+       * @brief Inserts a literal at its sorted position, unless the clause already contains it
+       * 
+       * @param literal The literal
+       */
+      void insertSorted(int literal);
+
+      /**
+       * @brief Ends the normalization if the literals in [first, last) are not in order with their neighbours
+       * 
+       * @param first The first literal that was added
+       * @param last Behind the last literal that was added
+       */
+      void checkNormalized(LiteralStorage::const_iterator first, LiteralStorage::const_iterator last);
+
       /**
        * @brief The literals in this Clause \n Exposed through the standard vector functions
        * 
        */
-      Literals literals;
+      LiteralStorage literals;
+
+      /**
+       * @brief The signature of the literals, kept up to date by every function changing the literals
+       * 
+       */
+      Signature signature = 0;
+
+      /**
+       * @brief True while the literals are sorted by literalLess() and free of duplicates, see normalize()
+       * 
+       */
+      bool normalized = false;
 
    };
 
@@ -0,0 +1,300 @@
+/**
+ * @file ClauseArena.cpp
+ * @author Anton Reinhard
+ * @brief Contiguous clause storage implementation
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "ClauseArena.h"
+#include "Model.h"
+
+#include <sstream>
+#include <algorithm>
+#include <cstdlib>
+
+namespace preppy::cnf {
+
+   ClauseRef ClauseArena::add(const int* first, const int* last) {
+      const std::size_t size = static_cast<std::size_t>(last - first);
+      const std::size_t offset = this->literals.size();
+
+      // the range may point into this arena, so remember it as a position before the buffer can reallocate
+      const bool inside = !this->literals.empty() && first >= this->literals.data() && first < this->literals.data() + offset;
+      const std::size_t source = inside ? static_cast<std::size_t>(first - this->literals.data()) : 0;
+
+      this->literals.resize(offset + size + 1);
+      if (inside) {
+         first = this->literals.data() + source;
+      }
+      std::copy(first, first + size, this->literals.begin() + offset);
+      this->literals[offset + size] = 0;
+
+      const int* added = this->literals.data() + offset;
+      const std::uint32_t flags = cnf::isNormalized(added, added + size) ? CLAUSE_NORMALIZED : 0;
+      this->headers.push_back({offset, static_cast<std::uint32_t>(size), flags, computeSignature(added, added + size)});
+      return static_cast<ClauseRef>(this->headers.size() - 1);
+   }
+
+   void ClauseArena::adopt(Literals&& zeroTerminated, const std::size_t clauses) {
+      this->literals = std::move(zeroTerminated);
+      this->headers.clear();
+      this->headers.reserve(clauses);
+      this->wasted = 0;
+      this->sharedClauses = 0;
+
+      std::size_t clauseStart = 0;
+      for (std::size_t i = 0; i < this->literals.size(); ++i) {
+         if (0 == this->literals[i]) {
+            const int* clause = this->literals.data() + clauseStart;
+            const int* clauseEnd = this->literals.data() + i;
+            const std::uint32_t flags = cnf::isNormalized(clause, clauseEnd) ? CLAUSE_NORMALIZED : 0;
+            this->headers.push_back({clauseStart, static_cast<std::uint32_t>(i - clauseStart), flags, computeSignature(clause, clauseEnd)});
+            clauseStart = i + 1;
+         }
+      }
+   }
+
+   void ClauseArena::remove(const ClauseRef ref) {
+      ClauseHeader& header = this->headers[ref];
+      if (0 == (header.flags & CLAUSE_DELETED)) {
+         header.flags |= CLAUSE_DELETED;
+         this->wasted += header.size + 1;
+      }
+   }
+
+   void ClauseArena::restore(const ClauseRef ref) {
+      ClauseHeader& header = this->headers[ref];
+      if (0 != (header.flags & CLAUSE_DELETED)) {
+         header.flags &= ~CLAUSE_DELETED;
+         this->wasted -= std::min<std::size_t>(this->wasted, header.size + 1);
+      }
+   }
+
+   void ClauseArena::resize(const ClauseRef ref, const std::uint32_t size) {
+      ClauseHeader& header = this->headers[ref];
+      if (size < header.size) {
+         this->wasted += header.size - size;
+      }
+      else {
+         this->wasted -= std::min<std::size_t>(this->wasted, size - header.size);
+      }
+      header.size = size;
+      this->updateSignature(ref);
+   }
+
+   void ClauseArena::updateNormalized(const ClauseRef ref) {
+      ClauseHeader& header = this->headers[ref];
+      if (cnf::isNormalized(this->begin(ref), this->end(ref))) {
+         header.flags |= CLAUSE_NORMALIZED;
+      }
+      else {
+         header.flags &= ~CLAUSE_NORMALIZED;
+      }
+   }
+
+   void ClauseArena::compact(std::vector<ClauseRef>& order) {
+      std::size_t total = 0;
+      for (const ClauseRef ref : order) {
+         total += this->headers[ref].size + 1;
+      }
+
+      Literals compacted;
+      compacted.reserve(total);
+      std::vector<ClauseHeader> compactedHeaders;
+      compactedHeaders.reserve(order.size());
+
+      for (std::size_t i = 0; i < order.size(); ++i) {
+         const ClauseHeader& header = this->headers[order[i]];
+         compactedHeaders.push_back({compacted.size(), header.size, header.flags & ~CLAUSE_DELETED, header.signature});
+         compacted.insert(compacted.end(), this->begin(order[i]), this->end(order[i]));
+         compacted.push_back(0);
+         order[i] = static_cast<ClauseRef>(i);
+      }
+
+      this->literals = std::move(compacted);
+      this->headers = std::move(compactedHeaders);
+      this->wasted = 0;
+      this->sharedClauses = 0;
+   }
+
+   bool ClauseArena::isFragmented() const {
+      return 2 * this->wasted > this->literals.size();
+   }
+
+   void ClauseArena::reserve(const std::size_t clauses, const std::size_t literals) {
+      this->headers.reserve(clauses);
+      this->literals.reserve(literals + clauses);
+   }
+
+   void ClauseArena::clear() {
+      this->literals.clear();
+      this->headers.clear();
+      this->wasted = 0;
+      this->sharedClauses = 0;
+   }
+
+   void ClauseArena::truncate(const ClauseRef first) {
+      if (first >= this->headers.size()) {
+         return;
+      }
+
+      // every dropped slot either belongs to a live clause or was counted as wasted. An empty clause set to {0} uses
+      // its terminator, so the live slots are clamped
+      const std::size_t offset = this->headers[first].offset;
+      const std::size_t dropped = this->literals.size() - offset;
+      std::size_t used = 0;
+      for (std::size_t ref = first; ref < this->headers.size(); ++ref) {
+         if (0 == (this->headers[ref].flags & CLAUSE_DELETED)) {
+            used += this->headers[ref].size + 1;
+         }
+      }
+      this->wasted -= std::min(this->wasted, dropped - std::min(dropped, used));
+
+      this->literals.resize(offset);
+      this->headers.resize(first);
+      this->sharedClauses = std::min<std::size_t>(this->sharedClauses, first);
+   }
+
+   std::size_t ClauseArena::getWastedLiterals() const {
+      return this->wasted;
+   }
+
+   cnf::Clause ClauseView::toClause() const {
+      return cnf::Clause(this->begin(), this->end());
+   }
+
+   bool ClauseView::containsLiteral(const int literal) const {
+      if (0 == (this->getSignature() & literalSignature(literal))) {
+         return false;
+      }
+      return findLiteral(this->begin(), this->end(), literal, this->isNormalized()) != this->end();
+   }
+
+   bool ClauseView::setLiteral(const int literal) {
+      // neither the literal nor its negation can be part of the clause
+      if (0 == (this->getSignature() & (literalSignature(literal) | literalSignature(-literal)))) {
+         return false;
+      }
+
+      // if the literal is found -> the clause is satisfied
+      if (this->containsLiteral(literal)) {
+         this->arena->resize(this->ref, 0);
+         return true;
+      }
+
+      // if the negated literal is found -> remove that literal
+      const int* litPos = findLiteral(this->begin(), this->end(), -literal, this->isNormalized());
+      if (litPos != this->end()) {
+         this->erase(litPos);
+      }
+
+      // if the last literal was just set to false this clause is now unsatisfied, every clause has a slot left for that
+      if (this->size() == 0) {
+         this->arena->resize(this->ref, 1);
+         (*this)[0] = 0;
+         this->arena->updateSignature(this->ref);
+      }
+
+      return false;
+   }
+
+   bool ClauseView::setLiterals(const cnf::Model& assignment) {
+      // the literals that are not assigned are moved to the front
+      int* kept = this->begin();
+      for (const int literal : *this) {
+         if (assignment.isTrue(literal)) {
+            this->arena->resize(this->ref, 0);
+            return true;
+         }
+         if (!assignment.isAssigned(static_cast<std::size_t>(std::abs(literal)))) {
+            *kept++ = literal;
+         }
+      }
+
+      const std::uint32_t size = static_cast<std::uint32_t>(kept - this->begin());
+      if (0 == size) {
+         // every literal was set to false, every clause has a slot left for that
+         this->arena->resize(this->ref, 1);
+         (*this)[0] = 0;
+         this->arena->updateSignature(this->ref);
+      }
+      else if (size != this->size()) {
+         this->arena->resize(this->ref, size);
+      }
+
+      return false;
+   }
+
+   cnf::Clause ClauseView::getPartialClause(const cnf::Literals& literals) const {
+      return this->toClause().getPartialClause(literals);
+   }
+
+   bool ClauseView::isSatisfied(const cnf::Literals& literals) const {
+      // the signature rejects almost all literals that are not part of the clause without scanning it
+      for (const int lit : literals) {
+         if (this->containsLiteral(lit)) {
+            return true;
+         }
+      }
+      return false;
+   }
+
+   cnf::Clause ClauseView::getComplement() const {
+      return this->toClause().getComplement();
+   }
+
+   void ClauseView::renameVariable(const unsigned oldVar, const unsigned newVar) {
+      for (int& lit : *this) {
+         if (static_cast<unsigned>(std::abs(lit)) == oldVar) {
+            lit = (lit < 0) ? -static_cast<int>(newVar) : static_cast<int>(newVar);
+         }
+      }
+      this->arena->updateSignature(this->ref);
+      this->arena->updateNormalized(this->ref);
+   }
+
+   void ClauseView::renameVariables(const std::vector<unsigned>& newNames) {
+      for (int& lit : *this) {
+         const std::size_t variable = static_cast<std::size_t>(std::abs(lit));
+         if (variable < newNames.size()) {
+            lit = (lit < 0) ? -static_cast<int>(newNames[variable]) : static_cast<int>(newNames[variable]);
+         }
+      }
+      this->arena->updateSignature(this->ref);
+      this->arena->updateNormalized(this->ref);
+   }
+
+   bool ClauseView::subsumes(const ClauseView& other) const {
+      if (0 != (this->getSignature() & ~other.getSignature())) {
+         return false;
+      }
+      if (this->isNormalized() && other.isNormalized()) {
+         return std::includes(other.begin(), other.end(), this->begin(), this->end(), literalLess);
+      }
+      for (const int literal : *this) {
+         if (!other.containsLiteral(literal)) {
+            return false;
+         }
+      }
+      return true;
+   }
+
+   std::string ClauseView::toString() const {
+      return this->toClause().toString();
+   }
+
+   unsigned ClauseView::getMaxVariable() const {
+      unsigned max = 0;
+      for (const int v : *this) {
+         if (static_cast<unsigned>(std::abs(v)) > max) {
+            max = std::abs(v);
+         }
+      }
+      return max;
+   }
+
+}
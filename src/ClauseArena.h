@@ -0,0 +1,638 @@
+/**
+ * @file ClauseArena.h
+ * @author Anton Reinhard
+ * @brief Contiguous clause storage header
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include "Clause.h"
+#include "definitions.h"
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include <algorithm>
+
+namespace preppy::cnf {
+
+   class Model;
+
+   /**
+    * @brief Compact description of a clause inside a ClauseArena
+    *
+    */
+   struct ClauseHeader {
+      /**
+       * @brief Position of the first literal in the arena's literal buffer
+       *
+       */
+      std::uint64_t offset;
+
+      /**
+       * @brief Number of literals in the clause
+       *
+       */
+      std::uint32_t size;
+
+      /**
+       * @brief Combination of the ClauseArena::CLAUSE_* flags
+       *
+       */
+      std::uint32_t flags;
+
+      /**
+       * @brief The signature of the literals of the clause
+       *
+       */
+      Signature signature;
+   };
+
+   /**
+    * @brief Stores the literals of many clauses in one contiguous buffer, every clause is referenced by a 32 bit index
+    *
+    * @details Every clause gets one slot more than its literals and is 0 terminated when it is added, exactly like
+    * in a cnf file. This way the literal buffer of a parser can be adopted as it is, and an emptied clause can always
+    * be set to the unsatisfied clause {0} in place. Clauses only ever shrink in place; removed clauses and removed
+    * literals stay in the buffer until compact() is called.
+    */
+   class ClauseArena {
+   public:
+
+      /**
+       * @brief Flag marking a clause that was removed
+       *
+       */
+      static constexpr std::uint32_t CLAUSE_DELETED = 1;
+
+      /**
+       * @brief Flag marking a clause whose literals are sorted by literalLess() and free of duplicates. It is detected
+       * when the clause is added, and since clauses only shrink in place only renaming a variable can end it
+       * 
+       */
+      static constexpr std::uint32_t CLAUSE_NORMALIZED = 2;
+
+      /**
+       * @brief Construct an empty arena
+       *
+       */
+      ClauseArena() = default;
+
+      /**
+       * @brief Adds a clause with the literals in the range [first, last)
+       *
+       * @param first Pointer to the first literal, may point into this arena
+       * @param last Pointer behind the last literal
+       * @return ClauseRef The reference of the new clause
+       */
+      ClauseRef add(const int* first, const int* last);
+
+      /**
+       * @brief Replaces the content of this arena with the clauses in the given buffer
+       *
+       * @param zeroTerminated Literals where every clause is terminated by a 0, e.g. from the DimacsParser. Is moved from
+       * @param clauses The number of clauses in the buffer, used to reserve the headers
+       */
+      void adopt(Literals&& zeroTerminated, std::size_t clauses = 0);
+
+      /**
+       * @brief Marks a clause as removed, its slots are freed by the next compaction
+       *
+       * @param ref The clause to remove
+       */
+      void remove(ClauseRef ref);
+
+      /**
+       * @brief Gives a removed clause back
+       *
+       * @param ref The clause, has to be removed and not compacted away since
+       */
+      void restore(ClauseRef ref);
+
+      /**
+       * @brief Changes the number of literals of a clause and recomputes its signature
+       *
+       * @param ref The clause to resize
+       * @param size The new size, has to be at most the size the clause was added with + 1
+       */
+      void resize(ClauseRef ref, std::uint32_t size);
+
+      /**
+       * @brief Recomputes the signature of a clause, has to be called after its literals were written in place
+       *
+       * @param ref The clause
+       */
+      inline void updateSignature(const ClauseRef ref) {
+         this->headers[ref].signature = computeSignature(this->begin(ref), this->end(ref));
+      }
+
+      /**
+       * @brief Checks again whether a clause is normalized, has to be called after its literals were reordered in place
+       * 
+       * @param ref The clause
+       */
+      void updateNormalized(ClauseRef ref);
+
+      /**
+       * @brief Rewrites the arena so it only contains the given clauses, stored back to back in the given order
+       *
+       * @param order The clauses to keep, will contain their new references afterwards, i.e. 0, 1, 2, ...
+       */
+      void compact(std::vector<ClauseRef>& order);
+
+      /**
+       * @brief Checks whether more than half of the literal buffer belongs to removed clauses or literals
+       *
+       * @return bool True if a compaction would at least halve the buffer
+       */
+      bool isFragmented() const;
+
+      /**
+       * @brief Reserves space for clauses and literals
+       *
+       * @param clauses The number of clauses
+       * @param literals The number of literals, without terminators
+       */
+      void reserve(std::size_t clauses, std::size_t literals);
+
+      /**
+       * @brief Removes all clauses
+       *
+       */
+      void clear();
+
+      /**
+       * @brief Notes that every clause stored so far may be used by more than one formula from now on
+       *
+       */
+      inline void share() {
+         this->sharedClauses = this->headers.size();
+      }
+
+      /**
+       * @brief Notes that no clause is used by more than one formula anymore, e.g. on a copy of a shared arena
+       *
+       */
+      inline void unshare() {
+         this->sharedClauses = 0;
+      }
+
+      /**
+       * @brief Checks whether a clause was stored before the last call of share()
+       *
+       * @param ref The clause
+       * @return bool True if the clause may be used by more than one formula
+       */
+      inline bool isShared(const ClauseRef ref) const {
+         return ref < this->sharedClauses;
+      }
+
+      /**
+       * @brief Drops the clause with the given reference and every clause stored after it, giving their slots back
+       *
+       * @param first The first clause to drop, has to be at most getClauses()
+       */
+      void truncate(ClauseRef first);
+
+      /**
+       * @brief Get the number of literal slots that are no longer used by any clause
+       *
+       * @return std::size_t The number of unused slots
+       */
+      std::size_t getWastedLiterals() const;
+
+      inline int* begin(const ClauseRef ref) {
+         return this->literals.data() + this->headers[ref].offset;
+      }
+
+      inline const int* begin(const ClauseRef ref) const {
+         return this->literals.data() + this->headers[ref].offset;
+      }
+
+      inline int* end(const ClauseRef ref) {
+         return this->begin(ref) + this->headers[ref].size;
+      }
+
+      inline const int* end(const ClauseRef ref) const {
+         return this->begin(ref) + this->headers[ref].size;
+      }
+
+      inline std::uint32_t size(const ClauseRef ref) const {
+         return this->headers[ref].size;
+      }
+
+      inline Signature getSignature(const ClauseRef ref) const {
+         return this->headers[ref].signature;
+      }
+
+      inline bool isDeleted(const ClauseRef ref) const {
+         return 0 != (this->headers[ref].flags & CLAUSE_DELETED);
+      }
+
+      inline bool isNormalized(const ClauseRef ref) const {
+         return 0 != (this->headers[ref].flags & CLAUSE_NORMALIZED);
+      }
+
+      inline std::size_t getClauses() const {
+         return this->headers.size();
+      }
+
+   private:
+
+      /**
+       * @brief The literals of all clauses
+       *
+       */
+      Literals literals;
+
+      /**
+       * @brief The headers of all clauses, indexed by ClauseRef
+       *
+       */
+      std::vector<ClauseHeader> headers;
+
+      /**
+       * @brief Number of slots in literals that were freed by removing clauses or literals
+       *
+       */
+      std::size_t wasted = 0;
+
+      /**
+       * @brief Number of clauses stored before the last call of share()
+       *
+       */
+      std::size_t sharedClauses = 0;
+
+   };
+
+   /**
+    * @brief A handle to a clause stored in a ClauseArena, offering the same functions as a Clause
+    *
+    * @details The view stays valid when clauses are added to the arena, since it doesn't keep pointers into the
+    * literal buffer, but not across a compaction. operator-> and operator* return the view itself so code iterating
+    * a CNF can keep writing clause->size() and *clause.
+    */
+   class ClauseView {
+   public:
+
+      /**
+       * @brief Construct a view of a clause
+       *
+       * @param arena The arena the clause is stored in
+       * @param ref The reference of the clause
+       */
+      ClauseView(ClauseArena* arena, ClauseRef ref)
+         : arena(arena)
+         , ref(ref) {
+      }
+
+      /**
+       * @brief Get the reference of the viewed clause
+       *
+       * @return ClauseRef The reference
+       */
+      ClauseRef getRef() const {
+         return this->ref;
+      }
+
+      /**
+       * @brief Copies the viewed clause into a standalone Clause
+       *
+       * @return cnf::Clause The copy
+       */
+      cnf::Clause toClause() const;
+
+      /**
+       * @brief Checks whether the clause contains a given literal
+       *
+       * @param literal The literal to look for
+       * @return bool True if the literal is part of the clause
+       */
+      bool containsLiteral(int literal) const;
+
+      /**
+       * @brief Sets the given literal to true, removes it from the clause if it's negated
+       *
+       * @param literal The literal to set
+       * @return bool True if the clause is satisfied afterwards
+       */
+      bool setLiteral(int literal);
+
+      /**
+       * @brief Sets all literals of an assignment at once, in a single pass over the clause. Removes the literals that
+       * are false, the clause becomes {0} if none is left
+       *
+       * @param assignment The assignment, see Model::isTrue()
+       * @return bool True if the clause is satisfied, it has no literals left then
+       */
+      bool setLiterals(const cnf::Model& assignment);
+
+      /**
+       * @brief Returns this clause when the given literals are applied as facts to it
+       *
+       * @param literals The literals to apply
+       * @return cnf::Clause The resulting clause, {0} if unsatisfied
+       */
+      cnf::Clause getPartialClause(const cnf::Literals& literals) const;
+
+      /**
+       * @brief Returns true if the clause is satisfied when setting the given literals
+       *
+       * @param literals The literals to set
+       * @return bool True iff the clause is satisfied with the given literals
+       */
+      bool isSatisfied(const cnf::Literals& literals) const;
+
+      /**
+       * @brief Gets the complementary clause of this clause, meaning every literal is negated
+       *
+       * @return cnf::Clause The complementary clause
+       */
+      cnf::Clause getComplement() const;
+
+      /**
+       * @brief Renames the literals in the clause from old to new
+       *
+       * @param oldVar Old/Current name of the variable
+       * @param newVar New name to give to the variable
+       */
+      void renameVariable(unsigned oldVar, unsigned newVar);
+
+      /**
+       * @brief Renames all variables of the clause at once
+       *
+       * @param newNames The new name of every variable, indexed by the current name. Variables behind its end keep
+       * their name
+       */
+      void renameVariables(const std::vector<unsigned>& newNames);
+
+      /**
+       * @brief Get this clause as a human readable string
+       *
+       * @return std::string The clause as readable string
+       */
+      std::string toString() const;
+
+      /**
+       * @brief Get the maximum occurring variable in this clause
+       *
+       * @return unsigned The maximum variable
+       */
+      unsigned getMaxVariable() const;
+
+      /**
+       * @brief Checks whether every literal of this clause is part of another clause
+       *
+       * @param other The other clause
+       * @return bool True if this clause is a subset of other
+       */
+      bool subsumes(const ClauseView& other) const;
+
+      /**
+       * @brief Get the signature of the viewed clause
+       *
+       * @return Signature The signature
+       */
+      Signature getSignature() const {
+         return this->arena->getSignature(this->ref);
+      }
+
+      /**
+       * @brief Checks whether the literals of the viewed clause are sorted and free of duplicates
+       * 
+       * @return bool True if the clause is normalized
+       */
+      bool isNormalized() const {
+         return this->arena->isNormalized(this->ref);
+      }
+
+      ClauseView* operator->() {
+         return this;
+      }
+
+      const ClauseView* operator->() const {
+         return this;
+      }
+
+      ClauseView& operator*() {
+         return *this;
+      }
+
+      const ClauseView& operator*() const {
+         return *this;
+      }
+
+#pragma region vectorfunctions
+   //Put function definitions here for compiler optimizations and inlining
+
+   int* begin() noexcept {
+      return this->arena->begin(this->ref);
+   }
+
+   const int* begin() const noexcept {
+      return this->arena->begin(this->ref);
+   }
+
+   int* end() noexcept {
+      return this->arena->end(this->ref);
+   }
+
+   const int* end() const noexcept {
+      return this->arena->end(this->ref);
+   }
+
+   int* data() noexcept {
+      return this->begin();
+   }
+
+   const int* data() const noexcept {
+      return this->begin();
+   }
+
+   int& front() {
+      return *this->begin();
+   }
+
+   const int& front() const {
+      return *this->begin();
+   }
+
+   int& back() {
+      return *(this->end() - 1);
+   }
+
+   const int& back() const {
+      return *(this->end() - 1);
+   }
+
+   int& operator[](std::size_t n) {
+      return this->begin()[n];
+   }
+
+   const int& operator[](std::size_t n) const {
+      return this->begin()[n];
+   }
+
+   int* erase(const int* position) {
+      int* first = this->begin() + (position - this->begin());
+      std::copy(first + 1, this->end(), first);
+      this->arena->resize(this->ref, this->size() - 1);
+      return first;
+   }
+
+   /**
+    * @note Clauses can't grow beyond their size when they were added, so this only gives back erased literals
+    */
+   int* insert(const int* position, const int literal) {
+      const std::size_t index = static_cast<std::size_t>(position - this->begin());
+      this->arena->resize(this->ref, this->size() + 1);
+      int* first = this->begin() + index;
+      std::copy_backward(first, this->end() - 1, this->end());
+      *first = literal;
+      this->arena->updateSignature(this->ref);
+      this->arena->updateNormalized(this->ref);
+      return first;
+   }
+
+   std::size_t size() const noexcept {
+      return this->arena->size(this->ref);
+   }
+
+   bool empty() const noexcept {
+      return 0 == this->size();
+   }
+
+#pragma endregion vectorfunctions
+
+   private:
+
+      /**
+       * @brief The arena the clause is stored in
+       *
+       */
+      ClauseArena* arena;
+
+      /**
+       * @brief The reference of the clause in the arena
+       *
+       */
+      ClauseRef ref;
+
+   };
+
+   /**
+    * @brief Bidirectional iterator over a sequence of clause references, dereferencing to ClauseViews. References of
+    * removed clauses are skipped
+    *
+    */
+   class ClauseIterator {
+   public:
+      typedef std::bidirectional_iterator_tag iterator_category;
+      typedef ClauseView value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef ClauseView pointer;
+      typedef ClauseView reference;
+
+      /**
+       * @brief Construct an iterator, moves forward to the first clause that was not removed
+       *
+       * @param arena The arena the referenced clauses are stored in
+       * @param position The current position in the sequence of references
+       * @param last The end of the sequence of references
+       */
+      ClauseIterator(ClauseArena* arena, const ClauseRef* position, const ClauseRef* last)
+         : arena(arena)
+         , position(position)
+         , last(last) {
+         this->skipRemoved();
+      }
+
+      ClauseView operator*() const {
+         return ClauseView(this->arena, *this->position);
+      }
+
+      ClauseView operator->() const {
+         return ClauseView(this->arena, *this->position);
+      }
+
+      ClauseIterator& operator++() {
+         ++this->position;
+         this->skipRemoved();
+         return *this;
+      }
+
+      ClauseIterator operator++(int) {
+         ClauseIterator copy = *this;
+         ++(*this);
+         return copy;
+      }
+
+      ClauseIterator& operator--() {
+         do {
+            --this->position;
+         } while (this->arena->isDeleted(*this->position));
+         return *this;
+      }
+
+      ClauseIterator operator--(int) {
+         ClauseIterator copy = *this;
+         --(*this);
+         return copy;
+      }
+
+      bool operator==(const ClauseIterator& other) const {
+         return this->position == other.position;
+      }
+
+      bool operator!=(const ClauseIterator& other) const {
+         return this->position != other.position;
+      }
+
+      /**
+       * @brief Get the position in the underlying sequence of references
+       *
+       * @return const ClauseRef* The current position
+       */
+      const ClauseRef* getPosition() const {
+         return this->position;
+      }
+
+   private:
+
+      /**
+       * @brief Moves forward until the current reference belongs to a clause that was not removed
+       *
+       */
+      void skipRemoved() {
+         while (this->position != this->last && this->arena->isDeleted(*this->position)) {
+            ++this->position;
+         }
+      }
+
+      /**
+       * @brief The arena the referenced clauses are stored in
+       *
+       */
+      ClauseArena* arena;
+
+      /**
+       * @brief The current position in the sequence of references
+       *
+       */
+      const ClauseRef* position;
+
+      /**
+       * @brief The end of the sequence of references
+       *
+       */
+      const ClauseRef* last;
+
+   };
+
+}
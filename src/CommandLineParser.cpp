@@ -14,6 +14,8 @@
 
 #include <sstream>
 #include <argp.h>
+#include <thread>
+#include <algorithm>
 
 namespace preppy::util {
 
@@ -23,7 +25,13 @@ namespace preppy::util {
       argp_program_version_hook = CommandLineParser::printVersion;
       CommandLineParser::args.logLevel = log::LOG_LEVEL::WARNING;
       CommandLineParser::args.force = false;
+      CommandLineParser::args.binary = false;
+      CommandLineParser::args.normalize = false;
+      CommandLineParser::args.probing = false;
+      CommandLineParser::args.hyperBinary = false;
       CommandLineParser::args.iterations = 10;
+      CommandLineParser::args.threads = 1;
+      CommandLineParser::args.solver = "clasp";
    }
 
    void CommandLineParser::parse(int argc, char **argv) {
@@ -34,7 +42,7 @@ namespace preppy::util {
          exit(e);
       }
 
-      if (!util::Utility::fileExists(CommandLineParser::args.fileIn)) {
+      if ("-" != CommandLineParser::args.fileIn && !util::Utility::fileExists(CommandLineParser::args.fileIn)) {
          //input file does not exist
          std::cout << "Input file '" << args.fileIn << "' does not exist." << std::endl;
          exit(1);
@@ -64,6 +72,25 @@ namespace preppy::util {
       case 'f':      // --force
          arguments->force = true;
          break;
+      case 'b':      // --binary
+         arguments->binary = true;
+         break;
+      case 'n':      // --normalize
+         arguments->normalize = true;
+         break;
+      case 'p':      // --probing
+         arguments->probing = true;
+         break;
+      case 'r':      // --hyper-binary
+         arguments->hyperBinary = true;
+         break;
+      case 's':      // --solver <NAME>
+         if (std::string("clasp") != arg && std::string("cdcl") != arg) {
+            std::cout << "Solver has to be clasp or cdcl" << std::endl;
+            return 1;
+         }
+         arguments->solver = arg;
+         break;
       case 'i':      // --iterations <n>
       {
          std::istringstream ss(arg);
@@ -76,6 +103,18 @@ namespace preppy::util {
          arguments->iterations = static_cast<unsigned>(n);
          break;
       }
+      case 't':      // --threads <n>
+      {
+         std::istringstream ss(arg);
+         int n;
+         ss >> n;
+         if (!ss.eof() || ss.fail() || n < 0) {
+            std::cout << "Threads has to be an integer >= 0" << std::endl;
+            return 1;
+         }
+         arguments->threads = (0 == n) ? std::max(1u, std::thread::hardware_concurrency()) : static_cast<unsigned>(n);
+         break;
+      }
       case ARGP_KEY_ARG:
          if (state->arg_num >= 1) {
             argp_usage(state);
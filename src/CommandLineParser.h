@@ -24,9 +24,15 @@ namespace preppy::util {
    struct Arguments {
       std::string fileIn;
       std::string fileOut;
+      std::string solver;
       log::LOG_LEVEL logLevel;
       unsigned iterations;
+      unsigned threads;
       bool force;
+      bool binary;
+      bool normalize;
+      bool probing;
+      bool hyperBinary;
    };
 
    /**
@@ -93,18 +99,24 @@ namespace preppy::util {
        * @brief Description of program arguments
        * 
        */
-      const char *argsDoc = "<INPUT FILE>";
+      const char *argsDoc = "<INPUT FILE or ->";
 
       /**
        * @brief Description of the available options for this program
        * 
        */
-      const argp_option options[6] = {
+      const argp_option options[12] = {
          {"verbose",       'v', "<LOG_LEVEL>",        0, "Set log level of the application, 0 = NOTHING, 1 = ERROR, 2 = WARNING (default), 3 = INFO, 4 = DEBUG"},
          {"logging",       'l', 0,                    OPTION_ALIAS},
-         {"output",        'o', "<FILE/DIRECTORY>",   0, "Set a output file or directory. If a directory is set the output file name will be <inputfilestem>out.cnf"},
+         {"output",        'o', "<FILE/DIRECTORY>",   0, "Set a output file or directory, - for the standard output. If a directory is set the output file name will be <inputfilestem>out.cnf"},
          {"force",         'f', 0,                    0, "Override output files if they already exist"},
          {"iterations",    'i', "<n>",                0, "How many iterations to use iterative procedures (default: 10)"},
+         {"binary",        'b', 0,                    0, "Write the output in preppy's binary cnf format, also used for output files ending in .pcnf"},
+         {"solver",        's', "<NAME>",             0, "The SAT solver to use, clasp (default) or the built in cdcl"},
+         {"threads",       't', "<n>",                0, "How many threads to use for reading and writing cnf files (default: 1, 0 = one per core)"},
+         {"normalize",     'n', 0,                    0, "Sort the literals of every clause and remove duplicate literals while reading the cnf file"},
+         {"probing",       'p', 0,                    0, "Apply Failed Literal Probing before the other procedures"},
+         {"hyper-binary",  'r', 0,                    0, "Apply Hyper Binary Resolution and Transitive Reduction in every iteration"},
          { 0 }
       };
       
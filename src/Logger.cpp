@@ -20,8 +20,9 @@
 
 namespace preppy::log {
 
-    Logger::Logger(const LOG_LEVEL logLevel)
-        : logLevel(logLevel) {
+    Logger::Logger(const LOG_LEVEL logLevel, std::ostream& stream)
+        : logLevel(logLevel)
+        , stream(stream) {
         this->start = util::clock::now();
         
         this->logDebug("Logger created at " + util::Utility::getDateTime() + " with logging level \"" + logLevelToString(logLevel) + "\"");
@@ -86,8 +87,8 @@ namespace preppy::log {
             outputss << line << std::endl;
         }
 
-        // write everything to cout
-        std::cout << outputss.str() << std::flush;
+        // write everything to the log stream
+        this->stream << outputss.str() << std::flush;
     }
 
     void Logger::log(const std::string& message, const LOG_LEVEL logLevel) {
@@ -107,8 +108,8 @@ namespace preppy::log {
                 outputss << line << std::endl;
             }
 
-            // write everything to cout
-            std::cout << outputss.str() << std::flush;
+            // write everything to the log stream
+            this->stream << outputss.str() << std::flush;
         }
     }
 
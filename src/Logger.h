@@ -32,8 +32,9 @@ namespace preppy::log {
          * @brief Construct a new Logger
          * 
          * @param logLevel The logging level for the logger to use. Everything with a logging level lower than this will not be logged
+         * @param stream The stream to write the log to
          */
-        Logger(LOG_LEVEL logLevel);
+        Logger(LOG_LEVEL logLevel, std::ostream& stream = std::cout);
 
         /**
          * @brief Destroy the Logger object
@@ -136,6 +137,12 @@ namespace preppy::log {
          */
         LOG_LEVEL logLevel;
 
+        /**
+         * @brief The stream the log is written to
+         * 
+         */
+        std::ostream& stream;
+
         /**
          * @brief Mutex that is locked while writing logs for thread safety
          * 
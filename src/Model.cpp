@@ -10,8 +10,12 @@
  */
 
 #include "Model.h"
+#include "CNF.h"
 #include "Utility.h"
 
+#include <algorithm>
+#include <fstream>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -19,6 +23,10 @@ namespace preppy::cnf {
 
    Model::Model() = default;
 
+   Model::Model(const std::size_t size) {
+      this->resize(size);
+   }
+
    bool Model::readFromFile(const std::string& filepath) {
       if (!util::Utility::fileExists(filepath)) {
          util::Utility::logError("File ", filepath, " doesn't exist");
@@ -38,8 +46,8 @@ namespace preppy::cnf {
       util::Utility::logDebug("Reading model");
 
       std::string line;
-      // variable 0 doesn't exist ->
-      this->push_back(false);
+      // variable 0 doesn't exist, but a model that was read is never empty
+      this->resize(std::max<std::size_t>(this->size(), 1));
 
       while (!input.eof()) {
          std::getline(input, line);
@@ -49,16 +57,11 @@ namespace preppy::cnf {
          if ('v' == linetype) {      // variable lines will have a v at the beginning
             int literal;
             while (ss >> literal) {
-               if (literal > 0) {
-                  this->push_back(true);
-               }
-               else if (literal < 0) {
-                  this->push_back(false);
-               }
-               else {
-                  // 0 is at the end of the modelgi
+               if (0 == literal) {
+                  // 0 is at the end of the model
                   break;
                }
+               this->assign(static_cast<std::size_t>(std::abs(literal)), literal > 0);
             }
          }
       }
@@ -66,9 +69,9 @@ namespace preppy::cnf {
       return true;
    }
 
-   std::string Model::toString() {
+   std::string Model::toString() const {
       std::ostringstream ss;
-      for (size_t i = 1; i < this->size(); ++i) {
+      for (std::size_t i = this->nextAssigned(1); i < this->size(); i = this->nextAssigned(i + 1)) {
          ss << ((*this)[i] ? "" : "-")    // - if literal is negative
             << i << " ";
       }
@@ -76,4 +79,130 @@ namespace preppy::cnf {
       return ss.str();
    }
 
+   void Model::resize(const std::size_t size) {
+      const std::size_t words = (size + WORD_BITS - 1) / WORD_BITS;
+      this->values.resize(words, 0);
+      this->assigned.resize(words, 0);
+      if (size < this->variables && 0 != size % WORD_BITS) {
+         // the bits behind the last variable stay zero, so whole words can be compared
+         const Word mask = (Word(1) << (size % WORD_BITS)) - 1;
+         this->values.back() &= mask;
+         this->assigned.back() &= mask;
+      }
+      this->variables = size;
+   }
+
+   void Model::reserve(const std::size_t size) {
+      const std::size_t words = (size + WORD_BITS - 1) / WORD_BITS;
+      this->values.reserve(words);
+      this->assigned.reserve(words);
+   }
+
+   void Model::clear() {
+      this->values.clear();
+      this->assigned.clear();
+      this->variables = 0;
+   }
+
+   void Model::swap(Model& other) {
+      this->values.swap(other.values);
+      this->assigned.swap(other.assigned);
+      std::swap(this->variables, other.variables);
+   }
+
+   void Model::assign(const std::size_t variable, const bool value) {
+      if (variable >= this->variables) {
+         this->resize(variable + 1);
+      }
+      const Word bit = Word(1) << (variable % WORD_BITS);
+      const std::size_t word = variable / WORD_BITS;
+      this->assigned[word] |= bit;
+      this->values[word] = value ? (this->values[word] | bit) : (this->values[word] & ~bit);
+   }
+
+   void Model::unassign(const std::size_t variable) {
+      if (variable >= this->variables) {
+         return;
+      }
+      const Word bit = Word(1) << (variable % WORD_BITS);
+      this->assigned[variable / WORD_BITS] &= ~bit;
+      this->values[variable / WORD_BITS] &= ~bit;
+   }
+
+   std::size_t Model::countAssigned() const {
+      std::size_t count = 0;
+      for (const Word word : this->assigned) {
+         count += static_cast<std::size_t>(__builtin_popcountll(word));
+      }
+      return count;
+   }
+
+   std::size_t Model::nextAssigned(const std::size_t variable) const {
+      if (variable >= this->variables) {
+         return this->variables;
+      }
+      std::size_t word = variable / WORD_BITS;
+      Word bits = this->assigned[word] & (~Word(0) << (variable % WORD_BITS));
+      while (0 == bits) {
+         if (++word == this->assigned.size()) {
+            return this->variables;
+         }
+         bits = this->assigned[word];
+      }
+      return word * WORD_BITS + static_cast<std::size_t>(__builtin_ctzll(bits));
+   }
+
+   void Model::intersect(const Model& other) {
+      const std::size_t words = std::min(this->assigned.size(), other.assigned.size());
+      for (std::size_t i = 0; i < words; ++i) {
+         this->assigned[i] &= other.assigned[i] & ~(this->values[i] ^ other.values[i]);
+         this->values[i] &= this->assigned[i];
+      }
+      std::fill(this->assigned.begin() + words, this->assigned.end(), 0);
+      std::fill(this->values.begin() + words, this->values.end(), 0);
+   }
+
+   void Model::difference(const Model& other) {
+      const std::size_t words = std::min(this->assigned.size(), other.assigned.size());
+      for (std::size_t i = 0; i < words; ++i) {
+         this->assigned[i] &= other.assigned[i] & (this->values[i] ^ other.values[i]);
+         this->values[i] &= this->assigned[i];
+      }
+      std::fill(this->assigned.begin() + words, this->assigned.end(), 0);
+      std::fill(this->values.begin() + words, this->values.end(), 0);
+   }
+
+   void Model::renameVariables(const std::vector<unsigned>& newNames) {
+      std::size_t size = std::min<std::size_t>(this->variables, 1);
+      for (std::size_t variable = this->nextAssigned(1); variable < this->variables; variable = this->nextAssigned(variable + 1)) {
+         const std::size_t newName = (variable < newNames.size()) ? newNames[variable] : variable;
+         if (0 != newName) {
+            size = std::max(size, newName + 1);
+         }
+      }
+
+      Model renamed(size);
+      for (std::size_t variable = this->nextAssigned(1); variable < this->variables; variable = this->nextAssigned(variable + 1)) {
+         const std::size_t newName = (variable < newNames.size()) ? newNames[variable] : variable;
+         if (0 != newName) {
+            renamed.assign(newName, (*this)[variable]);
+         }
+      }
+      this->swap(renamed);
+   }
+
+   bool Model::satisfies(const cnf::CNF& formula) const {
+      for (const auto& clause : formula) {
+         // no early exit inside the clause, so the loop over the literals doesn't branch
+         bool satisfied = false;
+         for (const int literal : clause) {
+            satisfied |= this->isTrue(literal);
+         }
+         if (!satisfied) {
+            return false;
+         }
+      }
+      return true;
+   }
+
 }
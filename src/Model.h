@@ -11,25 +11,50 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <istream>
 #include <string>
 #include <vector>
 
 namespace preppy::cnf {
 
+   class CNF;
+
    /**
-    * @brief A model for a cnf formula, mapping variables to either true or false
-    * TODO: Don't inherit from std::vector
+    * @brief A (partial) model for a cnf formula, mapping variables to either true, false or unassigned. The values and
+    * whether a variable is assigned are stored as bits in 64 bit words, so models can be compared a word at a time
+    * 
     */
-   class Model
-      : public std::vector<bool> {
+   class Model {
    public:
 
       /**
-       * @brief Construct a new Model object
+       * @brief The type of the words holding the bits of 64 variables
+       * 
+       */
+      typedef std::uint64_t Word;
+
+      /**
+       * @brief Number of variables per word
+       * 
+       */
+      static constexpr std::size_t WORD_BITS = 64;
+
+      /**
+       * @brief Construct a new, empty Model object
        * 
        */
       Model();
 
+      /**
+       * @brief Construct a Model for the variables [0, size), all unassigned
+       * 
+       * @param size The number of variables, including the unused variable 0
+       */
+      explicit Model(std::size_t size);
+
       /**
        * @brief Reads a model from a given file
        * 
@@ -49,15 +74,174 @@ namespace preppy::cnf {
       /**
        * @brief Converts the model to a string
        * 
-       * @return std::string The string containing the model
+       * @return std::string The string containing the assigned literals of the model
+       */
+      std::string toString() const;
+
+      /**
+       * @brief Get the number of variables the model has room for, including the unused variable 0
+       * 
+       * @return std::size_t The size of the model
+       */
+      inline std::size_t size() const {
+         return this->variables;
+      }
+
+      /**
+       * @brief Checks whether the model is empty, i.e. no model was found
+       * 
+       * @return bool True if the model has no variables
        */
-      std::string toString();
+      inline bool empty() const {
+         return 0 == this->variables;
+      }
+
+      /**
+       * @brief Changes the number of variables, added variables are unassigned
+       * 
+       * @param size The new number of variables
+       */
+      void resize(std::size_t size);
+
+      /**
+       * @brief Reserves room for a number of variables
+       * 
+       * @param size The number of variables
+       */
+      void reserve(std::size_t size);
+
+      /**
+       * @brief Removes all variables
+       * 
+       */
+      void clear();
+
+      /**
+       * @brief Swaps the content with another model
+       * 
+       * @param other The other model
+       */
+      void swap(Model& other);
+
+      /**
+       * @brief Get the value of a variable
+       * 
+       * @param variable The variable, has to be smaller than size()
+       * @return bool The value of the variable, false if it is unassigned
+       */
+      inline bool operator[](const std::size_t variable) const {
+         return 0 != ((this->values[variable / WORD_BITS] >> (variable % WORD_BITS)) & 1);
+      }
+
+      /**
+       * @brief Checks whether a variable is assigned
+       * 
+       * @param variable The variable
+       * @return bool True if the variable is part of the model and assigned
+       */
+      inline bool isAssigned(const std::size_t variable) const {
+         return variable < this->variables && 0 != ((this->assigned[variable / WORD_BITS] >> (variable % WORD_BITS)) & 1);
+      }
+
+      /**
+       * @brief Checks whether the model sets a literal to true, without branching on the sign of the literal
+       * 
+       * @param literal The literal
+       * @return bool True if the variable of the literal is assigned the value satisfying the literal
+       */
+      inline bool isTrue(const int literal) const {
+         const std::size_t variable = static_cast<std::size_t>(std::abs(literal));
+         if (variable >= this->variables) {
+            return false;
+         }
+         const Word flip = (literal < 0) ? ~Word(0) : Word(0);
+         const std::size_t word = variable / WORD_BITS;
+         return 0 != (((this->values[word] ^ flip) & this->assigned[word]) >> (variable % WORD_BITS) & 1);
+      }
+
+      /**
+       * @brief Assigns a value to a variable, growing the model if needed
+       * 
+       * @param variable The variable
+       * @param value The value
+       */
+      void assign(std::size_t variable, bool value);
+
+      /**
+       * @brief Removes the value of a variable
+       * 
+       * @param variable The variable
+       */
+      void unassign(std::size_t variable);
+
+      /**
+       * @brief Get the number of assigned variables
+       * 
+       * @return std::size_t The number of assigned variables
+       */
+      std::size_t countAssigned() const;
+
+      /**
+       * @brief Get the first assigned variable starting at a given variable
+       * 
+       * @param variable The variable to start searching at
+       * @return std::size_t The next assigned variable, size() if there is none
+       */
+      std::size_t nextAssigned(std::size_t variable) const;
+
+      /**
+       * @brief Keeps only the variables that are assigned the same value in other, a word at a time
+       * 
+       * @param other The other model
+       */
+      void intersect(const Model& other);
+
+      /**
+       * @brief Keeps only the variables that are assigned the opposite value in other, a word at a time
+       * 
+       * @param other The other model
+       */
+      void difference(const Model& other);
+
+      /**
+       * @brief Renames all variables at once, e.g. with the compression tables of a formula
+       * 
+       * @param newNames The new name of every variable, indexed by the current name. Variables renamed to 0 are
+       * dropped, variables behind its end keep their name
+       */
+      void renameVariables(const std::vector<unsigned>& newNames);
+
+      /**
+       * @brief Checks whether the model satisfies every clause of a formula, in one pass over the literals
+       * 
+       * @param formula The formula
+       * @return bool True if every clause has a literal the model sets to true
+       */
+      bool satisfies(const cnf::CNF& formula) const;
 
    protected:
 
 
    private:
 
+      /**
+       * @brief The values of the variables, a bit per variable
+       * 
+       */
+      std::vector<Word> values;
+
+      /**
+       * @brief Whether the variables are assigned, a bit per variable. Unassigned variables have the value false
+       * 
+       */
+      std::vector<Word> assigned;
+
+      /**
+       * @brief The number of variables, including the unused variable 0
+       * 
+       */
+      std::size_t variables = 0;
+
    };
 
 }
@@ -0,0 +1,121 @@
+/**
+ * @file OccurrenceLists.cpp
+ * @author Anton Reinhard
+ * @brief Occurrence lists implementation
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "OccurrenceLists.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace preppy::cnf {
+
+   void OccurrenceLists::add(const ClauseRef clause, const int* first, const int* last) {
+      for (const int* literal = first; literal != last; ++literal) {
+         if (!isFirstOccurrence(first, literal)) {
+            continue;
+         }
+         const std::size_t index = this->reserveLiteral(*literal);
+         this->lists[index].push_back(clause);
+         ++this->counts[index];
+         ++this->entries;
+      }
+   }
+
+   void OccurrenceLists::removeLiteral(const ClauseRef clause, const int literal) {
+      const std::size_t index = literalIndex(literal);
+      if (index >= this->lists.size()) {
+         return;
+      }
+
+      // the clause was most likely added recently, so search from the back
+      auto& list = this->lists[index];
+      const auto position = std::find(list.rbegin(), list.rend(), clause);
+      if (position != list.rend()) {
+         list.erase(std::next(position).base());
+         --this->counts[index];
+         --this->entries;
+      }
+   }
+
+   void OccurrenceLists::restore(const ClauseRef clause, const int* first, const int* last) {
+      for (const int* literal = first; literal != last; ++literal) {
+         if (!isFirstOccurrence(first, literal)) {
+            continue;
+         }
+         const std::size_t index = this->reserveLiteral(*literal);
+         auto& list = this->lists[index];
+         ++this->counts[index];
+         // the clause was most likely removed recently, so search from the back
+         if (std::find(list.rbegin(), list.rend(), clause) != list.rend()) {
+            this->stale -= std::min<std::size_t>(this->stale, 1);
+         }
+         else {
+            list.push_back(clause);
+            ++this->entries;
+         }
+      }
+   }
+
+   void OccurrenceLists::addLiteral(const ClauseRef clause, const int literal) {
+      const std::size_t index = this->reserveLiteral(literal);
+      this->lists[index].push_back(clause);
+      ++this->counts[index];
+      ++this->entries;
+   }
+
+   void OccurrenceLists::renameVariable(const unsigned variable, const unsigned newName) {
+      if (variable == newName) {
+         return;
+      }
+
+      for (const int sign : {1, -1}) {
+         const std::size_t from = literalIndex(sign * static_cast<int>(variable));
+         if (from >= this->lists.size()) {
+            continue;
+         }
+         const std::size_t to = this->reserveLiteral(sign * static_cast<int>(newName));
+
+         auto& source = this->lists[from];
+         auto& target = this->lists[to];
+         if (target.empty()) {
+            target.swap(source);
+         }
+         else {
+            target.insert(target.end(), source.begin(), source.end());
+            source.clear();
+         }
+         this->counts[to] += this->counts[from];
+         this->counts[from] = 0;
+      }
+   }
+
+   void OccurrenceLists::clear(const unsigned maxVariable) {
+      for (auto& list : this->lists) {
+         list.clear();
+      }
+      std::fill(this->counts.begin(), this->counts.end(), 0);
+      if (this->lists.size() < 2 * static_cast<std::size_t>(maxVariable) + 2) {
+         this->lists.resize(2 * static_cast<std::size_t>(maxVariable) + 2);
+         this->counts.resize(this->lists.size(), 0);
+      }
+      this->entries = 0;
+      this->stale = 0;
+   }
+
+   std::size_t OccurrenceLists::reserveLiteral(const int literal) {
+      const std::size_t index = literalIndex(literal);
+      if (index >= this->lists.size()) {
+         this->lists.resize(index + 2);
+         this->counts.resize(index + 2, 0);
+      }
+      return index;
+   }
+
+}
@@ -0,0 +1,207 @@
+/**
+ * @file OccurrenceLists.h
+ * @author Anton Reinhard
+ * @brief Occurrence lists header
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include "definitions.h"
+
+#include <vector>
+#include <cstddef>
+
+namespace preppy::cnf {
+
+   /**
+    * @brief For every literal the clauses it occurs in and the number of those clauses, indexed by literalIndex()
+    *
+    * @details A clause is listed once per distinct literal. The counters are always exact, but removing a whole clause
+    * leaves its entries in the lists until enough of them are stale to sweep all lists, so users of the lists have
+    * to skip removed clauses.
+    */
+   class OccurrenceLists {
+   public:
+
+      /**
+       * @brief Construct empty occurrence lists
+       *
+       */
+      OccurrenceLists() = default;
+
+      /**
+       * @brief Adds a clause to the lists of its literals
+       *
+       * @param clause The reference of the clause
+       * @param first The first literal of the clause
+       * @param last Behind the last literal of the clause
+       */
+      void add(ClauseRef clause, const int* first, const int* last);
+
+      /**
+       * @brief Removes a clause, only its counters are updated right away
+       *
+       * @param first The first literal of the clause
+       * @param last Behind the last literal of the clause
+       * @param isRemoved Returns true for the reference of every removed clause, used when the lists are swept
+       */
+      template<typename Predicate>
+      void remove(const int* first, const int* last, Predicate isRemoved) {
+         for (const int* literal = first; literal != last; ++literal) {
+            if (isFirstOccurrence(first, literal)) {
+               --this->counts[literalIndex(*literal)];
+               ++this->stale;
+            }
+         }
+         if (2 * this->stale > this->entries) {
+            this->cleanup(isRemoved);
+         }
+      }
+
+      /**
+       * @brief Removes a clause from the list of a single literal, e.g. after the literal was erased from the clause
+       *
+       * @param clause The reference of the clause
+       * @param literal The literal that doesn't occur in the clause anymore
+       */
+      void removeLiteral(ClauseRef clause, int literal);
+
+      /**
+       * @brief Adds a removed clause back, reusing the entries that were not swept by cleanup() yet
+       *
+       * @param clause The reference of the clause
+       * @param first Pointer to the first literal of the clause
+       * @param last Pointer behind the last literal of the clause
+       */
+      void restore(ClauseRef clause, const int* first, const int* last);
+
+      /**
+       * @brief Adds a clause to the list of a single literal, e.g. after an erased literal was given back to the clause
+       *
+       * @param clause The reference of the clause
+       * @param literal The literal that occurs in the clause again
+       */
+      void addLiteral(ClauseRef clause, int literal);
+
+      /**
+       * @brief Moves the occurrences of a variable to another variable, after it was renamed in all its clauses
+       *
+       * @param variable The old name of the variable
+       * @param newName The new name of the variable
+       */
+      void renameVariable(unsigned variable, unsigned newName);
+
+      /**
+       * @brief Removes the entries of all removed clauses from the lists
+       *
+       * @param isRemoved Returns true for the reference of every removed clause
+       */
+      template<typename Predicate>
+      void cleanup(Predicate isRemoved) {
+         this->entries = 0;
+         for (auto& list : this->lists) {
+            auto kept = list.begin();
+            for (const ClauseRef clause : list) {
+               if (!isRemoved(clause)) {
+                  *kept++ = clause;
+               }
+            }
+            list.erase(kept, list.end());
+            this->entries += list.size();
+         }
+         this->stale = 0;
+      }
+
+      /**
+       * @brief Removes all clauses and makes room for the literals of the given number of variables
+       *
+       * @param maxVariable The maximum variable that will occur
+       */
+      void clear(unsigned maxVariable = 0);
+
+      /**
+       * @brief Get the clauses a literal occurs in, may contain removed clauses
+       *
+       * @param literal The literal
+       * @return const std::vector<ClauseRef>& The clauses containing the literal
+       */
+      inline const std::vector<ClauseRef>& operator[](const int literal) const {
+         const std::size_t index = literalIndex(literal);
+         return index < this->lists.size() ? this->lists[index] : this->none;
+      }
+
+      /**
+       * @brief Get the number of clauses a literal occurs in
+       *
+       * @param literal The literal
+       * @return unsigned The number of clauses
+       */
+      inline unsigned count(const int literal) const {
+         const std::size_t index = literalIndex(literal);
+         return index < this->counts.size() ? this->counts[index] : 0;
+      }
+
+   private:
+
+      /**
+       * @brief Checks whether a literal occurs in a clause for the first time at the given position
+       *
+       * @param first The first literal of the clause
+       * @param literal The position to check
+       * @return bool True if the literal doesn't occur in [first, literal)
+       */
+      static inline bool isFirstOccurrence(const int* first, const int* literal) {
+         for (const int* previous = first; previous != literal; ++previous) {
+            if (*previous == *literal) {
+               return false;
+            }
+         }
+         return true;
+      }
+
+      /**
+       * @brief Makes sure the lists and counters cover the given literal
+       *
+       * @param literal The literal
+       * @return std::size_t The index of the literal
+       */
+      std::size_t reserveLiteral(int literal);
+
+      /**
+       * @brief The clauses of every literal
+       *
+       */
+      std::vector<std::vector<ClauseRef>> lists;
+
+      /**
+       * @brief The number of clauses every literal occurs in
+       *
+       */
+      std::vector<unsigned> counts;
+
+      /**
+       * @brief The number of entries in all lists, including the ones of removed clauses
+       *
+       */
+      std::size_t entries = 0;
+
+      /**
+       * @brief The number of entries belonging to removed clauses since the last cleanup
+       *
+       */
+      std::size_t stale = 0;
+
+      /**
+       * @brief Returned for literals that are not covered by the lists
+       *
+       */
+      std::vector<ClauseRef> none;
+
+   };
+
+}
@@ -0,0 +1,257 @@
+/**
+ * @file Propagator.cpp
+ * @author Anton Reinhard
+ * @brief Unit propagation implementation
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "Propagator.h"
+#include "CNF.h"
+
+#include <algorithm>
+
+namespace preppy::cnf {
+
+   Propagator::Propagator(cnf::CNF& formula) {
+      this->bind(formula);
+   }
+
+   void Propagator::bind(cnf::CNF& formula) {
+      this->formula = &formula;
+      this->implications = &formula.getBinaryImplications();
+
+      const std::size_t variables = static_cast<std::size_t>(formula.getMaxVariable()) + 1;
+      this->values.assign(variables, 0);
+      this->levels.assign(variables, 0);
+      this->reasons.assign(variables, NO_CLAUSE);
+      this->trail.clear();
+      this->levelStarts.clear();
+      this->propagated = 0;
+      this->propagations = 0;
+      this->conflict = NO_CLAUSE;
+
+      // the lists keep their memory, so binding again and again doesn't allocate
+      this->watched.clear();
+      this->watches.clear(formula.getMaxVariable());
+
+      for (const auto& clause : formula) {
+         this->watchClause(clause.getRef());
+      }
+   }
+
+   void Propagator::watchClause(const ClauseRef clause) {
+      const ClauseView view = this->formula->getClause(clause);
+      // look for two different literals that aren't false, duplicates don't count
+      int first = 0;
+      int second = 0;
+      int falsified = 0;
+      for (const int literal : view) {
+         if (0 == literal) {
+            continue;
+         }
+         if (LITERAL_VALUE::FALSE == this->getValue(literal)) {
+            falsified = literal;
+         }
+         else if (0 == first) {
+            first = literal;
+         }
+         else if (literal != first) {
+            second = literal;
+            break;
+         }
+      }
+
+      if (0 == first) {
+         // every literal is false or the clause has none left, see ClauseView::setLiteral()
+         this->conflict = clause;
+         return;
+      }
+      if (0 == second) {
+         // the clause is unit, the false literal stays false as long as the assignment of the unit
+         this->assign(first, clause);
+         second = falsified;
+      }
+      if (0 != second && view.size() > 2) {
+         // binary clauses are part of the implication graph
+         if (clause >= this->watched.size()) {
+            this->watched.resize(clause + 1, {0, 0});
+         }
+         this->watched[clause] = {first, second};
+         this->watches.watch(first, clause, second);
+         this->watches.watch(second, clause, first);
+      }
+   }
+
+   void Propagator::unwatchClause(const ClauseRef clause) {
+      if (clause >= this->watched.size() || 0 == this->watched[clause][0]) {
+         return;
+      }
+      for (const int literal : this->watched[clause]) {
+         this->watches.unwatch(literal, clause);
+      }
+      this->watched[clause] = {0, 0};
+   }
+
+   bool Propagator::assign(const int literal, const ClauseRef reason) {
+      const LITERAL_VALUE value = this->getValue(literal);
+      if (LITERAL_VALUE::UNASSIGNED != value) {
+         return LITERAL_VALUE::TRUE == value;
+      }
+      const std::size_t variable = static_cast<std::size_t>(std::abs(literal));
+      if (variable >= this->values.size()) {
+         this->values.resize(variable + 1, 0);
+         this->levels.resize(variable + 1, 0);
+         this->reasons.resize(variable + 1, NO_CLAUSE);
+      }
+      this->values[variable] = (literal < 0) ? -1 : 1;
+      this->levels[variable] = this->getLevel();
+      this->reasons[variable] = reason;
+      this->trail.push_back(literal);
+      return true;
+   }
+
+   bool Propagator::assume(const int literal) {
+      this->levelStarts.push_back(this->trail.size());
+      return this->assign(literal);
+   }
+
+   ClauseRef Propagator::propagate() {
+      if (NO_CLAUSE != this->conflict) {
+         return this->conflict;
+      }
+
+      ClauseRef falsified = NO_CLAUSE;
+      while (NO_CLAUSE == falsified && this->propagated < this->trail.size()) {
+         const int literal = this->trail[this->propagated++];
+         ++this->propagations;
+         falsified = this->visitImplications(literal);
+         if (NO_CLAUSE == falsified) {
+            falsified = this->visitWatches(-literal);
+         }
+      }
+      if (NO_CLAUSE != falsified && 0 == this->getLevel()) {
+         // nothing can be taken back anymore
+         this->conflict = falsified;
+      }
+      return falsified;
+   }
+
+   ClauseRef Propagator::visitImplications(const int literal) {
+      // the shared implications might belong to clauses that were removed since
+      for (const Implication& implication : this->implications->getShared(literal)) {
+         if (!this->formula->isRemoved(implication.clause) && !this->assign(implication.literal, implication.clause)) {
+            return implication.clause;
+         }
+      }
+      for (const Implication& implication : (*this->implications)[literal]) {
+         if (!this->assign(implication.literal, implication.clause)) {
+            return implication.clause;
+         }
+      }
+      return NO_CLAUSE;
+   }
+
+   ClauseRef Propagator::visitWatches(const int falsified) {
+      // every variable of the formula is covered, so moving watches to other lists doesn't move this one
+      std::vector<Watch>& list = this->watches[falsified];
+
+      // the watches that stay are moved to the front of the list
+      std::size_t kept = 0;
+      for (std::size_t i = 0; i < list.size(); ++i) {
+         const Watch watch = list[i];
+         if (LITERAL_VALUE::TRUE == this->getValue(watch.blocker)) {
+            list[kept++] = watch;
+            continue;
+         }
+         if (this->formula->isRemoved(watch.clause)) {
+            // the watches of removed clauses are counted until the lists are swept, see removeClause()
+            list[kept++] = watch;
+            continue;
+         }
+
+         // keep the other watched literal in front
+         std::array<int, 2>& pair = this->watched[watch.clause];
+         if (pair[0] == falsified) {
+            std::swap(pair[0], pair[1]);
+         }
+         const int other = pair[0];
+         if (other != watch.blocker && LITERAL_VALUE::TRUE == this->getValue(other)) {
+            list[kept++] = {watch.clause, other};
+            continue;
+         }
+
+         // move the watch to a literal that isn't false
+         bool moved = false;
+         for (const int literal : this->formula->getClause(watch.clause)) {
+            if (literal != other && literal != falsified && LITERAL_VALUE::FALSE != this->getValue(literal)) {
+               pair[1] = literal;
+               this->watches[literal].push_back({watch.clause, other});
+               moved = true;
+               break;
+            }
+         }
+         if (moved) {
+            continue;
+         }
+
+         // every other literal is false, so the clause is unit or falsified
+         list[kept++] = watch;
+         if (!this->assign(other, watch.clause)) {
+            std::copy(list.begin() + i + 1, list.end(), list.begin() + kept);
+            list.resize(kept + list.size() - i - 1);
+            return watch.clause;
+         }
+      }
+      list.resize(kept);
+      return NO_CLAUSE;
+   }
+
+   void Propagator::backtrack(const unsigned level) {
+      if (level >= this->getLevel()) {
+         return;
+      }
+      const std::size_t start = this->levelStarts[level];
+      for (std::size_t i = start; i < this->trail.size(); ++i) {
+         this->values[static_cast<std::size_t>(std::abs(this->trail[i]))] = 0;
+      }
+      this->trail.resize(start);
+      this->levelStarts.resize(level);
+      this->propagated = std::min(this->propagated, start);
+   }
+
+   void Propagator::addClause(const ClauseRef clause) {
+      // the clause might bring new variables, whose watch lists have to exist before any watch is moved there
+      this->watches.reserve(this->formula->getMaxVariable());
+      this->watchClause(clause);
+   }
+
+   void Propagator::removeClause(const ClauseRef clause) {
+      // only what the clause implied has to be taken back
+      bool implied = NO_CLAUSE != this->conflict;
+      for (const int literal : this->formula->getClause(clause)) {
+         const std::size_t variable = static_cast<std::size_t>(std::abs(literal));
+         if (variable < this->values.size() && 0 != this->values[variable] && clause == this->reasons[variable]) {
+            implied = true;
+            break;
+         }
+      }
+      if (implied) {
+         this->bind(*this->formula);
+      }
+      else if (clause < this->watched.size() && 0 != this->watched[clause][0]) {
+         this->watches.remove(2, [this](const ClauseRef ref) {
+            return this->formula->isRemoved(ref);
+         });
+      }
+   }
+
+   void Propagator::eraseLiteral(const ClauseRef clause) {
+      this->unwatchClause(clause);
+      this->watchClause(clause);
+   }
+
+}
@@ -0,0 +1,310 @@
+/**
+ * @file Propagator.h
+ * @author Anton Reinhard
+ * @brief Unit propagation header
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include "definitions.h"
+#include "WatchLists.h"
+#include "BinaryImplications.h"
+
+#include <array>
+#include <vector>
+#include <limits>
+#include <cstddef>
+#include <cstdlib>
+
+namespace preppy::cnf {
+
+   class CNF;
+
+   /**
+    * @brief The value of a literal under the assignment of a Propagator
+    *
+    */
+   enum class LITERAL_VALUE : signed char {
+      FALSE = -1,
+      UNASSIGNED = 0,
+      TRUE = 1
+   };
+
+   /**
+    * @brief Unit propagation on the clauses of a formula with two watched literals per clause
+    *
+    * @details The binary clauses are propagated over the implication graph of the formula. Every longer clause is
+    * watched by two of its literals in the WatchLists of the propagator, so the literals of the clauses are never
+    * reordered. When a watched literal becomes false the clause looks for another literal that isn't false and moves
+    * the watch there, a blocker literal that is true skips the clause without looking at it. Assignments are stored per
+    * variable together with their decision level and the clause that implied them, in the order they were made on the
+    * trail.
+    *
+    * The propagator stays bound across any number of assume(), propagate() and backtrack() calls. Changes of the
+    * formula are reported on decision level 0 with addClause(), removeClause() and eraseLiteral(), which keeps the
+    * watches valid without looking at the other clauses. Any other change of the formula requires bind() again.
+    */
+   class Propagator {
+   public:
+
+      /**
+       * @brief Reason of decisions and conflict returned if there is none
+       *
+       */
+      static constexpr ClauseRef NO_CLAUSE = std::numeric_limits<ClauseRef>::max();
+
+      /**
+       * @brief Construct a propagator without a formula, see bind()
+       *
+       */
+      Propagator() = default;
+
+      /**
+       * @brief Construct a propagator for a formula, see bind()
+       *
+       * @param formula The formula
+       */
+      explicit Propagator(cnf::CNF& formula);
+
+      /**
+       * @brief Watches the clauses of a formula and assigns its unit clauses on level 0, without propagating them.
+       * Clears the previous assignment, the memory of the previous formula is reused
+       *
+       * @param formula The formula, has to outlive the binding
+       */
+      void bind(cnf::CNF& formula);
+
+      /**
+       * @brief Get the value of a literal
+       *
+       * @param literal The literal
+       * @return LITERAL_VALUE The value under the current assignment
+       */
+      inline LITERAL_VALUE getValue(const int literal) const {
+         const std::size_t variable = static_cast<std::size_t>(std::abs(literal));
+         if (variable >= this->values.size()) {
+            return LITERAL_VALUE::UNASSIGNED;
+         }
+         return static_cast<LITERAL_VALUE>((literal < 0) ? -this->values[variable] : this->values[variable]);
+      }
+
+      /**
+       * @brief Get the current decision level, the number of decisions on the trail
+       *
+       * @return unsigned The decision level
+       */
+      inline unsigned getLevel() const {
+         return static_cast<unsigned>(this->levelStarts.size());
+      }
+
+      /**
+       * @brief Get the decision level a variable was assigned on
+       *
+       * @param variable The variable, has to be assigned
+       * @return unsigned The decision level
+       */
+      inline unsigned getLevel(const unsigned variable) const {
+         return this->levels[variable];
+      }
+
+      /**
+       * @brief Get the clause that implied the value of a variable
+       *
+       * @param variable The variable, has to be assigned
+       * @return ClauseRef The clause, NO_CLAUSE for decisions
+       */
+      inline ClauseRef getReason(const unsigned variable) const {
+         return this->reasons[variable];
+      }
+
+      /**
+       * @brief Get the assigned literals in the order they were assigned
+       *
+       * @return const Literals& The trail
+       */
+      inline const Literals& getTrail() const {
+         return this->trail;
+      }
+
+      /**
+       * @brief Get the number of literals propagated since the formula was bound, e.g. to limit the work of a procedure
+       *
+       * @return std::size_t The number of propagated literals
+       */
+      inline std::size_t getPropagations() const {
+         return this->propagations;
+      }
+
+      /**
+       * @brief Assigns a literal on the current decision level, it is propagated by the next call of propagate()
+       *
+       * @param literal The literal to set to true
+       * @param reason The clause implying the literal, NO_CLAUSE if there is none
+       * @return bool False if the literal is false already
+       */
+      bool assign(int literal, ClauseRef reason = NO_CLAUSE);
+
+      /**
+       * @brief Opens a new decision level and assigns a literal on it
+       *
+       * @param literal The literal to set to true
+       * @return bool False if the literal is false already
+       */
+      bool assume(int literal);
+
+      /**
+       * @brief Propagates all literals assigned since the last call, until every clause is satisfied, has two literals
+       * that are not false or a clause is falsified
+       *
+       * @return ClauseRef The falsified clause, NO_CLAUSE if there is no conflict
+       */
+      ClauseRef propagate();
+
+      /**
+       * @brief Takes back all assignments made after the given decision level
+       *
+       * @param level The decision level to go back to, smaller than getLevel()
+       */
+      void backtrack(unsigned level);
+
+      /**
+       * @brief Watches a clause that was added to the bound formula. Has to be called on decision level 0, the
+       * literals it implies are propagated by the next call of propagate()
+       *
+       * @param clause The reference of the added clause
+       */
+      void addClause(ClauseRef clause);
+
+      /**
+       * @brief Notes that a clause was removed from the bound formula. Has to be called on decision level 0. If the
+       * clause implied an assignment, the formula is bound again, otherwise its watches are dropped lazily
+       *
+       * @param clause The reference of the removed clause
+       */
+      void removeClause(ClauseRef clause);
+
+      /**
+       * @brief Watches a clause of the bound formula again after a literal was erased from it. Has to be called on
+       * decision level 0, the literals it implies are propagated by the next call of propagate()
+       *
+       * @param clause The reference of the clause
+       */
+      void eraseLiteral(ClauseRef clause);
+
+   protected:
+
+
+   private:
+
+      /**
+       * @brief Watches two literals of a clause of the formula that are not false. Assigns the clause on the current
+       * decision level if only one of them is left
+       *
+       * @param clause The reference of the clause, which must not be removed
+       */
+      void watchClause(ClauseRef clause);
+
+      /**
+       * @brief Removes the watches of a clause from the watch lists
+       *
+       * @param clause The reference of the clause
+       */
+      void unwatchClause(ClauseRef clause);
+
+      /**
+       * @brief Assigns the literals implied by the binary clauses of a literal that just became true
+       *
+       * @param literal The literal
+       * @return ClauseRef The falsified clause, NO_CLAUSE if there is no conflict
+       */
+      ClauseRef visitImplications(int literal);
+
+      /**
+       * @brief Visits the clauses watched by a literal that just became false
+       *
+       * @param falsified The literal
+       * @return ClauseRef The falsified clause, NO_CLAUSE if there is no conflict
+       */
+      ClauseRef visitWatches(int falsified);
+
+      /**
+       * @brief The bound formula
+       *
+       */
+      cnf::CNF* formula = nullptr;
+
+      /**
+       * @brief The implication graph of the binary clauses of the formula
+       *
+       */
+      const BinaryImplications* implications = nullptr;
+
+      /**
+       * @brief The watches of the clauses with more than two literals
+       *
+       */
+      WatchLists watches;
+
+      /**
+       * @brief The two watched literals of every clause with more than two literals, indexed by clause reference. Both
+       * are 0 for clauses that are not watched
+       *
+       */
+      std::vector<std::array<int, 2>> watched;
+
+      /**
+       * @brief The value of every variable, 1 for true, -1 for false and 0 if unassigned
+       *
+       */
+      std::vector<signed char> values;
+
+      /**
+       * @brief The decision level of every assigned variable
+       *
+       */
+      std::vector<unsigned> levels;
+
+      /**
+       * @brief The clause implying every assigned variable
+       *
+       */
+      std::vector<ClauseRef> reasons;
+
+      /**
+       * @brief The assigned literals in the order they were assigned
+       *
+       */
+      Literals trail;
+
+      /**
+       * @brief The position in the trail where every decision level starts
+       *
+       */
+      std::vector<std::size_t> levelStarts;
+
+      /**
+       * @brief The number of literals of the trail that were propagated already
+       *
+       */
+      std::size_t propagated = 0;
+
+      /**
+       * @brief The number of literals propagated since the formula was bound
+       *
+       */
+      std::size_t propagations = 0;
+
+      /**
+       * @brief A clause that is falsified on level 0, the formula is unsatisfiable then
+       *
+       */
+      ClauseRef conflict = NO_CLAUSE;
+
+   };
+
+}
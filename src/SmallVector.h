@@ -0,0 +1,349 @@
+/**
+ * @file SmallVector.h
+ * @author Anton Reinhard
+ * @brief Vector with inline storage for few elements
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <limits>
+#include <initializer_list>
+#include <type_traits>
+
+namespace preppy::util {
+
+   /**
+    * @brief A vector of trivially copyable elements, storing up to N elements inside the object itself
+    *
+    * @details The inline elements share their memory with the pointer to the heap buffer, so for N * sizeof(T) <= 16
+    * the object is exactly as large as a std::vector. Only when more than N elements are stored a heap buffer is
+    * allocated. Offers the subset of the std::vector interface used by Clause.
+    */
+   template<typename T, std::size_t N>
+   class SmallVector {
+      static_assert(std::is_trivially_copyable<T>::value, "SmallVector only supports trivially copyable elements");
+      static_assert(N > 0, "SmallVector needs room for at least one inline element");
+
+   public:
+      typedef T value_type;
+      typedef T* iterator;
+      typedef const T* const_iterator;
+      typedef T& reference;
+      typedef const T& const_reference;
+      typedef std::size_t size_type;
+
+      SmallVector() = default;
+
+      SmallVector(std::initializer_list<T> l) {
+         this->assign(l.begin(), l.end());
+      }
+
+      SmallVector(const T* first, const T* last) {
+         this->assign(first, last);
+      }
+
+      SmallVector(const SmallVector& other) {
+         this->assign(other.begin(), other.end());
+      }
+
+      SmallVector(SmallVector&& other) noexcept {
+         this->takeFrom(other);
+      }
+
+      SmallVector& operator=(const SmallVector& other) {
+         if (&other != this) {
+            this->assign(other.begin(), other.end());
+         }
+         return *this;
+      }
+
+      SmallVector& operator=(SmallVector&& other) noexcept {
+         if (&other != this) {
+            this->release();
+            this->takeFrom(other);
+         }
+         return *this;
+      }
+
+      ~SmallVector() {
+         this->release();
+      }
+
+      /**
+       * @brief Replaces the content with the elements in [first, last)
+       *
+       * @param first The first element
+       * @param last Behind the last element, the range must not point into this vector
+       */
+      void assign(const T* first, const T* last) {
+         const size_type count = static_cast<size_type>(last - first);
+         this->reserve(count);
+         if (0 != count) {
+            std::memcpy(this->data(), first, count * sizeof(T));
+         }
+         this->count = static_cast<std::uint32_t>(count);
+      }
+
+      /**
+       * @brief Checks whether the elements are stored inside the object
+       *
+       * @return bool True if no heap buffer is used
+       */
+      bool isInline() const noexcept {
+         return this->allocated <= N;
+      }
+
+      T* data() noexcept {
+         return this->isInline() ? this->storage.elements : this->storage.heap;
+      }
+
+      const T* data() const noexcept {
+         return this->isInline() ? this->storage.elements : this->storage.heap;
+      }
+
+      iterator begin() noexcept {
+         return this->data();
+      }
+
+      const_iterator begin() const noexcept {
+         return this->data();
+      }
+
+      iterator end() noexcept {
+         return this->data() + this->count;
+      }
+
+      const_iterator end() const noexcept {
+         return this->data() + this->count;
+      }
+
+      reference front() {
+         return this->data()[0];
+      }
+
+      const_reference front() const {
+         return this->data()[0];
+      }
+
+      reference back() {
+         return this->data()[this->count - 1];
+      }
+
+      const_reference back() const {
+         return this->data()[this->count - 1];
+      }
+
+      reference operator[](const size_type n) {
+         return this->data()[n];
+      }
+
+      const_reference operator[](const size_type n) const {
+         return this->data()[n];
+      }
+
+      reference at(const size_type n) {
+         if (n >= this->count) {
+            throw std::out_of_range("SmallVector::at");
+         }
+         return this->data()[n];
+      }
+
+      const_reference at(const size_type n) const {
+         if (n >= this->count) {
+            throw std::out_of_range("SmallVector::at");
+         }
+         return this->data()[n];
+      }
+
+      void push_back(const T& val) {
+         // copy first, val could be an element of this vector
+         const T copy = val;
+         if (this->count == this->allocated) {
+            this->grow(this->count + 1);
+         }
+         this->data()[this->count++] = copy;
+      }
+
+      void pop_back() {
+         --this->count;
+      }
+
+      iterator erase(const_iterator position) {
+         return this->erase(position, position + 1);
+      }
+
+      iterator erase(const_iterator first, const_iterator last) {
+         T* begin = this->data();
+         const size_type firstIndex = static_cast<size_type>(first - begin);
+         const size_type lastIndex = static_cast<size_type>(last - begin);
+         if (lastIndex != this->count) {
+            std::memmove(begin + firstIndex, begin + lastIndex, (this->count - lastIndex) * sizeof(T));
+         }
+         this->count -= static_cast<std::uint32_t>(lastIndex - firstIndex);
+         return begin + firstIndex;
+      }
+
+      iterator insert(const_iterator position, const T& val) {
+         return this->insert(position, 1, val);
+      }
+
+      iterator insert(const_iterator position, const size_type n, const T& val) {
+         const T copy = val;
+         T* gap = this->openGap(position, n);
+         for (size_type i = 0; i < n; ++i) {
+            gap[i] = copy;
+         }
+         return gap;
+      }
+
+      iterator insert(const_iterator position, std::initializer_list<T> il) {
+         T* gap = this->openGap(position, il.size());
+         if (0 != il.size()) {
+            std::memcpy(gap, il.begin(), il.size() * sizeof(T));
+         }
+         return gap;
+      }
+
+      void clear() noexcept {
+         this->count = 0;
+      }
+
+      void reserve(const size_type n) {
+         if (n > this->allocated) {
+            this->grow(n);
+         }
+      }
+
+      size_type capacity() const noexcept {
+         return this->allocated;
+      }
+
+      void resize(const size_type n) {
+         this->resize(n, T());
+      }
+
+      void resize(const size_type n, const T& val) {
+         const T copy = val;
+         this->reserve(n);
+         T* elements = this->data();
+         for (size_type i = this->count; i < n; ++i) {
+            elements[i] = copy;
+         }
+         this->count = static_cast<std::uint32_t>(n);
+      }
+
+      size_type size() const noexcept {
+         return this->count;
+      }
+
+      bool empty() const noexcept {
+         return 0 == this->count;
+      }
+
+      size_type max_size() const noexcept {
+         return std::numeric_limits<std::uint32_t>::max();
+      }
+
+   private:
+
+      /**
+       * @brief Moves the elements behind position n places back, growing the buffer if needed
+       *
+       * @param position Where the gap should start
+       * @param n The size of the gap
+       * @return T* The start of the gap
+       */
+      T* openGap(const_iterator position, const size_type n) {
+         const size_type index = static_cast<size_type>(position - this->data());
+         this->reserve(this->count + n);
+         T* elements = this->data();
+         if (index != this->count) {
+            std::memmove(elements + index + n, elements + index, (this->count - index) * sizeof(T));
+         }
+         this->count += static_cast<std::uint32_t>(n);
+         return elements + index;
+      }
+
+      /**
+       * @brief Moves the elements into a heap buffer with room for at least the given number of elements
+       *
+       * @param minimum The number of elements that have to fit
+       */
+      void grow(const size_type minimum) {
+         size_type newCapacity = 2 * static_cast<size_type>(this->allocated);
+         if (newCapacity < minimum) {
+            newCapacity = minimum;
+         }
+         T* buffer = static_cast<T*>(::operator new(newCapacity * sizeof(T)));
+         if (0 != this->count) {
+            std::memcpy(buffer, this->data(), this->count * sizeof(T));
+         }
+         this->release();
+         this->storage.heap = buffer;
+         this->allocated = static_cast<std::uint32_t>(newCapacity);
+      }
+
+      /**
+       * @brief Frees the heap buffer, if any, and goes back to the inline storage. Doesn't change the size
+       *
+       */
+      void release() noexcept {
+         if (!this->isInline()) {
+            ::operator delete(this->storage.heap);
+            this->allocated = N;
+         }
+      }
+
+      /**
+       * @brief Takes the elements of other, which is left empty. This vector must not own a heap buffer
+       *
+       * @param other The vector to take the elements from
+       */
+      void takeFrom(SmallVector& other) noexcept {
+         if (other.isInline()) {
+            std::memcpy(this->storage.elements, other.storage.elements, other.count * sizeof(T));
+            this->allocated = N;
+         }
+         else {
+            this->storage.heap = other.storage.heap;
+            this->allocated = other.allocated;
+            other.allocated = N;
+         }
+         this->count = other.count;
+         other.count = 0;
+      }
+
+      /**
+       * @brief The inline elements or the pointer to the heap buffer, depending on isInline()
+       *
+       */
+      union {
+         T elements[N];
+         T* heap;
+      } storage;
+
+      /**
+       * @brief The number of elements
+       *
+       */
+      std::uint32_t count = 0;
+
+      /**
+       * @brief The number of elements that fit into the current buffer, N while the inline storage is used
+       *
+       */
+      std::uint32_t allocated = N;
+
+   };
+
+}
@@ -13,6 +13,7 @@
 #include "CommandLineParser.h"
 #include "definitions.h"
 #include "solvers/clasp.h"
+#include "solvers/CDCL.h"
 
 #include <sys/stat.h>
 #include <unistd.h>
@@ -28,12 +29,16 @@
 #include <sys/wait.h>
 #include <string.h>
 #include <argp.h>
+#include <array>
 
 namespace preppy::util {
 
    std::unique_ptr<log::Logger> Utility::logger = nullptr;
 
    std::shared_ptr<solvers::Solver> Utility::solver = nullptr;
+   std::string Utility::solverName = "clasp";
+   unsigned Utility::threads = 1;
+   bool Utility::logToStandardError = false;
    clock::duration Utility::solvingTimeout = std::chrono::seconds(5);
 
    log::LOG_LEVEL Utility::GLOBAL_LOG_LEVEL = log::LOG_LEVEL::WARNING;
@@ -42,10 +47,10 @@ namespace preppy::util {
 
    bool Utility::init() {
       // always initialize the logger first
-      Utility::initializeLogger(Utility::GLOBAL_LOG_LEVEL);
+      Utility::initializeLogger(Utility::GLOBAL_LOG_LEVEL, Utility::logToStandardError ? std::cerr : std::cout);
       Utility::initializeSignalHandling();
 
-      Utility::solver = std::make_shared<solvers::clasp>(solvingTimeout);
+      Utility::setSolver(Utility::solverName);
 
       return true;
    }
@@ -64,6 +69,9 @@ namespace preppy::util {
       Arguments args = clp.getArguments();
 
       util::Utility::GLOBAL_LOG_LEVEL = args.logLevel;
+      util::Utility::threads = args.threads;
+      util::Utility::logToStandardError = ("-" == args.fileOut);
+      util::Utility::solverName = args.solver;
 
       return args;
    }
@@ -89,9 +97,9 @@ namespace preppy::util {
       return ss.str();
    }
 
-   void Utility::initializeLogger(const log::LOG_LEVEL logLevel) {
+   void Utility::initializeLogger(const log::LOG_LEVEL logLevel, std::ostream& stream) {
       if (logger == nullptr) {
-         logger = std::make_unique<log::Logger>(logLevel);
+         logger = std::make_unique<log::Logger>(logLevel, stream);
       }
       else {
          std::cerr << "A logger was already initialized!" << std::endl;
@@ -216,6 +224,10 @@ namespace preppy::util {
       return Utility::solver;
    }
 
+   unsigned Utility::getThreads() {
+      return Utility::threads;
+   }
+
    cnf::Variables Utility::literalsToVariables(const cnf::Literals& literals) {
       cnf::Variables vars;
       for (const auto& lit : literals) {
@@ -229,6 +241,10 @@ namespace preppy::util {
          Utility::logDebug("Using solver \"", solverName, "\"");
          Utility::solver.reset(new solvers::clasp(solvingTimeout));
       }
+      else if ("cdcl" == solverName) {
+         Utility::logDebug("Using solver \"", solverName, "\"");
+         Utility::solver.reset(new solvers::CDCL(solvingTimeout));
+      }
       else {
          Utility::logError("Can't set unknown solver \"", solverName, "\"");
       }
@@ -73,8 +73,9 @@ namespace preppy::util {
        * @brief Initializes the Logger
        * 
        * @param logLevel Log level to use for the logger
+       * @param stream The stream to write the log to
        */
-      static void initializeLogger(const log::LOG_LEVEL logLevel);
+      static void initializeLogger(const log::LOG_LEVEL logLevel, std::ostream& stream = std::cout);
 
       /**
        * @brief Deletes the Logger
@@ -266,6 +267,13 @@ namespace preppy::util {
        */
       static std::shared_ptr<solvers::Solver> getSolver();
 
+      /**
+       * @brief Gets the number of threads set on the command line
+       * 
+       * @return unsigned The number of threads to use, at least 1
+       */
+      static unsigned getThreads();
+
       /**
        * @brief Converts a vector of literals to a vector of variables, effectively using abs() on every literal
        * 
@@ -297,12 +305,30 @@ namespace preppy::util {
        */
       static std::shared_ptr<solvers::Solver> solver;
 
+      /**
+       * @brief The name of the solver created by init()
+       * 
+       */
+      static std::string solverName;
+
       /**
        * @brief Timeout for processing
        * 
        */
       static clock::duration solvingTimeout;
 
+      /**
+       * @brief The number of threads to use for reading and writing cnf files
+       * 
+       */
+      static unsigned threads;
+
+      /**
+       * @brief Set when the output formula is written to the standard output, the log then goes to the standard error
+       * 
+       */
+      static bool logToStandardError;
+
       /**
        * @brief The log level used by everything
        * 
@@ -0,0 +1,32 @@
+/**
+ * @file WatchLists.cpp
+ * @author Anton Reinhard
+ * @brief Watch lists implementation
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "WatchLists.h"
+
+namespace preppy::cnf {
+
+   void WatchLists::clear(const unsigned maxVariable) {
+      // keep the capacity of the inner lists, rebuilding the watches will need roughly the same again
+      for (auto& list : this->lists) {
+         list.clear();
+      }
+      this->reserve(maxVariable);
+      this->entries = 0;
+      this->stale = 0;
+   }
+
+   void WatchLists::reserve(const unsigned maxVariable) {
+      if (this->lists.size() < 2 * static_cast<std::size_t>(maxVariable) + 2) {
+         this->lists.resize(2 * static_cast<std::size_t>(maxVariable) + 2);
+      }
+   }
+
+}
@@ -0,0 +1,179 @@
+/**
+ * @file WatchLists.h
+ * @author Anton Reinhard
+ * @brief Watch lists header
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include "definitions.h"
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+namespace preppy::cnf {
+
+   /**
+    * @brief A single entry of a watch list
+    *
+    */
+   struct Watch {
+      /**
+       * @brief The watched clause
+       *
+       */
+      ClauseRef clause;
+
+      /**
+       * @brief Another literal of the clause. If it is true the clause is satisfied and doesn't need to be looked at
+       *
+       */
+      int blocker;
+   };
+
+   /**
+    * @brief The watch lists of all literals of a formula, stored densely and indexed by literalIndex()
+    *
+    * @details Removing a clause doesn't touch the lists, its entries stay until they are swept by cleanup(). Users
+    * of the lists therefore have to skip entries of removed clauses.
+    */
+   class WatchLists {
+   public:
+
+      /**
+       * @brief Construct empty watch lists
+       *
+       */
+      WatchLists() = default;
+
+      /**
+       * @brief Get the watch list of a literal, grows the lists if the literal is not covered yet
+       *
+       * @param literal The literal
+       * @return std::vector<Watch>& The watches of the literal
+       */
+      inline std::vector<Watch>& operator[](const int literal) {
+         const std::size_t index = literalIndex(literal);
+         if (index >= this->lists.size()) {
+            this->lists.resize(index + 2);
+         }
+         return this->lists[index];
+      }
+
+      /**
+       * @brief Adds a watch of a clause to a literal's list
+       *
+       * @param literal The watched literal
+       * @param clause The clause
+       * @param blocker Another literal of the clause
+       */
+      inline void watch(const int literal, const ClauseRef clause, const int blocker) {
+         (*this)[literal].push_back({clause, blocker});
+         ++this->entries;
+      }
+
+      /**
+       * @brief Removes the watches of a clause from a literal's list right away, e.g. because the clause is watched by
+       * other literals now
+       *
+       * @param literal The watched literal
+       * @param clause The clause
+       */
+      inline void unwatch(const int literal, const ClauseRef clause) {
+         std::vector<Watch>& list = (*this)[literal];
+         const auto kept = std::remove_if(list.begin(), list.end(), [clause](const Watch& watch) {
+            return watch.clause == clause;
+         });
+         this->entries -= static_cast<std::size_t>(list.end() - kept);
+         list.erase(kept, list.end());
+      }
+
+      /**
+       * @brief Notes that a clause with the given number of watches was removed. Sweeps all lists once at least half of
+       * their entries belong to removed clauses
+       *
+       * @param watches The number of watches the clause had
+       * @param isRemoved Returns true for the reference of every removed clause
+       */
+      template<typename Predicate>
+      void remove(const std::size_t watches, Predicate isRemoved) {
+         this->stale += watches;
+         if (2 * this->stale > this->entries) {
+            this->cleanup(isRemoved);
+         }
+      }
+
+      /**
+       * @brief Removes the entries of all removed clauses from the lists
+       *
+       * @param isRemoved Returns true for the reference of every removed clause
+       */
+      template<typename Predicate>
+      void cleanup(Predicate isRemoved) {
+         this->entries = 0;
+         for (auto& list : this->lists) {
+            auto kept = list.begin();
+            for (const Watch& watch : list) {
+               if (!isRemoved(watch.clause)) {
+                  *kept++ = watch;
+               }
+            }
+            list.erase(kept, list.end());
+            this->entries += list.size();
+         }
+         this->stale = 0;
+      }
+
+      /**
+       * @brief Removes all watches and makes room for the literals of the given number of variables
+       *
+       * @param maxVariable The maximum variable that will be watched
+       */
+      void clear(unsigned maxVariable = 0);
+
+      /**
+       * @brief Makes room for the literals of the given number of variables, so adding watches to their lists doesn't
+       * move the other lists anymore
+       *
+       * @param maxVariable The maximum variable that will be watched
+       */
+      void reserve(unsigned maxVariable);
+
+      /**
+       * @brief Checks whether there are no watches
+       *
+       * @return bool True if no clause is watched
+       */
+      inline bool empty() const {
+         return 0 == this->entries;
+      }
+
+   private:
+
+      /**
+       * @brief The watch list of every literal, indexed by literalIndex()
+       *
+       */
+      std::vector<std::vector<Watch>> lists;
+
+      /**
+       * @brief The number of watches in all lists, counting the ones of removed clauses
+       *
+       */
+      std::size_t entries = 0;
+
+      /**
+       * @brief The number of watches belonging to removed clauses since the last cleanup
+       *
+       */
+      std::size_t stale = 0;
+
+   };
+
+}
@@ -0,0 +1,242 @@
+/**
+ * @file BinaryCnf.cpp
+ * @author Anton Reinhard
+ * @brief Binary cnf file format implementation
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "BinaryCnf.h"
+#include "../CNF.h"
+#include "../Utility.h"
+
+#include <fstream>
+#include <filesystem>
+#include <cstring>
+#include <cstdlib>
+
+namespace preppy::io {
+
+   namespace {
+
+      /**
+       * @brief The magic bytes every binary cnf file starts with
+       *
+       */
+      constexpr char binaryMagic[8] = {'P', 'R', 'E', 'P', 'P', 'Y', 'B', 'C'};
+
+      /**
+       * @brief The version of the format, increased on every incompatible change
+       *
+       */
+      constexpr std::uint32_t binaryVersion = 1;
+
+      /**
+       * @brief Written in native byte order, so files from machines with a different byte order are rejected
+       *
+       */
+      constexpr std::uint32_t byteOrderMark = 0x01020304;
+
+      static_assert(sizeof(BinaryCnfHeader) == 80, "BinaryCnfHeader must not contain padding");
+      static_assert(sizeof(int) == sizeof(std::uint32_t), "Literals are stored as 32 bit integers");
+
+      /**
+       * @brief Size of a single compression step in the file
+       *
+       */
+      constexpr std::size_t compressionStepSize = 3 * sizeof(std::uint32_t);
+
+   }
+
+   bool isBinaryCnf(const std::string& filepath) {
+      std::ifstream file(filepath, std::ios::binary);
+      char magic[sizeof(binaryMagic)];
+      if (!file.read(magic, sizeof(magic))) {
+         return false;
+      }
+      return 0 == std::memcmp(magic, binaryMagic, sizeof(binaryMagic));
+   }
+
+   bool hasBinaryCnfExtension(const std::string& filepath) {
+      return std::filesystem::path(filepath).extension() == ".pcnf";
+   }
+
+   bool writeBinaryCnf(std::ostream& stream, const BinaryCnfMetadata& metadata, const cnf::CNF& clauses) {
+      std::vector<std::uint64_t> offsets;
+      offsets.reserve(clauses.size() + 1);
+      offsets.push_back(0);
+      for (const auto& clause : clauses) {
+         offsets.push_back(offsets.back() + clause.size());
+      }
+
+      std::string strings = metadata.name;
+      strings.push_back('\0');
+      for (const auto& procedure : metadata.procedures) {
+         strings += procedure;
+         strings.push_back('\0');
+      }
+
+      BinaryCnfHeader header{};
+      std::memcpy(header.magic, binaryMagic, sizeof(binaryMagic));
+      header.version = binaryVersion;
+      header.byteOrder = byteOrderMark;
+      header.equivalence = static_cast<std::uint32_t>(metadata.equivalence);
+      header.variables = metadata.variables;
+      header.maxVariable = metadata.maxVariable;
+      header.clauses = clauses.size();
+      header.literals = offsets.back();
+      header.processingTime = std::chrono::duration_cast<std::chrono::nanoseconds>(metadata.processingTime).count();
+      header.compressionSteps = metadata.compressionInformation.size();
+      header.procedures = metadata.procedures.size();
+      header.stringsSize = strings.size();
+
+      stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      stream.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(std::uint64_t));
+      for (const auto& clause : clauses) {
+         stream.write(reinterpret_cast<const char*>(clause.data()), clause.size() * sizeof(int));
+      }
+      for (const auto& [original, renamed, value] : metadata.compressionInformation) {
+         const std::uint32_t step[3] = {original, renamed, value};
+         stream.write(reinterpret_cast<const char*>(step), sizeof(step));
+      }
+      stream.write(strings.data(), strings.size());
+
+      stream.flush();
+      return !stream.fail();
+   }
+
+   bool BinaryCnfReader::open(const std::string& filepath) {
+      if (!this->file.open(filepath)) {
+         util::Utility::logError("File ", filepath, " couldn't be opened");
+         return false;
+      }
+
+      const char* data = this->file.data();
+      const std::size_t size = this->file.size();
+
+      BinaryCnfHeader header;
+      if (size < sizeof(header)) {
+         util::Utility::logError("Binary cnf file ", filepath, " is truncated");
+         return false;
+      }
+      std::memcpy(&header, data, sizeof(header));
+
+      if (0 != std::memcmp(header.magic, binaryMagic, sizeof(binaryMagic))) {
+         util::Utility::logError("File ", filepath, " is not a binary cnf file");
+         return false;
+      }
+      if (header.byteOrder != byteOrderMark) {
+         util::Utility::logError("Binary cnf file ", filepath, " was written with a different byte order");
+         return false;
+      }
+      if (header.version != binaryVersion) {
+         util::Utility::logError("Binary cnf file ", filepath, " has unsupported version ", header.version);
+         return false;
+      }
+      if (header.equivalence > static_cast<std::uint32_t>(cnf::EQUIVALENCE_TYPE::UNEQUIVALENT)) {
+         util::Utility::logError("Binary cnf file ", filepath, " has an invalid equivalence type");
+         return false;
+      }
+
+      // check the section sizes against the file size before computing anything from them, so they can't overflow
+      const std::size_t remaining = size - sizeof(header);
+      if (header.clauses >= remaining / sizeof(std::uint64_t)
+         || header.literals > remaining / sizeof(int)
+         || header.compressionSteps > remaining / compressionStepSize
+         || header.stringsSize > remaining
+         || header.procedures > header.stringsSize) {
+         util::Utility::logError("Binary cnf file ", filepath, " is truncated");
+         return false;
+      }
+      const std::size_t offsetsSize = (header.clauses + 1) * sizeof(std::uint64_t);
+      const std::size_t literalsSize = header.literals * sizeof(int);
+      const std::size_t compressionSize = header.compressionSteps * compressionStepSize;
+      if (sizeof(header) + offsetsSize + literalsSize + compressionSize + header.stringsSize != size) {
+         util::Utility::logError("Binary cnf file ", filepath, " has an invalid size");
+         return false;
+      }
+
+      // the mapping is page aligned and the header size is a multiple of 8, so the tables can be used in place
+      this->clauses = header.clauses;
+      this->offsets = reinterpret_cast<const std::uint64_t*>(data + sizeof(header));
+      this->literals = reinterpret_cast<const int*>(data + sizeof(header) + offsetsSize);
+      const char* compression = data + sizeof(header) + offsetsSize + literalsSize;
+      const char* strings = compression + compressionSize;
+
+      if (0 != this->offsets[0] || header.literals != this->offsets[this->clauses]) {
+         util::Utility::logError("Binary cnf file ", filepath, " has an invalid clause offset table");
+         return false;
+      }
+      for (std::size_t i = 0; i < this->clauses; ++i) {
+         if (this->offsets[i] > this->offsets[i + 1]) {
+            util::Utility::logError("Binary cnf file ", filepath, " has an invalid clause offset table");
+            return false;
+         }
+      }
+      for (std::size_t i = 0; i < header.literals; ++i) {
+         const int literal = this->literals[i];
+         if (0 == literal || static_cast<unsigned>(std::abs(literal)) > header.maxVariable) {
+            util::Utility::logError("Binary cnf file ", filepath, " contains an invalid literal ", literal);
+            return false;
+         }
+      }
+
+      if (0 == header.stringsSize || '\0' != strings[header.stringsSize - 1]) {
+         util::Utility::logError("Binary cnf file ", filepath, " has an invalid string table");
+         return false;
+      }
+
+      this->metadata = BinaryCnfMetadata();
+      this->metadata.equivalence = static_cast<cnf::EQUIVALENCE_TYPE>(header.equivalence);
+      this->metadata.processingTime = std::chrono::duration_cast<util::clock::duration>(std::chrono::nanoseconds(header.processingTime));
+      this->metadata.variables = header.variables;
+      this->metadata.maxVariable = header.maxVariable;
+
+      this->metadata.compressionInformation.reserve(header.compressionSteps);
+      for (std::size_t i = 0; i < header.compressionSteps; ++i) {
+         std::uint32_t step[3];
+         std::memcpy(step, compression + i * compressionStepSize, sizeof(step));
+         this->metadata.compressionInformation.emplace_back(step[0], step[1], 0 != step[2]);
+      }
+
+      // name and procedures are stored one after another, each terminated by a 0
+      const char* string = strings;
+      const char* stringsEnd = strings + header.stringsSize;
+      this->metadata.name = string;
+      string += this->metadata.name.size() + 1;
+      while (string < stringsEnd) {
+         this->metadata.procedures.emplace_back(string);
+         string += this->metadata.procedures.back().size() + 1;
+      }
+      if (this->metadata.procedures.size() != header.procedures) {
+         util::Utility::logError("Binary cnf file ", filepath, " has an invalid string table");
+         return false;
+      }
+
+      return true;
+   }
+
+   const BinaryCnfMetadata& BinaryCnfReader::getMetadata() const {
+      return this->metadata;
+   }
+
+   std::size_t BinaryCnfReader::getClauses() const {
+      return this->clauses;
+   }
+
+   std::size_t BinaryCnfReader::getLiterals() const {
+      return this->offsets[this->clauses];
+   }
+
+   const int* BinaryCnfReader::clauseBegin(const std::size_t clause) const {
+      return this->literals + this->offsets[clause];
+   }
+
+   const int* BinaryCnfReader::clauseEnd(const std::size_t clause) const {
+      return this->literals + this->offsets[clause + 1];
+   }
+
+}
@@ -0,0 +1,186 @@
+/**
+ * @file BinaryCnf.h
+ * @author Anton Reinhard
+ * @brief Binary cnf file format header
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include "../definitions.h"
+#include "MappedFile.h"
+
+#include <string>
+#include <ostream>
+#include <vector>
+#include <tuple>
+#include <cstdint>
+#include <cstddef>
+
+namespace preppy::cnf {
+   class CNF;
+}
+
+namespace preppy::io {
+
+   /**
+    * @brief The fixed size header at the start of every binary cnf file
+    *
+    * @details The header is followed by the clause offset table (clauses + 1 entries of 64 bit, the literals of
+    * clause i are [offsets[i], offsets[i + 1]) ), the packed 32 bit literal array, the compression information
+    * (three 32 bit values per step) and finally the 0 terminated name and procedure names. All values are stored
+    * in the byte order of the machine that wrote the file.
+    */
+   struct BinaryCnfHeader {
+      char magic[8];
+      std::uint32_t version;
+      std::uint32_t byteOrder;
+      std::uint32_t equivalence;
+      std::uint32_t variables;
+      std::uint32_t maxVariable;
+      std::uint32_t reserved;
+      std::uint64_t clauses;
+      std::uint64_t literals;
+      std::int64_t processingTime;
+      std::uint64_t compressionSteps;
+      std::uint64_t procedures;
+      std::uint64_t stringsSize;
+   };
+
+   /**
+    * @brief The metadata of a formula that is stored in a binary cnf file besides its clauses
+    *
+    */
+   struct BinaryCnfMetadata {
+      std::string name;
+      std::vector<std::string> procedures;
+      cnf::EQUIVALENCE_TYPE equivalence = cnf::EQUIVALENCE_TYPE::EQUIVALENT;
+      util::clock::duration processingTime = util::clock::duration::zero();
+      unsigned variables = 0;
+      unsigned maxVariable = 0;
+      std::vector<std::tuple<unsigned, unsigned, bool>> compressionInformation;
+   };
+
+   /**
+    * @brief Checks whether a file starts with the magic bytes of the binary cnf format
+    *
+    * @param filepath The file to check
+    * @return bool True if the file is a binary cnf file
+    */
+   bool isBinaryCnf(const std::string& filepath);
+
+   /**
+    * @brief Checks whether a path has the extension of the binary cnf format, .pcnf
+    *
+    * @param filepath The path to check
+    * @return bool True if the binary format should be used for this path
+    */
+   bool hasBinaryCnfExtension(const std::string& filepath);
+
+   /**
+    * @brief Writes clauses and their metadata to a stream in the binary cnf format
+    *
+    * @param stream The stream to write to, has to be opened in binary mode
+    * @param metadata The metadata of the formula
+    * @param clauses The formula whose clauses are written
+    * @return bool True on success
+    */
+   bool writeBinaryCnf(std::ostream& stream, const BinaryCnfMetadata& metadata, const cnf::CNF& clauses);
+
+   /**
+    * @brief A binary cnf file mapped into memory. The clauses are read in place from the mapping
+    *
+    */
+   class BinaryCnfReader {
+   public:
+
+      /**
+       * @brief Construct an unopened BinaryCnfReader
+       *
+       */
+      BinaryCnfReader() = default;
+
+      /**
+       * @brief Maps the file and validates header, offset table and literals
+       *
+       * @param filepath The binary cnf file to read
+       * @return bool True if the file was mapped and is a valid binary cnf file
+       */
+      bool open(const std::string& filepath);
+
+      /**
+       * @brief Get the metadata stored in the file
+       *
+       * @return const BinaryCnfMetadata& The metadata
+       */
+      const BinaryCnfMetadata& getMetadata() const;
+
+      /**
+       * @brief Get the number of clauses in the file
+       *
+       * @return std::size_t The number of clauses
+       */
+      std::size_t getClauses() const;
+
+      /**
+       * @brief Get the number of literals in the file
+       *
+       * @return std::size_t The number of literals
+       */
+      std::size_t getLiterals() const;
+
+      /**
+       * @brief Get the first literal of a clause
+       *
+       * @param clause The index of the clause
+       * @return const int* Pointer to the first literal of the clause in the mapping
+       */
+      const int* clauseBegin(std::size_t clause) const;
+
+      /**
+       * @brief Get the end of a clause
+       *
+       * @param clause The index of the clause
+       * @return const int* Pointer behind the last literal of the clause in the mapping
+       */
+      const int* clauseEnd(std::size_t clause) const;
+
+   private:
+
+      /**
+       * @brief The mapped file
+       *
+       */
+      MappedFile file;
+
+      /**
+       * @brief The metadata read from the file
+       *
+       */
+      BinaryCnfMetadata metadata;
+
+      /**
+       * @brief The clause offset table inside the mapping
+       *
+       */
+      const std::uint64_t* offsets = nullptr;
+
+      /**
+       * @brief The literal array inside the mapping
+       *
+       */
+      const int* literals = nullptr;
+
+      /**
+       * @brief The number of clauses in the file
+       *
+       */
+      std::size_t clauses = 0;
+
+   };
+
+}
@@ -0,0 +1,399 @@
+/**
+ * @file DimacsParser.cpp
+ * @author Anton Reinhard
+ * @brief DIMACS cnf parser implementation
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "DimacsParser.h"
+#include "../Utility.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace preppy::io {
+
+   namespace {
+
+      inline bool isWhitespace(const char c) {
+         return ' ' == c || '\n' == c || '\t' == c || '\r' == c || '\v' == c || '\f' == c;
+      }
+
+      inline bool isDigit(const char c) {
+         return c >= '0' && c <= '9';
+      }
+
+      inline const char* skipWhitespace(const char* p, const char* end) {
+         while (p != end && isWhitespace(*p)) {
+            ++p;
+         }
+         return p;
+      }
+
+      inline const char* skipLine(const char* p, const char* end) {
+         const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', end - p));
+         return (nullptr == lineEnd) ? end : lineEnd + 1;
+      }
+
+      /**
+       * @brief Returns the number of consecutive digits starting at p, checking 16 characters at once where possible
+       */
+      inline std::size_t countDigits(const char* p, const char* end) {
+#ifdef __SSE2__
+         if (end - p >= 16) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            const __m128i notBelowZero = _mm_cmpgt_epi8(chunk, _mm_set1_epi8('0' - 1));
+            const __m128i notAboveNine = _mm_cmplt_epi8(chunk, _mm_set1_epi8('9' + 1));
+            const unsigned digitMask = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(notBelowZero, notAboveNine)));
+            // the inverted mask has all bits above 15 set, so this is at most 16
+            return static_cast<std::size_t>(__builtin_ctz(~digitMask));
+         }
+#endif
+         const char* digitEnd = p;
+         while (digitEnd != end && isDigit(*digitEnd)) {
+            ++digitEnd;
+         }
+         return static_cast<std::size_t>(digitEnd - p);
+      }
+
+      /**
+       * @brief Reads a literal starting at p and moves p behind it
+       *
+       * @return bool False if there is no valid literal at p
+       */
+      inline bool scanLiteral(const char*& p, const char* end, int& literal) {
+         const bool negative = ('-' == *p);
+         const char* digits = negative ? p + 1 : p;
+
+         const std::size_t numDigits = countDigits(digits, end);
+         // more than 10 digits can never fit an int
+         if (0 == numDigits || numDigits > 10) {
+            return false;
+         }
+
+         std::uint64_t value = 0;
+         for (std::size_t i = 0; i < numDigits; ++i) {
+            value = value * 10 + static_cast<std::uint64_t>(digits[i] - '0');
+         }
+         if (value > static_cast<std::uint64_t>(INT_MAX)) {
+            return false;
+         }
+
+         p = digits + numDigits;
+         if (p != end && !isWhitespace(*p)) {
+            return false;
+         }
+
+         literal = negative ? -static_cast<int>(value) : static_cast<int>(value);
+         return true;
+      }
+
+      /**
+       * @brief Returns the first position at or after the line following p that directly follows a clause terminating 0,
+       * or end if there is none. Tokens are recognized exactly like the parser does, so comments are skipped
+       */
+      const char* findClauseBoundary(const char* p, const char* end) {
+         // only the start of a line is guaranteed to be the start of a token
+         p = skipLine(p, end);
+
+         while (p != end) {
+            p = skipWhitespace(p, end);
+            if (p == end) {
+               break;
+            }
+
+            if ('c' == *p || 'p' == *p) {
+               p = skipLine(p, end);
+               continue;
+            }
+            if ('%' == *p) {
+               return end;
+            }
+
+            const char* tokenEnd = p;
+            while (tokenEnd != end && !isWhitespace(*tokenEnd)) {
+               ++tokenEnd;
+            }
+            if ((tokenEnd - p == 1 && '0' == p[0]) || (tokenEnd - p == 2 && '-' == p[0] && '0' == p[1])) {
+               return tokenEnd;
+            }
+            p = tokenEnd;
+         }
+
+         return end;
+      }
+
+   }
+
+   DimacsParser::DimacsParser(const std::size_t sizeHint, const bool normalizeClauses)
+      : sizeHint(sizeHint)
+      , normalizeClauses(normalizeClauses) {
+
+   }
+
+   bool DimacsParser::parse(const char* begin, const char* end) {
+      const char* p = begin;
+
+      while (!this->endReached) {
+         p = skipWhitespace(p, end);
+         if (p == end) {
+            break;
+         }
+
+         const char c = *p;
+         if ('-' == c || isDigit(c)) {
+            int literal;
+            const char* tokenStart = p;
+            if (!scanLiteral(p, end, literal)) {
+               const char* tokenEnd = tokenStart;
+               while (tokenEnd != end && !isWhitespace(*tokenEnd)) {
+                  ++tokenEnd;
+               }
+               util::Utility::logError("Invalid literal \"", std::string(tokenStart, tokenEnd), "\" in cnf input");
+               return false;
+            }
+
+            if (0 != literal) {
+               this->literals.push_back(literal);
+               const unsigned variable = static_cast<unsigned>(std::abs(literal));
+               if (variable > this->maxVariable) {
+                  this->maxVariable = variable;
+                  if (variable >= this->variableOccurrences.size()) {
+                     this->variableOccurrences.resize(variable + 1);
+                  }
+               }
+               ++this->variableOccurrences[variable];
+               this->clauseOpen = true;
+            }
+            else if (this->clauseOpen) {
+               this->terminateClause();
+            }
+            else {
+               util::Utility::logWarning("Ignoring empty clause in cnf input");
+            }
+         }
+         else if ('c' == c) {          // comment line
+            p = skipLine(p, end);
+         }
+         else if ('p' == c) {          // problem line
+            if (!this->parseProblemLine(p, end)) {
+               return false;
+            }
+         }
+         else if ('%' == c) {          // end of formula marker
+            this->endReached = true;
+         }
+         else {
+            util::Utility::logError("Unexpected character '", c, "' in cnf input");
+            return false;
+         }
+      }
+
+      return true;
+   }
+
+   bool DimacsParser::parseParallel(const char* begin, const char* end, unsigned threads) {
+      // read everything up to and including the problem line sequentially, line by line
+      const char* bodyStart = begin;
+      while (bodyStart != end && !this->problemLineFound && !this->endReached) {
+         const char* lineEnd = skipLine(bodyStart, end);
+         if (!this->parse(bodyStart, lineEnd)) {
+            return false;
+         }
+         bodyStart = lineEnd;
+      }
+
+      // small inputs aren't worth the threads
+      const std::size_t minimumRangeSize = 1 << 20;
+      const std::size_t bodySize = static_cast<std::size_t>(end - bodyStart);
+      threads = std::max(1u, std::min<unsigned>(threads, bodySize / minimumRangeSize));
+      if (threads <= 1 || this->endReached) {
+         this->literals.reserve(this->literals.size() + bodySize / 2 + 1);
+         return this->parse(bodyStart, end);
+      }
+
+      // split into ranges that start directly after a clause, so no clause is split between two threads
+      std::vector<const char*> rangeStarts(threads + 1);
+      rangeStarts[0] = bodyStart;
+      rangeStarts[threads] = end;
+      for (unsigned i = 1; i < threads; ++i) {
+         rangeStarts[i] = std::max(rangeStarts[i - 1], findClauseBoundary(bodyStart + i * (bodySize / threads), end));
+      }
+
+      std::vector<DimacsParser> rangeParsers(threads, DimacsParser(0, this->normalizeClauses));
+      std::vector<char> rangeSuccess(threads, false);
+      std::vector<std::thread> workers;
+      workers.reserve(threads);
+      for (unsigned i = 0; i < threads; ++i) {
+         workers.emplace_back([&, i]() {
+            DimacsParser& rangeParser = rangeParsers[i];
+            // another problem line in the body is an error
+            rangeParser.problemLineFound = true;
+            rangeParser.literals.reserve((rangeStarts[i + 1] - rangeStarts[i]) / 2 + 1);
+            rangeParser.variableOccurrences.resize(this->headerVariables + 1);
+            rangeSuccess[i] = rangeParser.parse(rangeStarts[i], rangeStarts[i + 1]);
+         });
+      }
+      for (auto& worker : workers) {
+         worker.join();
+      }
+
+      // join the ranges in order, everything after an end marker is ignored
+      std::size_t totalLiterals = this->literals.size();
+      unsigned usedRanges = 0;
+      while (usedRanges < threads) {
+         if (!rangeSuccess[usedRanges]) {
+            return false;
+         }
+         totalLiterals += rangeParsers[usedRanges].literals.size();
+         ++usedRanges;
+         if (rangeParsers[usedRanges - 1].endReached) {
+            this->endReached = true;
+            break;
+         }
+      }
+
+      this->literals.reserve(totalLiterals);
+      for (unsigned i = 0; i < usedRanges; ++i) {
+         DimacsParser& rangeParser = rangeParsers[i];
+
+         this->clauseStart = this->literals.size() + rangeParser.clauseStart;
+         this->literals.insert(this->literals.end(), rangeParser.literals.begin(), rangeParser.literals.end());
+         rangeParser.literals = cnf::Literals();
+         this->clauses += rangeParser.clauses;
+         this->clauseOpen = rangeParser.clauseOpen;
+
+         if (rangeParser.maxVariable > this->maxVariable) {
+            this->maxVariable = rangeParser.maxVariable;
+         }
+         if (rangeParser.variableOccurrences.size() > this->variableOccurrences.size()) {
+            this->variableOccurrences.resize(rangeParser.variableOccurrences.size());
+         }
+         for (std::size_t variable = 0; variable < rangeParser.variableOccurrences.size(); ++variable) {
+            this->variableOccurrences[variable] += rangeParser.variableOccurrences[variable];
+         }
+      }
+
+      return true;
+   }
+
+   bool DimacsParser::finish() {
+      if (this->clauseOpen) {
+         util::Utility::logWarning("Last clause in cnf input is not terminated by a 0");
+         this->terminateClause();
+      }
+      return true;
+   }
+
+   void DimacsParser::terminateClause() {
+      if (this->normalizeClauses) {
+         int* first = this->literals.data() + this->clauseStart;
+         int* last = this->literals.data() + this->literals.size();
+         std::sort(first, last, cnf::literalLess);
+         // the statistics count every literal that was read, so take back the duplicates, they are adjacent after sorting
+         for (const int* literal = first + 1; literal < last; ++literal) {
+            if (*literal == *(literal - 1)) {
+               --this->variableOccurrences[static_cast<unsigned>(std::abs(*literal))];
+            }
+         }
+         int* distinctEnd = cnf::normalizeLiterals(first, last);
+         this->literals.resize(this->clauseStart + static_cast<std::size_t>(distinctEnd - first));
+      }
+      this->literals.push_back(0);
+      this->clauseStart = this->literals.size();
+      ++this->clauses;
+      this->clauseOpen = false;
+   }
+
+   bool DimacsParser::parseProblemLine(const char*& p, const char* end) {
+      if (this->problemLineFound) {
+         util::Utility::logError("Multiple problem lines found in cnf input");
+         return false;
+      }
+
+      const char* lineEnd = skipLine(p, end);
+      std::istringstream ss(std::string(p, lineEnd));
+      p = lineEnd;
+
+      std::string discard;
+      std::string format;
+      long long variables = -1;
+      long long clauses = -1;
+      ss >> discard;                // "p"
+      ss >> format;                 // "cnf"
+      ss >> variables;
+      ss >> clauses;
+      if (ss.fail() || "p" != discard || "cnf" != format || variables < 0 || clauses < 0 || variables > INT_MAX || clauses > UINT_MAX) {
+         util::Utility::logError("Invalid problem line in cnf input");
+         return false;
+      }
+
+      this->headerVariables = static_cast<unsigned>(variables);
+      this->headerClauses = static_cast<unsigned>(clauses);
+      this->problemLineFound = true;
+      util::Utility::logInfo("Read problem line: ", this->headerVariables, " variables and ", this->headerClauses, " clauses");
+
+      // every literal and terminator takes at least two characters, so this is enough to never reallocate
+      if (0 != this->sizeHint) {
+         this->literals.reserve(std::max<std::size_t>(this->sizeHint / 2 + 1, this->headerClauses));
+      }
+      if (this->headerVariables >= this->variableOccurrences.size()) {
+         this->variableOccurrences.resize(this->headerVariables + 1);
+      }
+
+      return true;
+   }
+
+   bool DimacsParser::hasProblemLine() const {
+      return this->problemLineFound;
+   }
+
+   unsigned DimacsParser::getHeaderVariables() const {
+      return this->headerVariables;
+   }
+
+   unsigned DimacsParser::getHeaderClauses() const {
+      return this->headerClauses;
+   }
+
+   cnf::Literals& DimacsParser::getLiterals() {
+      return this->literals;
+   }
+
+   unsigned DimacsParser::getClauses() const {
+      return this->clauses;
+   }
+
+   unsigned DimacsParser::getMaxVariable() const {
+      return this->maxVariable;
+   }
+
+   unsigned DimacsParser::getVariables() const {
+      unsigned variables = 0;
+      for (std::size_t variable = 1; variable < this->variableOccurrences.size(); ++variable) {
+         if (0 != this->variableOccurrences[variable]) {
+            ++variables;
+         }
+      }
+      return variables;
+   }
+
+   const std::vector<unsigned>& DimacsParser::getVariableOccurrences() const {
+      return this->variableOccurrences;
+   }
+
+}
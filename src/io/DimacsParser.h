@@ -0,0 +1,220 @@
+/**
+ * @file DimacsParser.h
+ * @author Anton Reinhard
+ * @brief DIMACS cnf parser header
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include "../definitions.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace preppy::io {
+
+   /**
+    * @brief Parses DIMACS cnf text in place, writing the literals into one flat, pre-reserved buffer
+    *
+    * @details The input can be given in one piece (e.g. a memory mapped file) or in several consecutive blocks.
+    * Blocks may split clauses, but never lines, so every block has to end on a line break or at the end of the input.
+    * Every clause in the resulting buffer is terminated by a 0, exactly like in the cnf file itself.
+    */
+   class DimacsParser {
+   public:
+
+      /**
+       * @brief Construct a new DimacsParser
+       *
+       * @param sizeHint The number of bytes the input is expected to have, used to reserve the literal buffer
+       * once the problem line was read. 0 if unknown
+       * @param normalizeClauses When set the literals of every clause are sorted by cnf::literalLess() and duplicate
+       * literals are removed as soon as the clause is terminated
+       */
+      DimacsParser(std::size_t sizeHint = 0, bool normalizeClauses = false);
+
+      /**
+       * @brief Parses a block of cnf text
+       *
+       * @param begin The first character of the block
+       * @param end One past the last character of the block
+       * @return bool True on success, False if the input is malformed
+       */
+      bool parse(const char* begin, const char* end);
+
+      /**
+       * @brief Parses a complete cnf text using multiple threads
+       *
+       * @param begin The first character of the text
+       * @param end One past the last character of the text
+       * @param threads The number of threads to use
+       * @return bool True on success, False if the input is malformed
+       *
+       * @details Everything up to the problem line is parsed sequentially. The rest is split into byte ranges that
+       * start directly behind a clause terminating 0, every range is parsed into its own buffer by its own thread
+       * and the buffers and variable statistics are then joined in the original clause order.
+       */
+      bool parseParallel(const char* begin, const char* end, unsigned threads);
+
+      /**
+       * @brief To call after the last block was parsed, terminates an unfinished last clause
+       *
+       * @return bool True on success
+       */
+      bool finish();
+
+      /**
+       * @brief Returns whether a problem line was read
+       *
+       * @return bool True if a problem line was read
+       */
+      bool hasProblemLine() const;
+
+      /**
+       * @brief Get the number of variables given in the problem line
+       *
+       * @return unsigned The number of variables in the problem line
+       */
+      unsigned getHeaderVariables() const;
+
+      /**
+       * @brief Get the number of clauses given in the problem line
+       *
+       * @return unsigned The number of clauses in the problem line
+       */
+      unsigned getHeaderClauses() const;
+
+      /**
+       * @brief Get the parsed literals, every clause is terminated by a 0
+       *
+       * @return cnf::Literals& The literal buffer, may be moved from
+       */
+      cnf::Literals& getLiterals();
+
+      /**
+       * @brief Get the number of parsed clauses
+       *
+       * @return unsigned The number of clauses that were read
+       */
+      unsigned getClauses() const;
+
+      /**
+       * @brief Get the maximum variable that was read
+       *
+       * @return unsigned The maximum variable
+       */
+      unsigned getMaxVariable() const;
+
+      /**
+       * @brief Get the number of distinct variables that were read
+       *
+       * @return unsigned The number of variables occurring at least once
+       */
+      unsigned getVariables() const;
+
+      /**
+       * @brief Get how often every variable occurred in the input
+       *
+       * @return const std::vector<unsigned>& The occurrence counts, the nth entry belongs to variable n
+       */
+      const std::vector<unsigned>& getVariableOccurrences() const;
+
+   protected:
+
+      /**
+       * @brief Parses the problem line starting at p and moves p to the end of that line
+       *
+       * @param p The start of the problem line, will point behind it afterwards
+       * @param end The end of the current block
+       * @return bool True if the line was a valid problem line
+       */
+      bool parseProblemLine(const char*& p, const char* end);
+
+      /**
+       * @brief Terminates the open clause with a 0, normalizing it first if requested
+       *
+       */
+      void terminateClause();
+
+   private:
+
+      /**
+       * @brief The number of bytes the input is expected to have, 0 if unknown
+       *
+       */
+      std::size_t sizeHint;
+
+      /**
+       * @brief True if every clause is sorted and freed of duplicate literals when it is terminated
+       *
+       */
+      bool normalizeClauses;
+
+      /**
+       * @brief All literals read so far, every clause terminated by a 0
+       *
+       */
+      cnf::Literals literals;
+
+      /**
+       * @brief Number of terminated clauses in literals
+       *
+       */
+      unsigned clauses = 0;
+
+      /**
+       * @brief Position of the first literal of the open clause in literals
+       *
+       */
+      std::size_t clauseStart = 0;
+
+      /**
+       * @brief The maximum variable read so far
+       *
+       */
+      unsigned maxVariable = 0;
+
+      /**
+       * @brief How often every variable was read, the nth entry belongs to variable n
+       *
+       */
+      std::vector<unsigned> variableOccurrences;
+
+      /**
+       * @brief True if literals were read after the last terminating 0
+       *
+       */
+      bool clauseOpen = false;
+
+      /**
+       * @brief True once the problem line was read
+       *
+       */
+      bool problemLineFound = false;
+
+      /**
+       * @brief The number of variables stated in the problem line
+       *
+       */
+      unsigned headerVariables = 0;
+
+      /**
+       * @brief The number of clauses stated in the problem line
+       *
+       */
+      unsigned headerClauses = 0;
+
+      /**
+       * @brief True when a '%' line was read. Some benchmark sets use it to mark the end of the formula
+       *
+       */
+      bool endReached = false;
+
+   };
+
+}
@@ -0,0 +1,235 @@
+/**
+ * @file DimacsWriter.cpp
+ * @author Anton Reinhard
+ * @brief Buffered DIMACS cnf writer implementation
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "DimacsWriter.h"
+#include "../CNF.h"
+#include "../Utility.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <thread>
+
+namespace preppy::io {
+
+   namespace {
+
+      /**
+       * @brief The maximum number of characters a literal and its separator take, "-2147483648 "
+       *
+       */
+      constexpr std::size_t maxLiteralLength = 12;
+
+      /**
+       * @brief The number of clauses a thread formats at once when writing with multiple threads
+       *
+       */
+      constexpr std::size_t clausesPerBatch = 1 << 15;
+
+      /**
+       * @brief Upper bound for the number of characters a clause with the given number of literals takes as a cnf line
+       */
+      inline std::size_t maxLineLength(const std::size_t literals) {
+         return (literals + 1) * maxLiteralLength;
+      }
+
+      /**
+       * @brief Formats the literals [first, last) as a 0 terminated cnf line into out, which has to have room for
+       * maxLineLength characters
+       *
+       * @return char* One past the last written character
+       */
+      inline char* formatClause(const int* first, const int* last, char* out) {
+         for (; first != last; ++first) {
+            out = std::to_chars(out, out + maxLiteralLength, *first).ptr;
+            *out++ = ' ';
+         }
+         *out++ = '0';
+         *out++ = '\n';
+         return out;
+      }
+
+      /**
+       * @brief Formats the clauses [first, last) into the given buffer, replacing its content
+       */
+      void formatBatch(const cnf::CNF& clauses, const std::size_t first, const std::size_t last, std::vector<char>& out) {
+         std::size_t length = 0;
+         for (std::size_t i = first; i < last; ++i) {
+            length += maxLineLength(clauses[i].size());
+         }
+         out.resize(length);
+
+         char* position = out.data();
+         for (std::size_t i = first; i < last; ++i) {
+            const cnf::ClauseView clause = clauses[i];
+            position = formatClause(clause.begin(), clause.end(), position);
+         }
+         out.resize(static_cast<std::size_t>(position - out.data()));
+      }
+
+   }
+
+   DimacsWriter::DimacsWriter(const std::size_t bufferSize, const unsigned threads)
+      : buffer(std::max<std::size_t>(bufferSize, 64 * maxLiteralLength))
+      , threads(std::max(1u, threads)) {
+
+   }
+
+   DimacsWriter::~DimacsWriter() {
+      this->close();
+   }
+
+   bool DimacsWriter::open(const std::string& filepath) {
+      this->close();
+
+      this->descriptor = ::open(filepath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      this->used = 0;
+      this->writeFailed = false;
+      return this->descriptor >= 0;
+   }
+
+   bool DimacsWriter::openStandardOutput() {
+      this->close();
+
+      // write to a duplicate, so closing it doesn't close the standard output of the process
+      this->descriptor = ::dup(STDOUT_FILENO);
+      this->used = 0;
+      this->writeFailed = false;
+      return this->descriptor >= 0;
+   }
+
+   bool DimacsWriter::write(const std::string& text) {
+      if (text.size() > this->buffer.size() - this->used) {
+         if (!this->flush()) {
+            return false;
+         }
+         if (text.size() > this->buffer.size()) {
+            return this->writeRaw(text.data(), text.size());
+         }
+      }
+
+      std::memcpy(this->buffer.data() + this->used, text.data(), text.size());
+      this->used += text.size();
+      return !this->writeFailed;
+   }
+
+   bool DimacsWriter::writeClause(const cnf::Clause& clause) {
+      return this->writeLiterals(clause.data(), clause.data() + clause.size());
+   }
+
+   bool DimacsWriter::writeLiterals(const int* first, const int* last) {
+      const std::size_t length = maxLineLength(static_cast<std::size_t>(last - first));
+      if (length > this->buffer.size() - this->used) {
+         if (!this->flush()) {
+            return false;
+         }
+         if (length > this->buffer.size()) {
+            // a single huge clause, grow the buffer instead of splitting the line
+            this->buffer.resize(length);
+         }
+      }
+
+      char* end = formatClause(first, last, this->buffer.data() + this->used);
+      this->used = static_cast<std::size_t>(end - this->buffer.data());
+      return !this->writeFailed;
+   }
+
+   bool DimacsWriter::writeClauses(const cnf::CNF& clauses) {
+      if (this->threads <= 1 || clauses.size() < 2 * clausesPerBatch) {
+         for (const auto& clause : clauses) {
+            if (!this->writeLiterals(clause.begin(), clause.end())) {
+               return false;
+            }
+         }
+         return true;
+      }
+
+      if (!this->flush()) {
+         return false;
+      }
+
+      std::vector<std::vector<char>> batches(this->threads);
+      std::vector<std::thread> workers;
+      workers.reserve(this->threads - 1);
+
+      // every round formats one batch per thread, then writes the batches in order
+      for (std::size_t roundStart = 0; roundStart < clauses.size(); roundStart += this->threads * clausesPerBatch) {
+         const std::size_t roundEnd = std::min(clauses.size(), roundStart + this->threads * clausesPerBatch);
+         const unsigned roundBatches = static_cast<unsigned>((roundEnd - roundStart + clausesPerBatch - 1) / clausesPerBatch);
+
+         workers.clear();
+         for (unsigned i = 1; i < roundBatches; ++i) {
+            const std::size_t first = roundStart + i * clausesPerBatch;
+            workers.emplace_back(formatBatch, std::cref(clauses), first, std::min(roundEnd, first + clausesPerBatch), std::ref(batches[i]));
+         }
+         formatBatch(clauses, roundStart, std::min(roundEnd, roundStart + clausesPerBatch), batches[0]);
+         for (auto& worker : workers) {
+            worker.join();
+         }
+
+         for (unsigned i = 0; i < roundBatches; ++i) {
+            if (!this->writeRaw(batches[i].data(), batches[i].size())) {
+               return false;
+            }
+         }
+      }
+
+      return true;
+   }
+
+   bool DimacsWriter::close() {
+      if (this->descriptor < 0) {
+         return !this->writeFailed;
+      }
+
+      this->flush();
+      if (::close(this->descriptor) != 0) {
+         this->writeFailed = true;
+      }
+      this->descriptor = -1;
+
+      if (this->writeFailed) {
+         util::Utility::logError("Couldn't write cnf output: ", std::strerror(errno));
+      }
+      return !this->writeFailed;
+   }
+
+   bool DimacsWriter::flush() {
+      const bool success = this->writeRaw(this->buffer.data(), this->used);
+      this->used = 0;
+      return success;
+   }
+
+   bool DimacsWriter::writeRaw(const char* data, std::size_t size) {
+      if (this->writeFailed || this->descriptor < 0) {
+         this->writeFailed = true;
+         return false;
+      }
+
+      while (size > 0) {
+         const ssize_t n = ::write(this->descriptor, data, size);
+         if (n < 0) {
+            if (EINTR == errno) {
+               continue;
+            }
+            this->writeFailed = true;
+            return false;
+         }
+         data += n;
+         size -= static_cast<std::size_t>(n);
+      }
+      return true;
+   }
+
+}
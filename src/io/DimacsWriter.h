@@ -0,0 +1,161 @@
+/**
+ * @file DimacsWriter.h
+ * @author Anton Reinhard
+ * @brief Buffered DIMACS cnf writer header
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include "../definitions.h"
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace preppy::cnf {
+   class CNF;
+}
+
+namespace preppy::io {
+
+   /**
+    * @brief Writes DIMACS cnf text to a file, formatting the literals directly into a large reusable buffer that
+    * is written out in big blocks
+    *
+    * @details Clauses can optionally be formatted by several threads. The clauses are then split into rounds of
+    * consecutive batches, every batch is formatted into its own buffer and the buffers are written in order, so
+    * the output is identical to the single threaded one.
+    */
+   class DimacsWriter {
+   public:
+
+      /**
+       * @brief Construct a new DimacsWriter
+       *
+       * @param bufferSize The size of the output buffer in bytes
+       * @param threads The number of threads to format clauses with
+       */
+      DimacsWriter(std::size_t bufferSize = 1 << 20, unsigned threads = 1);
+
+      /**
+       * @brief Flushes the buffer and closes the file if it is still open
+       *
+       */
+      ~DimacsWriter();
+
+      DimacsWriter(const DimacsWriter&) = delete;
+      DimacsWriter& operator=(const DimacsWriter&) = delete;
+
+      /**
+       * @brief Creates or truncates the given file for writing
+       *
+       * @param filepath The file to write to
+       * @return bool True on success
+       */
+      bool open(const std::string& filepath);
+
+      /**
+       * @brief Writes to the standard output instead of a file
+       *
+       * @return bool True on success
+       */
+      bool openStandardOutput();
+
+      /**
+       * @brief Writes text as it is, e.g. comment or problem lines
+       *
+       * @param text The text to write
+       * @return bool True on success
+       */
+      bool write(const std::string& text);
+
+      /**
+       * @brief Writes a single clause as a 0 terminated line
+       *
+       * @param clause The clause to write
+       * @return bool True on success
+       */
+      bool writeClause(const cnf::Clause& clause);
+
+      /**
+       * @brief Writes all clauses of a formula in order, using the configured number of threads
+       *
+       * @param formula The formula whose clauses are written
+       * @return bool True on success
+       */
+      bool writeClauses(const cnf::CNF& formula);
+
+      /**
+       * @brief Flushes the buffer and closes the file
+       *
+       * @return bool True if everything was written successfully
+       */
+      bool close();
+
+   protected:
+
+      /**
+       * @brief Writes the buffer to the file and empties it
+       *
+       * @return bool True on success
+       */
+      bool flush();
+
+      /**
+       * @brief Writes the literals [first, last) as a single 0 terminated line
+       *
+       * @param first Pointer to the first literal
+       * @param last Pointer behind the last literal
+       * @return bool True on success
+       */
+      bool writeLiterals(const int* first, const int* last);
+
+      /**
+       * @brief Writes raw bytes to the file, bypassing the buffer
+       *
+       * @param data The bytes to write
+       * @param size The number of bytes
+       * @return bool True on success
+       */
+      bool writeRaw(const char* data, std::size_t size);
+
+   private:
+
+      /**
+       * @brief The output buffer
+       *
+       */
+      std::vector<char> buffer;
+
+      /**
+       * @brief Number of used bytes in the output buffer
+       *
+       */
+      std::size_t used = 0;
+
+      /**
+       * @brief The number of threads to format clauses with
+       *
+       */
+      unsigned threads;
+
+      /**
+       * @brief The file descriptor that is written to, -1 if none
+       *
+       */
+      int descriptor = -1;
+
+      /**
+       * @brief Set once a write failed, every further write is skipped
+       *
+       */
+      bool writeFailed = false;
+
+   };
+
+}
@@ -0,0 +1,80 @@
+/**
+ * @file MappedFile.cpp
+ * @author Anton Reinhard
+ * @brief Read-only memory mapped file implementation
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "MappedFile.h"
+#include "../Utility.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace preppy::io {
+
+   MappedFile::~MappedFile() {
+      this->close();
+   }
+
+   bool MappedFile::open(const std::string& filepath) {
+      this->close();
+
+      this->fileDescriptor = ::open(filepath.c_str(), O_RDONLY);
+      if (this->fileDescriptor < 0) {
+         return false;
+      }
+
+      struct stat fileStat;
+      if (fstat(this->fileDescriptor, &fileStat) != 0) {
+         this->close();
+         return false;
+      }
+
+      this->length = static_cast<std::size_t>(fileStat.st_size);
+      if (this->length == 0) {
+         // mapping zero bytes is not allowed, an empty file simply has no data
+         return true;
+      }
+
+      this->mapping = mmap(nullptr, this->length, PROT_READ, MAP_PRIVATE, this->fileDescriptor, 0);
+      if (MAP_FAILED == this->mapping) {
+         util::Utility::logError("Couldn't map file ", filepath, " into memory");
+         this->mapping = nullptr;
+         this->close();
+         return false;
+      }
+
+      // the file is parsed front to back exactly once
+      madvise(this->mapping, this->length, MADV_SEQUENTIAL);
+
+      return true;
+   }
+
+   void MappedFile::close() {
+      if (nullptr != this->mapping) {
+         munmap(this->mapping, this->length);
+         this->mapping = nullptr;
+      }
+      if (this->fileDescriptor >= 0) {
+         ::close(this->fileDescriptor);
+         this->fileDescriptor = -1;
+      }
+      this->length = 0;
+   }
+
+   const char* MappedFile::data() const {
+      return static_cast<const char*>(this->mapping);
+   }
+
+   std::size_t MappedFile::size() const {
+      return this->length;
+   }
+
+}
@@ -0,0 +1,94 @@
+/**
+ * @file MappedFile.h
+ * @author Anton Reinhard
+ * @brief Read-only memory mapped file header
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+namespace preppy::io {
+
+   /**
+    * @brief A file mapped read-only into memory, so it can be parsed in place without copying it into streams
+    *
+    */
+   class MappedFile {
+   public:
+
+      /**
+       * @brief Construct an empty, unopened MappedFile
+       *
+       */
+      MappedFile() = default;
+
+      /**
+       * @brief Unmaps and closes the file if it is still open
+       *
+       */
+      ~MappedFile();
+
+      MappedFile(const MappedFile&) = delete;
+      MappedFile& operator=(const MappedFile&) = delete;
+
+      /**
+       * @brief Opens and maps the file at the given path
+       *
+       * @param filepath The path of the file to map
+       * @return bool True on success
+       */
+      bool open(const std::string& filepath);
+
+      /**
+       * @brief Unmaps and closes the file
+       *
+       */
+      void close();
+
+      /**
+       * @brief Get a pointer to the first byte of the mapped file
+       *
+       * @return const char* The start of the file's content, nullptr if the file is empty or not open
+       */
+      const char* data() const;
+
+      /**
+       * @brief Get the size of the mapped file
+       *
+       * @return std::size_t The number of bytes in the file
+       */
+      std::size_t size() const;
+
+   protected:
+
+
+   private:
+
+      /**
+       * @brief The file descriptor of the opened file, -1 if no file is open
+       *
+       */
+      int fileDescriptor = -1;
+
+      /**
+       * @brief The start of the mapping
+       *
+       */
+      void* mapping = nullptr;
+
+      /**
+       * @brief The length of the mapping in bytes
+       *
+       */
+      std::size_t length = 0;
+
+   };
+
+}
@@ -0,0 +1,604 @@
+/**
+ * @file StreamingInput.cpp
+ * @author Anton Reinhard
+ * @brief Streaming, optionally decompressing input implementation
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "StreamingInput.h"
+#include "../Utility.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <cstdint>
+
+#ifdef PREPPY_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef PREPPY_HAVE_LZMA
+#include <lzma.h>
+#endif
+#ifdef PREPPY_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace preppy::io {
+
+   namespace {
+
+      /**
+       * @brief The number of bytes needed to recognize every supported format
+       *
+       */
+      constexpr std::size_t magicSize = 6;
+
+      COMPRESSION detectCompression(const unsigned char* magic, const std::size_t size) {
+         if (size >= 2 && 0x1f == magic[0] && 0x8b == magic[1]) {
+            return COMPRESSION::GZIP;
+         }
+         if (size >= 6 && 0xfd == magic[0] && '7' == magic[1] && 'z' == magic[2] && 'X' == magic[3] && 'Z' == magic[4] && 0x00 == magic[5]) {
+            return COMPRESSION::XZ;
+         }
+         if (size >= 4 && 0x28 == magic[0] && 0xb5 == magic[1] && 0x2f == magic[2] && 0xfd == magic[3]) {
+            return COMPRESSION::ZSTD;
+         }
+         return COMPRESSION::NONE;
+      }
+
+      /**
+       * @brief Reads up to size bytes, retrying on interrupts and short reads
+       *
+       * @return long The number of bytes read, -1 on error
+       */
+      long readFully(const int descriptor, char* buffer, const std::size_t size) {
+         std::size_t total = 0;
+         while (total < size) {
+            const ssize_t n = ::read(descriptor, buffer + total, size - total);
+            if (n < 0) {
+               if (EINTR == errno) {
+                  continue;
+               }
+               return -1;
+            }
+            if (0 == n) {
+               break;
+            }
+            total += static_cast<std::size_t>(n);
+         }
+         return static_cast<long>(total);
+      }
+
+   }
+
+   /**
+    * @brief Produces the (decompressed) content of an input file descriptor
+    *
+    */
+   class Decoder {
+   public:
+
+      /**
+       * @param descriptor The descriptor to read from
+       * @param prefix The bytes that were already read from the descriptor
+       */
+      Decoder(const int descriptor, std::vector<char> prefix)
+         : descriptor(descriptor)
+         , prefix(std::move(prefix)) {
+      }
+
+      virtual ~Decoder() = default;
+
+      /**
+       * @brief Writes the next bytes of the input to out
+       *
+       * @return long The number of bytes written, 0 at the end of the input, -1 on error
+       */
+      virtual long decode(char* out, std::size_t capacity) = 0;
+
+   protected:
+
+      /**
+       * @brief Reads raw bytes from the input, starting with the already read prefix
+       *
+       * @return long The number of bytes read, 0 at the end of the input, -1 on error
+       */
+      long readRaw(char* out, const std::size_t capacity) {
+         if (this->prefixPosition < this->prefix.size()) {
+            const std::size_t n = std::min(capacity, this->prefix.size() - this->prefixPosition);
+            std::memcpy(out, this->prefix.data() + this->prefixPosition, n);
+            this->prefixPosition += n;
+            return static_cast<long>(n);
+         }
+         return readFully(this->descriptor, out, capacity);
+      }
+
+      /**
+       * @brief Size of the compressed input buffer of the decompressing decoders
+       *
+       */
+      static constexpr std::size_t inputBufferSize = 1 << 18;
+
+   private:
+
+      int descriptor;
+      std::vector<char> prefix;
+      std::size_t prefixPosition = 0;
+
+   };
+
+   namespace {
+
+      class PlainDecoder
+         : public Decoder {
+      public:
+
+         using Decoder::Decoder;
+
+         long decode(char* out, const std::size_t capacity) override {
+            return this->readRaw(out, capacity);
+         }
+
+      };
+
+#ifdef PREPPY_HAVE_ZLIB
+      class GzipDecoder
+         : public Decoder {
+      public:
+
+         GzipDecoder(const int descriptor, std::vector<char> prefix)
+            : Decoder(descriptor, std::move(prefix))
+            , input(inputBufferSize) {
+            // 15 window bits + 32 = detect gzip or zlib header automatically
+            this->initialized = (Z_OK == inflateInit2(&this->stream, 15 + 32));
+         }
+
+         ~GzipDecoder() override {
+            if (this->initialized) {
+               inflateEnd(&this->stream);
+            }
+         }
+
+         long decode(char* out, const std::size_t capacity) override {
+            if (!this->initialized) {
+               return -1;
+            }
+
+            this->stream.next_out = reinterpret_cast<Bytef*>(out);
+            this->stream.avail_out = static_cast<uInt>(capacity);
+
+            while (this->stream.avail_out > 0) {
+               if (0 == this->stream.avail_in && !this->inputEnded) {
+                  const long n = this->readRaw(this->input.data(), this->input.size());
+                  if (n < 0) {
+                     return -1;
+                  }
+                  this->inputEnded = (0 == n);
+                  this->stream.next_in = reinterpret_cast<Bytef*>(this->input.data());
+                  this->stream.avail_in = static_cast<uInt>(n);
+               }
+
+               if (this->memberEnded) {
+                  if (0 == this->stream.avail_in) {
+                     if (this->inputEnded) {
+                        break;
+                     }
+                     continue;
+                  }
+                  // gzip files may consist of several concatenated members
+                  if (Z_OK != inflateReset(&this->stream)) {
+                     return -1;
+                  }
+                  this->memberEnded = false;
+               }
+
+               if (0 == this->stream.avail_in && this->inputEnded) {
+                  util::Utility::logError("Unexpected end of gzip compressed input");
+                  return -1;
+               }
+
+               const int result = inflate(&this->stream, Z_NO_FLUSH);
+               if (Z_STREAM_END == result) {
+                  this->memberEnded = true;
+               }
+               else if (Z_OK != result) {
+                  util::Utility::logError("Couldn't decompress gzip input: ", (nullptr != this->stream.msg) ? this->stream.msg : "unknown error");
+                  return -1;
+               }
+            }
+
+            return static_cast<long>(capacity - this->stream.avail_out);
+         }
+
+      private:
+
+         z_stream stream = {};
+         std::vector<char> input;
+         bool initialized = false;
+         bool inputEnded = false;
+         bool memberEnded = false;
+
+      };
+#endif
+
+#ifdef PREPPY_HAVE_LZMA
+      class XzDecoder
+         : public Decoder {
+      public:
+
+         XzDecoder(const int descriptor, std::vector<char> prefix)
+            : Decoder(descriptor, std::move(prefix))
+            , input(inputBufferSize) {
+            this->initialized = (LZMA_OK == lzma_stream_decoder(&this->stream, UINT64_MAX, LZMA_CONCATENATED));
+         }
+
+         ~XzDecoder() override {
+            lzma_end(&this->stream);
+         }
+
+         long decode(char* out, const std::size_t capacity) override {
+            if (!this->initialized) {
+               return -1;
+            }
+
+            this->stream.next_out = reinterpret_cast<uint8_t*>(out);
+            this->stream.avail_out = capacity;
+
+            while (this->stream.avail_out > 0 && !this->streamEnded) {
+               if (0 == this->stream.avail_in && !this->inputEnded) {
+                  const long n = this->readRaw(this->input.data(), this->input.size());
+                  if (n < 0) {
+                     return -1;
+                  }
+                  this->inputEnded = (0 == n);
+                  this->stream.next_in = reinterpret_cast<const uint8_t*>(this->input.data());
+                  this->stream.avail_in = static_cast<std::size_t>(n);
+               }
+
+               const lzma_ret result = lzma_code(&this->stream, this->inputEnded ? LZMA_FINISH : LZMA_RUN);
+               if (LZMA_STREAM_END == result) {
+                  this->streamEnded = true;
+               }
+               else if (LZMA_OK != result) {
+                  util::Utility::logError("Couldn't decompress xz input, error code ", static_cast<int>(result));
+                  return -1;
+               }
+            }
+
+            return static_cast<long>(capacity - this->stream.avail_out);
+         }
+
+      private:
+
+         lzma_stream stream = LZMA_STREAM_INIT;
+         std::vector<char> input;
+         bool initialized = false;
+         bool inputEnded = false;
+         bool streamEnded = false;
+
+      };
+#endif
+
+#ifdef PREPPY_HAVE_ZSTD
+      class ZstdDecoder
+         : public Decoder {
+      public:
+
+         ZstdDecoder(const int descriptor, std::vector<char> prefix)
+            : Decoder(descriptor, std::move(prefix))
+            , input(inputBufferSize)
+            , stream(ZSTD_createDStream()) {
+            if (nullptr != this->stream) {
+               ZSTD_initDStream(this->stream);
+            }
+         }
+
+         ~ZstdDecoder() override {
+            ZSTD_freeDStream(this->stream);
+         }
+
+         long decode(char* out, const std::size_t capacity) override {
+            if (nullptr == this->stream) {
+               return -1;
+            }
+
+            ZSTD_outBuffer output = { out, capacity, 0 };
+            while (output.pos < output.size) {
+               if (this->inputBuffer.pos == this->inputBuffer.size) {
+                  if (this->inputEnded) {
+                     break;
+                  }
+                  const long n = this->readRaw(this->input.data(), this->input.size());
+                  if (n < 0) {
+                     return -1;
+                  }
+                  if (0 == n) {
+                     this->inputEnded = true;
+                     if (0 != this->lastResult) {
+                        util::Utility::logError("Unexpected end of zstd compressed input");
+                        return -1;
+                     }
+                     break;
+                  }
+                  this->inputBuffer = { this->input.data(), static_cast<std::size_t>(n), 0 };
+               }
+
+               this->lastResult = ZSTD_decompressStream(this->stream, &output, &this->inputBuffer);
+               if (ZSTD_isError(this->lastResult)) {
+                  util::Utility::logError("Couldn't decompress zstd input: ", ZSTD_getErrorName(this->lastResult));
+                  return -1;
+               }
+            }
+
+            return static_cast<long>(output.pos);
+         }
+
+      private:
+
+         std::vector<char> input;
+         ZSTD_DStream* stream;
+         ZSTD_inBuffer inputBuffer = { nullptr, 0, 0 };
+         std::size_t lastResult = 0;
+         bool inputEnded = false;
+
+      };
+#endif
+
+   }
+
+   COMPRESSION detectCompression(const std::string& filepath) {
+      const int descriptor = ::open(filepath.c_str(), O_RDONLY);
+      if (descriptor < 0) {
+         return COMPRESSION::NONE;
+      }
+
+      char magic[magicSize];
+      const long n = readFully(descriptor, magic, magicSize);
+      ::close(descriptor);
+
+      if (n <= 0) {
+         return COMPRESSION::NONE;
+      }
+      return detectCompression(reinterpret_cast<const unsigned char*>(magic), static_cast<std::size_t>(n));
+   }
+
+   std::string compressionToString(const COMPRESSION compression) {
+      switch (compression) {
+      case COMPRESSION::NONE:
+         return "uncompressed";
+      case COMPRESSION::GZIP:
+         return "gzip";
+      case COMPRESSION::XZ:
+         return "xz";
+      case COMPRESSION::ZSTD:
+         return "zstd";
+      default:
+         return "unknown compression";
+      }
+   }
+
+   StreamingInput::StreamingInput(const std::size_t blockSize, const std::size_t blocks)
+      : blockSize(blockSize)
+      , ring(std::max<std::size_t>(blocks, 2)) {
+
+   }
+
+   StreamingInput::~StreamingInput() {
+      {
+         std::lock_guard<std::mutex> lock(this->mutex);
+         this->stopRequested = true;
+      }
+      this->blockChanged.notify_all();
+
+      if (this->producer.joinable()) {
+         this->producer.join();
+      }
+      if (this->descriptor >= 0) {
+         ::close(this->descriptor);
+      }
+   }
+
+   bool StreamingInput::open(const std::string& filepath) {
+      const int descriptor = ::open(filepath.c_str(), O_RDONLY);
+      if (descriptor < 0) {
+         return false;
+      }
+      return this->start(descriptor);
+   }
+
+   bool StreamingInput::openStandardInput() {
+      // read from a duplicate, so closing it doesn't close the standard input of the process
+      const int descriptor = ::dup(STDIN_FILENO);
+      if (descriptor < 0) {
+         return false;
+      }
+      return this->start(descriptor);
+   }
+
+   bool StreamingInput::start(const int descriptor) {
+      this->descriptor = descriptor;
+
+      // read the magic bytes, they are handed to the decoder afterwards since the input might not be seekable
+      std::vector<char> prefix(magicSize);
+      const long n = readFully(descriptor, prefix.data(), prefix.size());
+      if (n < 0) {
+         util::Utility::logError("Couldn't read input");
+         return false;
+      }
+      prefix.resize(static_cast<std::size_t>(n));
+      this->compression = detectCompression(reinterpret_cast<const unsigned char*>(prefix.data()), prefix.size());
+
+      switch (this->compression) {
+      case COMPRESSION::NONE:
+         this->decoder = std::make_unique<PlainDecoder>(descriptor, std::move(prefix));
+         break;
+#ifdef PREPPY_HAVE_ZLIB
+      case COMPRESSION::GZIP:
+         this->decoder = std::make_unique<GzipDecoder>(descriptor, std::move(prefix));
+         break;
+#endif
+#ifdef PREPPY_HAVE_LZMA
+      case COMPRESSION::XZ:
+         this->decoder = std::make_unique<XzDecoder>(descriptor, std::move(prefix));
+         break;
+#endif
+#ifdef PREPPY_HAVE_ZSTD
+      case COMPRESSION::ZSTD:
+         this->decoder = std::make_unique<ZstdDecoder>(descriptor, std::move(prefix));
+         break;
+#endif
+      default:
+         util::Utility::logError("The input is ", compressionToString(this->compression), " compressed, but preppy was built without support for it");
+         return false;
+      }
+
+      util::Utility::logDebug("Reading ", compressionToString(this->compression), " input");
+
+      for (auto& block : this->ring) {
+         block.data.resize(this->blockSize);
+      }
+      this->producer = std::thread(&StreamingInput::produce, this);
+
+      return true;
+   }
+
+   void StreamingInput::produce() {
+      while (true) {
+         Block* block;
+         {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->blockChanged.wait(lock, [this]() {
+               return this->stopRequested || !this->ring[this->produceIndex].filled;
+            });
+            if (this->stopRequested) {
+               return;
+            }
+            block = &this->ring[this->produceIndex];
+         }
+
+         // the block is owned by this thread until it is marked as filled
+         bool inputEnded = false;
+         bool error = false;
+         block->size = 0;
+         while (block->size < this->blockSize) {
+            const long n = this->decoder->decode(block->data.data() + block->size, this->blockSize - block->size);
+            if (n < 0) {
+               error = true;
+               break;
+            }
+            if (0 == n) {
+               inputEnded = true;
+               break;
+            }
+            block->size += static_cast<std::size_t>(n);
+         }
+
+         {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            block->filled = true;
+            this->produceIndex = (this->produceIndex + 1) % this->ring.size();
+            this->inputFailed = error;
+            this->inputFinished = inputEnded || error;
+         }
+         this->blockChanged.notify_all();
+
+         if (inputEnded || error) {
+            return;
+         }
+      }
+   }
+
+   void StreamingInput::releaseHeldBlock() {
+      {
+         std::lock_guard<std::mutex> lock(this->mutex);
+         this->ring[this->consumeIndex].filled = false;
+         this->consumeIndex = (this->consumeIndex + 1) % this->ring.size();
+         this->holdingBlock = false;
+      }
+      this->blockChanged.notify_all();
+   }
+
+   bool StreamingInput::nextBlock(const char*& begin, const char*& end) {
+      if (!this->producer.joinable()) {
+         return false;
+      }
+
+      while (true) {
+         if (this->holdingBlock) {
+            const Block& block = this->ring[this->consumeIndex];
+            const char* position = block.data.data() + this->heldPosition;
+            const char* blockEnd = block.data.data() + block.size;
+
+            if (position != blockEnd) {
+               if (this->carry.empty()) {
+                  // hand out everything up to the last line break in place
+                  const char* lastLineEnd = static_cast<const char*>(memrchr(position, '\n', blockEnd - position));
+                  const char* completeEnd = (nullptr == lastLineEnd) ? position : lastLineEnd + 1;
+                  this->carry.assign(completeEnd, blockEnd);
+                  this->heldPosition = block.size;
+                  if (completeEnd != position) {
+                     begin = position;
+                     end = completeEnd;
+                     return true;
+                  }
+                  continue;
+               }
+
+               // complete the line that was started in a previous block
+               const char* firstLineEnd = static_cast<const char*>(std::memchr(position, '\n', blockEnd - position));
+               const char* appendEnd = (nullptr == firstLineEnd) ? blockEnd : firstLineEnd + 1;
+               this->carry.insert(this->carry.end(), position, appendEnd);
+               this->heldPosition = appendEnd - block.data.data();
+               if (nullptr != firstLineEnd) {
+                  this->joined.swap(this->carry);
+                  this->carry.clear();
+                  begin = this->joined.data();
+                  end = this->joined.data() + this->joined.size();
+                  return true;
+               }
+               continue;
+            }
+
+            this->releaseHeldBlock();
+         }
+
+         {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->blockChanged.wait(lock, [this]() {
+               return this->ring[this->consumeIndex].filled || this->inputFinished;
+            });
+            if (!this->ring[this->consumeIndex].filled) {
+               break;
+            }
+         }
+         this->holdingBlock = true;
+         this->heldPosition = 0;
+      }
+
+      // the last line doesn't have to end with a line break
+      if (!this->carry.empty() && !this->inputFailed) {
+         this->joined.swap(this->carry);
+         this->carry.clear();
+         begin = this->joined.data();
+         end = this->joined.data() + this->joined.size();
+         return true;
+      }
+
+      return false;
+   }
+
+   bool StreamingInput::failed() const {
+      return this->inputFailed;
+   }
+
+   COMPRESSION StreamingInput::getCompression() const {
+      return this->compression;
+   }
+
+}
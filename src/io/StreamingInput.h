@@ -0,0 +1,259 @@
+/**
+ * @file StreamingInput.h
+ * @author Anton Reinhard
+ * @brief Streaming, optionally decompressing input header
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include "../definitions.h"
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <cstddef>
+
+namespace preppy::io {
+
+   class Decoder;
+
+   /**
+    * @brief Compression formats that can be read
+    *
+    */
+   enum class COMPRESSION {
+      NONE  = 0,
+      GZIP  = 1,
+      XZ    = 2,
+      ZSTD  = 3
+   };
+
+   /**
+    * @brief Detects the compression format of a file from its magic bytes
+    *
+    * @param filepath The file to check
+    * @return COMPRESSION The compression of the file, NONE if it isn't compressed or can't be read
+    */
+   COMPRESSION detectCompression(const std::string& filepath);
+
+   /**
+    * @brief Convert a COMPRESSION from enum to a string
+    *
+    * @param compression The compression to convert
+    * @return std::string The resulting string
+    */
+   std::string compressionToString(COMPRESSION compression);
+
+   /**
+    * @brief Reads an input file as a sequence of text blocks that contain only complete lines, decompressing it on the fly
+    *
+    * @details The compression is detected from the magic bytes at the start of the input. A background thread reads
+    * and decompresses the input into a ring of fixed size blocks, so decompression and parsing of the previous block
+    * run at the same time and memory use stays bounded, regardless of the size of the input. Blocks are handed out
+    * in place, only a line that is split between two blocks is copied.
+    */
+   class StreamingInput {
+   public:
+
+      /**
+       * @brief Construct a new StreamingInput
+       *
+       * @param blockSize The size of a single block in bytes
+       * @param blocks The number of blocks in the ring buffer
+       */
+      StreamingInput(std::size_t blockSize = 1 << 20, std::size_t blocks = 4);
+
+      /**
+       * @brief Stops the background thread and closes the input
+       *
+       */
+      ~StreamingInput();
+
+      StreamingInput(const StreamingInput&) = delete;
+      StreamingInput& operator=(const StreamingInput&) = delete;
+
+      /**
+       * @brief Opens the given file and starts reading it in the background
+       *
+       * @param filepath The file to read
+       * @return bool True on success
+       */
+      bool open(const std::string& filepath);
+
+      /**
+       * @brief Starts reading the standard input in the background
+       *
+       * @return bool True on success
+       */
+      bool openStandardInput();
+
+      /**
+       * @brief Get the next block of complete lines. The block stays valid until the next call
+       *
+       * @param begin Will point to the start of the block
+       * @param end Will point behind the end of the block
+       * @return bool True if there was another block, False at the end of the input or on error
+       */
+      bool nextBlock(const char*& begin, const char*& end);
+
+      /**
+       * @brief Returns whether reading or decompressing the input failed
+       *
+       * @return bool True if an error occurred
+       */
+      bool failed() const;
+
+      /**
+       * @brief Get the compression of the input
+       *
+       * @return COMPRESSION The compression that was detected
+       */
+      COMPRESSION getCompression() const;
+
+   protected:
+
+      /**
+       * @brief Starts reading from an already opened file descriptor
+       *
+       * @param descriptor The file descriptor to read from, will be closed by this object
+       * @return bool True on success
+       */
+      bool start(int descriptor);
+
+      /**
+       * @brief The function run by the background thread, filling the ring buffer block by block
+       *
+       */
+      void produce();
+
+      /**
+       * @brief Gives the currently held block back to the background thread
+       *
+       */
+      void releaseHeldBlock();
+
+   private:
+
+      /**
+       * @brief A block of the ring buffer
+       *
+       */
+      struct Block {
+         std::vector<char> data;
+         std::size_t size = 0;
+         bool filled = false;
+      };
+
+      /**
+       * @brief The size of a single block in bytes
+       *
+       */
+      std::size_t blockSize;
+
+      /**
+       * @brief The ring buffer
+       *
+       */
+      std::vector<Block> ring;
+
+      /**
+       * @brief The file descriptor that is read from, -1 if none
+       *
+       */
+      int descriptor = -1;
+
+      /**
+       * @brief The compression of the input
+       *
+       */
+      COMPRESSION compression = COMPRESSION::NONE;
+
+      /**
+       * @brief The decoder producing the (decompressed) input, only used by the background thread once it runs
+       *
+       */
+      std::unique_ptr<Decoder> decoder;
+
+      /**
+       * @brief The background thread
+       *
+       */
+      std::thread producer;
+
+      /**
+       * @brief Protects the ring buffer state shared with the background thread
+       *
+       */
+      std::mutex mutex;
+
+      /**
+       * @brief Signals changes of the ring buffer state
+       *
+       */
+      std::condition_variable blockChanged;
+
+      /**
+       * @brief Set by the background thread once the whole input was read
+       *
+       */
+      bool inputFinished = false;
+
+      /**
+       * @brief Set by the background thread if an error occurred
+       *
+       */
+      bool inputFailed = false;
+
+      /**
+       * @brief Set when the background thread should stop early
+       *
+       */
+      bool stopRequested = false;
+
+      /**
+       * @brief Index of the block the background thread fills next
+       *
+       */
+      std::size_t produceIndex = 0;
+
+      /**
+       * @brief Index of the block that is read next
+       *
+       */
+      std::size_t consumeIndex = 0;
+
+      /**
+       * @brief True while a block is held by the reader
+       *
+       */
+      bool holdingBlock = false;
+
+      /**
+       * @brief Position in the held block up to which it was handed out
+       *
+       */
+      std::size_t heldPosition = 0;
+
+      /**
+       * @brief The start of a line that was split between blocks
+       *
+       */
+      std::vector<char> carry;
+
+      /**
+       * @brief Buffer for a line that was joined from two blocks, handed out as its own block
+       *
+       */
+      std::vector<char> joined;
+
+   };
+
+}
@@ -15,6 +15,8 @@
 #include "CommandLineParser.h"
 #include "procedures/ProcedureManager.h"
 #include "procedures/BackboneSimplification.h"
+#include "procedures/FailedLiteralProbing.h"
+#include "procedures/HyperBinaryResolution.h"
 #include "procedures/OccurrenceSimplification.h"
 #include "procedures/Vivification.h"
 
@@ -29,21 +31,27 @@ int main(const int argc, char** argv) {
 
    // read formula
    cnf::CNF formula;
-   if (!formula.readFromFile(args.fileIn)) {
+   if (!formula.readFromFile(args.fileIn, args.threads, args.normalize)) {
       return 1;
    }
 
    // setup procedures and apply
    procedures::ProcedureManager manager(args.iterations);
+   if (args.probing) {
+      manager.addOneTimeProcedure(std::make_unique<procedures::FailedLiteralProbing>());
+   }
    manager.addOneTimeProcedure(std::make_unique<procedures::Vivification>());
+   if (args.hyperBinary) {
+      manager.addIterativeProcedure(std::make_unique<procedures::HyperBinaryResolution>());
+   }
    manager.apply(formula);
 
    // output result
    if (args.fileOut.empty()) {
-      formula.writeToFile("output/", args.force);
+      formula.writeToFile("output/", args.force, args.threads, args.binary);
    }
    else {
-      formula.writeToFile(args.fileOut, args.force);
+      formula.writeToFile(args.fileOut, args.force, args.threads, args.binary);
    }
 
    // cleanup
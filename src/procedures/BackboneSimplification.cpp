@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <utility>
 
 namespace preppy::procedures {
 
@@ -53,73 +54,47 @@ namespace preppy::procedures {
 
       util::Utility::startTimer("backbone calculation");
 
-      // create copy of the formula to work on
-      cnf::CNF workingFormula = formula;
+      // the formula is loaded once, every candidate is then checked as an assumption so the solver keeps what it learned
+      this->solver->load(formula);
       cnf::Literals backbone;
 
       // Compute a model
-      cnf::Model startingModel = this->solver->getModel(workingFormula);
+      cnf::Model startingModel = this->solver->solve();
 
       if (startingModel.empty()) {
          // If the formula is unsatisfiable, the backbone is empty
          return {};
       }
 
-      // Convert Model to a literalSet, this will stay uncompressed the entire time
-      cnf::Literals remainingLiterals;
-      for (size_t i = 1; i < startingModel.size(); ++i) {
-         if (startingModel[i]) {
-            remainingLiterals.push_back(i);
-         }
-         else {
-            remainingLiterals.push_back(-i);
-         }
-      }
+      // The variables still assigned in candidates are the possible backbone literals, this will stay uncompressed the entire time
+      cnf::Model candidates = std::move(startingModel);
+      candidates.unassign(0);
 
       size_t i = 0;
 
-      BooleanConstraintPropagation bcp;
-
       // Main loop
-      while (!remainingLiterals.empty()) {
+      for (std::size_t variable = candidates.nextAssigned(1); variable < candidates.size(); variable = candidates.nextAssigned(variable + 1)) {
          ++i;
-         
+
          // currently used literal, compress
-         const int currentLiteral = /*workingFormula.compress*/(remainingLiterals[0]);
+         const int currentLiteral = /*workingFormula.compress*/(candidates[variable] ? static_cast<int>(variable) : -static_cast<int>(variable));
+         candidates.unassign(variable);                                // the literal was tried
+
+         cnf::Model model = this->solver->solve({-currentLiteral});   // assume the negated literal
 
-         workingFormula.push_back(std::make_unique<cnf::Clause>(std::initializer_list<int>({-currentLiteral})));     // add negated literal
-         cnf::Model model = this->solver->getModel(workingFormula);
-         
          if (model.empty()) {
             // if there's no model then the literal is in the backbone
             // use the uncompressed remaining Literal for the backbone
-            backbone.push_back(remainingLiterals[0]);
-            workingFormula.erase(workingFormula.end());                       // remove last clause again
-            
-            bcp.applySingleLiteralEq(workingFormula, currentLiteral);         // can propagate the literal we learned
-            //workingFormula.setLiteralBackpropagated(currentLiteral);
+            backbone.push_back(currentLiteral);
 
-            remainingLiterals.erase(remainingLiterals.begin());      // remove the literal that was tried
+            this->solver->addClause(cnf::Clause({currentLiteral}));          // the solver can propagate the literal we learned
+            //workingFormula.setLiteralBackpropagated(currentLiteral);
          }
          else {
             //workingFormula.decompress(model);
-            
-            remainingLiterals.erase(remainingLiterals.begin());      // remove the literal that was tried
-
-            remainingLiterals.erase(
-               std::remove_if(remainingLiterals.begin(), remainingLiterals.end(), 
-                  [&](int lit) {
-                     return model[std::abs(lit)] != (lit > 0);
-                  }
-               ),
-               remainingLiterals.end()
-            );
-
-            workingFormula.erase(workingFormula.end());           // remove last clause again
-
-            if (remainingLiterals.empty()) {                      // just in case remaining Literals has been emptied by remove_if
-               break;
-            }
+
+            // every candidate the model assigns differently can't be in the backbone, drop them a word at a time
+            candidates.intersect(model);
          }
 
       }
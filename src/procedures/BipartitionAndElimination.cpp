@@ -14,15 +14,17 @@
 #include "BooleanConstraintPropagation.h"
 #include "Vivification.h"
 #include "OccurrenceSimplification.h"
-#include "../solvers/clasp.h"
+#include "../Utility.h"
 #include "../definitions.h"
 
 #include <algorithm>
+#include <utility>
 
 namespace preppy::procedures {
 
-   BipartitionAndElimination::BipartitionAndElimination() 
-      : Procedure("Bipartition and Elimination", cnf::EQUIVALENCE_TYPE::NUMBER_EQUIVALENT) {
+   BipartitionAndElimination::BipartitionAndElimination(std::shared_ptr<solvers::Solver> solver) 
+      : Procedure("Bipartition and Elimination", cnf::EQUIVALENCE_TYPE::NUMBER_EQUIVALENT)
+      , solver(solver) {
 
    }
 
@@ -34,10 +36,10 @@ namespace preppy::procedures {
    }
 
    cnf::Variables BipartitionAndElimination::bipartition(const cnf::CNF& formula) const {
-      // copy formula so we can simplify it as we go
-      cnf::CNF workingFormula = formula;
+      // take a snapshot of the formula so we can simplify it as we go
+      cnf::CNF workingFormula = formula.snapshot();
       
-      BackboneSimplification bs(util::Utility::getSolver());
+      BackboneSimplification bs(this->solver);
       BooleanConstraintPropagation bcp;
       cnf::Literals backbone = bs.getBackbone(workingFormula);
       bcp.applyLiteralsEq(workingFormula, backbone);
@@ -71,13 +73,16 @@ namespace preppy::procedures {
 
       util::Utility::logDebug("Sorted");
 
+      // the formula is loaded once, every candidate is then checked with assumptions so the solver keeps what it learned
+      const unsigned maxVariable = this->loadDefinability(workingFormula);
+
       for (std::size_t i = 0; i < sortedAppearances.size(); ++i) {
          cnf::Variables definitionSet = inputVariables;
          for (std::size_t j = i+1; j < sortedAppearances.size(); ++j) {
             definitionSet.push_back(sortedAppearances[j].first);
          }
          
-         bool isDefined = this->isDefined(sortedAppearances[i].first, workingFormula, definitionSet);
+         bool isDefined = this->isDefined(sortedAppearances[i].first, definitionSet, maxVariable);
 
          if (isDefined) {
             outputVariables.push_back(sortedAppearances[i].first);
@@ -91,7 +96,7 @@ namespace preppy::procedures {
    }
 
    void BipartitionAndElimination::eliminate(cnf::CNF& formula, cnf::Variables variables) const {
-      cnf::CNF workingFormula = formula;
+      cnf::CNF workingFormula = formula.snapshot();
 
       procedures::Vivification vivification;
       procedures::OccurrenceSimplification occurrenceSimplification;
@@ -122,17 +127,9 @@ namespace preppy::procedures {
             occurrenceSimplification.applySingleLiteral(workingFormula, -static_cast<int>(x));
 
             // line 10
-            int occurrencesPos = 0;
-            int occurrencesNeg = 0;
-
-            for (const auto& clause : formula) {
-               if (std::find(clause->begin(), clause->end(), x) != clause->end()) {
-                  occurrencesPos++;
-               }
-               if (std::find(clause->begin(), clause->end(), -x) != clause->end()) {
-                  occurrencesNeg++;
-               }
-            }
+            formula.enableOccurrenceLists();
+            const int occurrencesPos = formula.getOccurrenceCount(static_cast<int>(x));
+            const int occurrencesNeg = formula.getOccurrenceCount(-static_cast<int>(x));
 
             if (occurrencesNeg * occurrencesPos > maxNumberRes) {
                // line 11  -> possibly postpone elimination
@@ -150,68 +147,64 @@ namespace preppy::procedures {
       }
 
 
-      formula = workingFormula;
+      formula = std::move(workingFormula);
    }
 
-   bool BipartitionAndElimination::isDefined(const unsigned x, const cnf::CNF& formula, const cnf::Variables& variables/*, unsigned maxC*/) const {
-      // generate formula to check for satisfiability
-
-      util::Utility::logDebug("Checking definedness of ", x);
-      
-      if (std::find(variables.begin(), variables.end(), x) != variables.end()) {     // if x is in the variables then it is defined
-         return true;
-      }
-
-      // We need two copies to work on
-      cnf::CNF workingFormula = formula;
-      cnf::CNF copyFormula = formula;
+   unsigned BipartitionAndElimination::loadDefinability(cnf::CNF& formula) const {
+      const unsigned maxVariable = formula.getMaxVariable();
+      const auto prime = [maxVariable](const int literal) {
+         return (literal < 0) ? literal - static_cast<int>(maxVariable) : literal + static_cast<int>(maxVariable);
+      };
 
-      unsigned xPrime = 0;
+      util::Utility::logDebug("Loading the formula and its renamed copy");
+      this->solver->load(formula);
 
-      util::Utility::logDebug("Renaming variables");
-      // rename every variable *not* in variables to an unassigned variable name in copyFormula
-      unsigned newVariableName = copyFormula.getMaxVariable() + 1;
-      for (unsigned var = 1; var <= workingFormula.getMaxVariable(); ++var) {
-         if (std::find(variables.begin(), variables.end(), var) != variables.end()) {     // don't rename if it's found
-            continue;
-         }
-         if (x == var) {   // remember what x is renamed to
-            xPrime = newVariableName;
+      // the copy of the formula over the variables maxVariable + 1 to 2 * maxVariable
+      cnf::Clause renamed;
+      for (const auto& clause : formula) {
+         renamed.clear();
+         for (const int literal : clause) {
+            renamed.push_back(prime(literal));
          }
-         copyFormula.renameVariable(var, newVariableName);
-         ++newVariableName;
+         this->solver->addClause(renamed);
       }
 
-      util::Utility::logDebug("Joining Formulas");
-      // add clauses from the copy to working Formula
-      workingFormula.joinFormula(copyFormula);
-
-      workingFormula.push_back(std::make_unique<cnf::Clause>(std::initializer_list<int>({int(x)})));
-      workingFormula.push_back(std::make_unique<cnf::Clause>(std::initializer_list<int>({-int(xPrime)})));
+      // assuming the selector 2 * maxVariable + var makes var equal to its copy
+      for (unsigned var = 1; var <= maxVariable; ++var) {
+         const int literal = static_cast<int>(var);
+         const int selector = static_cast<int>(2 * maxVariable + var);
+         this->solver->addClause(cnf::Clause({-selector, -literal, prime(literal)}));
+         this->solver->addClause(cnf::Clause({-selector, literal, -prime(literal)}));
+      }
 
-      return !util::Utility::getSolver()->isSatisfiable(workingFormula);
+      return maxVariable;
    }
 
-   void BipartitionAndElimination::sort(const cnf::CNF& formula, cnf::Variables& variables) {
-      std::unordered_map<int, int> occurences;
-      for (int var : variables) {
-         occurences[var] = 0;
-         occurences[-var] = 0;
+   bool BipartitionAndElimination::isDefined(const unsigned x, const cnf::Variables& variables, const unsigned maxVariable) const {
+      util::Utility::logDebug("Checking definedness of ", x);
+      
+      if (std::find(variables.begin(), variables.end(), x) != variables.end()) {     // if x is in the variables then it is defined
+         return true;
       }
 
-      for (const auto& clause : formula) {
-         for (int var : variables) {
-            if (std::find(clause->begin(), clause->end(), var) != clause->end()) {
-               occurences[var]++;
-            }
-            if (std::find(clause->begin(), clause->end(), -var) != clause->end()) {
-               occurences[-var]++;
-            }
-         }
+      // the variables are equal in both copies, x is defined if it can't be true in one copy and false in the other
+      cnf::Literals assumptions;
+      assumptions.reserve(variables.size() + 2);
+      for (const unsigned var : variables) {
+         assumptions.push_back(static_cast<int>(2 * maxVariable + var));
       }
+      assumptions.push_back(static_cast<int>(x));
+      assumptions.push_back(-static_cast<int>(x + maxVariable));
+
+      return this->solver->solve(assumptions).empty();
+   }
+
+   void BipartitionAndElimination::sort(cnf::CNF& formula, cnf::Variables& variables) {
+      // the occurrence lists count the clauses of every literal
+      formula.enableOccurrenceLists();
 
-      std::sort(variables.begin(), variables.end(), [&occurences](int var1, int var2){
-         return occurences[var1] * occurences[-var1] < occurences[var2] * occurences[-var2];
+      std::sort(variables.begin(), variables.end(), [&formula](int var1, int var2){
+         return formula.getOccurrenceCount(var1) * formula.getOccurrenceCount(-var1) < formula.getOccurrenceCount(var2) * formula.getOccurrenceCount(-var2);
       });
    }
 
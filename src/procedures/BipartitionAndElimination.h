@@ -13,10 +13,12 @@
 
 #include "Procedure.h"
 #include "../CNF.h"
+#include "../solvers/Solver.h"
 #include "../definitions.h"
 
 #include <vector>
 #include <tuple>
+#include <memory>
 
 namespace preppy::procedures {
 
@@ -33,8 +35,9 @@ namespace preppy::procedures {
       /**
        * @brief Construct a new Bipartition and Elimination procedure
        * 
+       * @param solver The solver to use for the backbone and the definability checks
        */
-      BipartitionAndElimination();
+      BipartitionAndElimination(std::shared_ptr<solvers::Solver> solver);
 
       /**
        * @brief Returns a list of variables in the formula that are defined in terms of the other variables in the formula greedily calculated, so not necessarily all are found
@@ -64,14 +67,25 @@ namespace preppy::procedures {
       void eliminate(cnf::CNF& formula, cnf::Variables variables) const;
 
       /**
-       * @brief Tests whether variable x is defined in terms of variables in formula
+       * @brief Loads the formula for isDefined() into the solver, together with a copy of it over renamed variables
+       * 
+       * @details Every variable var of the copy is named var + maxVariable. The selector variable 2 * maxVariable + var
+       * makes var equal to its copy when it is assumed, so every check only changes the assumptions
+       * 
+       * @param formula The formula to check definedness on
+       * @return unsigned The maximum variable of the formula, maxVariable
+       */
+      unsigned loadDefinability(cnf::CNF& formula) const;
+
+      /**
+       * @brief Tests whether variable x is defined in terms of variables in the formula loaded by loadDefinability()
        * 
        * @param x The variable to check for definedness
-       * @param formula The formula to check on
        * @param variables The given variables that x can be defined by
-       * @return bool True if x is defined in terms of variables, False if not or on timeout/error
+       * @param maxVariable The maximum variable of the loaded formula, returned by loadDefinability()
+       * @return bool True if x is defined in terms of variables or the solver failed, False if not
        */
-      bool isDefined(const unsigned x, const cnf::CNF& formula, const cnf::Variables& variables) const;
+      bool isDefined(const unsigned x, const cnf::Variables& variables, const unsigned maxVariable) const;
 
       /**
        * @brief Sorts the given variables such that the number of clauses that a variable appears in as negative
@@ -80,7 +94,7 @@ namespace preppy::procedures {
        * @param formula The formula to count clauses in
        * @param variables The variables to sort
        */
-      static void sort(const cnf::CNF& formula, cnf::Variables& variables);
+      static void sort(cnf::CNF& formula, cnf::Variables& variables);
 
    private:
 
@@ -90,6 +104,12 @@ namespace preppy::procedures {
        */
       constexpr static int maxNumberRes = 500;
 
+      /**
+       * @brief The solver to use
+       * 
+       */
+      std::shared_ptr<solvers::Solver> solver;
+
    };
 
 }
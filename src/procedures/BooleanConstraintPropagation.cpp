@@ -11,9 +11,13 @@
 
 #include "BooleanConstraintPropagation.h"
 #include "../CNF.h"
+#include "../Model.h"
 #include "../definitions.h"
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <vector>
 
 namespace preppy::procedures {
 
@@ -33,83 +37,58 @@ namespace preppy::procedures {
    }
 
    cnf::Literals BooleanConstraintPropagation::getBcp(cnf::CNF& formula) {
-      cnf::WatchedLiteralsT& watchedLiterals = formula.getWatchedLiterals();
-
-      if (watchedLiterals.empty()) {
-         return {};
-      }
-
-      // Unit propagation -> find unit clauses
-      cnf::Literals units;
-      for (const auto& clause : formula) {
-         if (clause->size() == 1) {
-            units.push_back((*clause)[0]);
-         }
-      }
-      
-      if (units.empty()) {
+      // without unit clauses there's nothing to propagate, so the clauses don't have to be watched at all
+      const bool hasUnits = std::any_of(formula.begin(), formula.end(), [](const auto& clause) {
+         return clause.size() <= 1;
+      });
+      if (!hasUnits) {
          return {};
       }
 
-      for (size_t i = 0; i < units.size(); ++i) {
-         auto literal = units[i];
-         std::vector<cnf::Clause*>& watched = watchedLiterals[-literal];
-
-         for (auto& clause : watched) {
-            // check if the clause is satisfied
-            if (clause->isSatisfied(units)) {
-               continue;
-            }
-
-            auto partialClause = clause->getPartialClause(units);
-            if (partialClause.size() == 1) {
-               // formula became unsatisfiable
-               if (partialClause[0] == 0) {
-                  return {0};
-               }
-               // new unit clause -> add to units
-               // do nothing else since if we come across the same clause again it will be satisfied and not get here
-               units.push_back(partialClause[0]);
-            }
-            else {
-               // there's 2 or more literals
-               // choose a new literal to watch
-               // we always watch the first two, so without the one currently being propagated, start watching the second now
-               watchedLiterals[partialClause[1]].push_back(clause);
-            }
-         }
+      // the propagator reuses its memory, so calling this again and again doesn't allocate
+      this->propagator.bind(formula);
+      if (cnf::Propagator::NO_CLAUSE != this->propagator.propagate()) {
+         // formula became unsatisfiable
+         return {0};
       }
-
-      return units;
+      return this->propagator.getTrail();
    }
 
    void BooleanConstraintPropagation::applySingleLiteral(cnf::CNF& formula, const int literal) const {
       // set literals on all clauses and remove the ones that are satisfied
-      formula.erase(
-         std::remove_if(formula.begin(), formula.end(),
-            [&](std::unique_ptr<cnf::Clause>& clause){
-               return clause->setLiteral(literal);
-            }
-         ),
-         formula.end()
-      );
-      formula.setDirtyBitsTrue();
+      formula.eraseIf([literal](cnf::ClauseView clause) {
+         return clause.setLiteral(literal);
+      });
    }
 
    void BooleanConstraintPropagation::applySingleLiteralEq(cnf::CNF& formula, const int literal) const {
       this->applySingleLiteral(formula, literal);
-      formula.push_back(std::make_unique<cnf::Clause>(std::initializer_list<int>({literal})));
+      formula.push_back(cnf::Clause({literal}));
    }
 
    void BooleanConstraintPropagation::applyLiterals(cnf::CNF& formula, const cnf::Literals& literals) const {
+      if (literals.empty()) {
+         return;
+      }
+
+      // mark all literals at once, so a single pass over the formula applies them
+      cnf::Model assignment(static_cast<std::size_t>(formula.getMaxVariable()) + 1);
       for (const auto& literal : literals) {
-         this->applySingleLiteral(formula, literal);
+         if (0 != literal) {
+            assignment.assign(static_cast<std::size_t>(std::abs(literal)), literal > 0);
+         }
       }
+
+      // set literals on all clauses and remove the ones that are satisfied
+      formula.eraseIf([&assignment](cnf::ClauseView clause) {
+         return clause.setLiterals(assignment);
+      });
    }
 
    void BooleanConstraintPropagation::applyLiteralsEq(cnf::CNF& formula, const cnf::Literals& literals) const {
+      this->applyLiterals(formula, literals);
       for (const auto& literal : literals) {
-         this->applySingleLiteralEq(formula, literal);
+         formula.push_back(cnf::Clause({literal}));
       }
    }
 
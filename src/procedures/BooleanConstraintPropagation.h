@@ -12,6 +12,7 @@
 #pragma once
 
 #include "Procedure.h"
+#include "../Propagator.h"
 
 #include <vector>
 
@@ -56,7 +57,9 @@ namespace preppy::procedures {
       void applySingleLiteralEq(cnf::CNF& formula, const int literal) const;
 
       /**
-       * @brief Applies boolean constraint propagation on the formula with all given literals
+       * @brief Applies boolean constraint propagation on the formula with all given literals, in a single pass over the
+       * formula. The statistics are updated for every clause during the pass, the watched literals and occurrence
+       * lists are rebuilt once at the end
        * 
        * @param formula The formula to apply the literals to
        * @param literals The literals to apply
@@ -83,6 +86,12 @@ namespace preppy::procedures {
 
    private:
 
+      /**
+       * @brief The propagator used by getBcp(), kept to reuse its memory
+       * 
+       */
+      cnf::Propagator propagator;
+
    };
 
 }
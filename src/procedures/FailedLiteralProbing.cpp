@@ -0,0 +1,147 @@
+/**
+ * @file FailedLiteralProbing.cpp
+ * @author Anton Reinhard
+ * @brief Failed Literal Probing implementation
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "FailedLiteralProbing.h"
+#include "BooleanConstraintPropagation.h"
+#include "../CNF.h"
+#include "../Utility.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace preppy::procedures {
+
+   FailedLiteralProbing::FailedLiteralProbing()
+      : Procedure("Failed Literal Probing", cnf::EQUIVALENCE_TYPE::EQUIVALENT) {
+
+   }
+
+   bool FailedLiteralProbing::impl(cnf::CNF& formula) {
+      const cnf::Literals candidates = this->getCandidates(formula);
+
+      this->propagator.bind(formula);
+      if (cnf::Propagator::NO_CLAUSE != this->propagator.propagate()) {
+         util::Utility::logInfo("The formula is unsatisfiable, nothing to probe");
+         return true;
+      }
+
+      // the literals propagated by the first literal of a variable are marked with the number of the probe
+      std::vector<unsigned> stamps(2 * (static_cast<std::size_t>(formula.getMaxVariable()) + 1), 0);
+      unsigned probe = 0;
+      cnf::Literals implied;
+
+      unsigned failedLiterals = 0;
+      unsigned impliedLiterals = 0;
+      bool satisfiable = true;
+
+      for (const int literal : candidates) {
+         if (!satisfiable) {
+            break;
+         }
+         if (cnf::LITERAL_VALUE::UNASSIGNED != this->propagator.getValue(literal)) {
+            // already implied by a previous probe
+            continue;
+         }
+
+         std::size_t start = this->propagator.getTrail().size();
+         this->propagator.assume(literal);
+         if (cnf::Propagator::NO_CLAUSE != this->propagator.propagate()) {
+            this->propagator.backtrack(0);
+            ++failedLiterals;
+            satisfiable = this->learn(-literal);
+            continue;
+         }
+         ++probe;
+         for (std::size_t i = start + 1; i < this->propagator.getTrail().size(); ++i) {
+            stamps[cnf::literalIndex(this->propagator.getTrail()[i])] = probe;
+         }
+         this->propagator.backtrack(0);
+
+         start = this->propagator.getTrail().size();
+         this->propagator.assume(-literal);
+         if (cnf::Propagator::NO_CLAUSE != this->propagator.propagate()) {
+            this->propagator.backtrack(0);
+            ++failedLiterals;
+            satisfiable = this->learn(literal);
+            continue;
+         }
+         // the literals propagated by both literals of the variable are implied
+         implied.clear();
+         for (std::size_t i = start + 1; i < this->propagator.getTrail().size(); ++i) {
+            const int other = this->propagator.getTrail()[i];
+            if (probe == stamps[cnf::literalIndex(other)]) {
+               implied.push_back(other);
+            }
+         }
+         this->propagator.backtrack(0);
+
+         for (const int other : implied) {
+            if (satisfiable && cnf::LITERAL_VALUE::UNASSIGNED == this->propagator.getValue(other)) {
+               ++impliedLiterals;
+               satisfiable = this->learn(other);
+            }
+         }
+      }
+
+      util::Utility::logInfo("Failed literals:                      ", failedLiterals);
+      util::Utility::logInfo("Literals implied by both polarities:  ", impliedLiterals);
+
+      if (!satisfiable) {
+         util::Utility::logInfo("The formula is unsatisfiable");
+         return true;
+      }
+      if (0 == failedLiterals + impliedLiterals) {
+         return true;
+      }
+
+      // everything on decision level 0 is implied by the formula, the literals are kept as unit clauses
+      const cnf::Literals units = this->propagator.getTrail();
+      BooleanConstraintPropagation bcp;
+      bcp.applyLiteralsEq(formula, units);
+
+      return true;
+   }
+
+   cnf::Literals FailedLiteralProbing::getCandidates(cnf::CNF& formula) const {
+      const std::vector<unsigned> occurrences = formula.countVariables();
+      const cnf::BinaryImplications& implications = formula.getBinaryImplications();
+      const auto implies = [&implications](const int literal) {
+         return !implications[literal].empty() || !implications.getShared(literal).empty();
+      };
+
+      cnf::Literals roots;
+      cnf::Literals others;
+      for (std::size_t variable = 1; variable < occurrences.size(); ++variable) {
+         if (0 == occurrences[variable]) {
+            continue;
+         }
+         const int literal = static_cast<int>(variable);
+         const bool positive = implies(literal);
+         const bool negative = implies(-literal);
+         if (positive != negative) {
+            // nothing implies the literal that implies something, so it is a root of the implication graph
+            roots.push_back(positive ? literal : -literal);
+         }
+         else {
+            others.push_back(literal);
+         }
+      }
+
+      roots.insert(roots.end(), others.begin(), others.end());
+      return roots;
+   }
+
+   bool FailedLiteralProbing::learn(const int literal) {
+      this->propagator.assign(literal);
+      return cnf::Propagator::NO_CLAUSE == this->propagator.propagate();
+   }
+
+}
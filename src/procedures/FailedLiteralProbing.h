@@ -0,0 +1,79 @@
+/**
+ * @file FailedLiteralProbing.h
+ * @author Anton Reinhard
+ * @brief Failed Literal Probing header
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include "Procedure.h"
+#include "../Propagator.h"
+#include "../definitions.h"
+
+#include <vector>
+
+namespace preppy::procedures {
+
+   /**
+    * @brief Class implementing Failed Literal Probing as a procedure
+    *
+    * @details Every variable is probed by propagating both of its literals. A literal whose propagation leads to a
+    * conflict is failed, its negation is implied by the formula. Literals that are propagated by both literals of a
+    * variable are implied by the formula as well. The implied literals are applied to the formula as facts, which only
+    * takes unit propagation instead of a SAT solver. Roots of the binary implication graph are probed first, since
+    * their propagation covers the most literals.
+    * Application of this procedure will result in an equivalent output formula
+    */
+   class FailedLiteralProbing
+      : public Procedure {
+   public:
+
+      /**
+       * @brief Construct a new Failed Literal Probing procedure
+       *
+       */
+      FailedLiteralProbing();
+
+      /**
+       * @brief Get the literals to probe, one per variable of the formula. The roots of the binary implication graph
+       * come first, the other variables follow with their positive literal
+       *
+       * @param formula The formula
+       * @return cnf::Literals The literals in the order to probe them
+       */
+      cnf::Literals getCandidates(cnf::CNF& formula) const;
+
+   protected:
+
+      /**
+       * @brief Apply Failed Literal Probing to a formula
+       *
+       * @param formula The formula to apply to
+       * @return bool True on success
+       */
+      bool impl(cnf::CNF& formula) override;
+
+   private:
+
+      /**
+       * @brief Assigns a literal implied by the formula on decision level 0 and propagates it
+       *
+       * @param literal The literal
+       * @return bool False if the formula became unsatisfiable
+       */
+      bool learn(int literal);
+
+      /**
+       * @brief The propagator bound to the formula, reused for every probe
+       *
+       */
+      cnf::Propagator propagator;
+
+   };
+
+}
@@ -0,0 +1,191 @@
+/**
+ * @file HyperBinaryResolution.cpp
+ * @author Anton Reinhard
+ * @brief Hyper Binary Resolution and Transitive Reduction implementation
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "HyperBinaryResolution.h"
+#include "FailedLiteralProbing.h"
+#include "../CNF.h"
+#include "../Utility.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <vector>
+
+namespace preppy::procedures {
+
+   HyperBinaryResolution::HyperBinaryResolution(const std::size_t budget)
+      : Procedure("Hyper Binary Resolution", cnf::EQUIVALENCE_TYPE::EQUIVALENT)
+      , budget(budget) {
+
+   }
+
+   bool HyperBinaryResolution::impl(cnf::CNF& formula) {
+      if (!this->addResolvents(formula)) {
+         util::Utility::logInfo("The formula is unsatisfiable");
+         return true;
+      }
+      this->removeTransitiveClauses(formula);
+      return true;
+   }
+
+   bool HyperBinaryResolution::addResolvents(cnf::CNF& formula) {
+      const cnf::Literals candidates = FailedLiteralProbing().getCandidates(formula);
+
+      this->propagator.bind(formula);
+      if (cnf::Propagator::NO_CLAUSE != this->propagator.propagate()) {
+         return false;
+      }
+
+      this->resetStamps(formula);
+      cnf::Literals resolvents;
+      unsigned addedClauses = 0;
+      unsigned failedLiterals = 0;
+
+      for (const int literal : candidates) {
+         if (this->propagator.getPropagations() + this->visited >= this->budget) {
+            util::Utility::logInfo("Hyper binary resolution ran out of propagations");
+            break;
+         }
+         if (cnf::LITERAL_VALUE::UNASSIGNED != this->propagator.getValue(literal)) {
+            continue;
+         }
+
+         const std::size_t start = this->propagator.getTrail().size();
+         this->propagator.assume(literal);
+         if (cnf::Propagator::NO_CLAUSE != this->propagator.propagate()) {
+            // the literal failed, its negation is implied
+            this->propagator.backtrack(0);
+            formula.push_back(cnf::Clause({-literal}));
+            this->propagator.addClause(formula.back().getRef());
+            ++failedLiterals;
+            if (cnf::Propagator::NO_CLAUSE != this->propagator.propagate()) {
+               return false;
+            }
+            continue;
+         }
+
+         // the literals implied by longer clauses might not be reached over the binary clauses
+         resolvents.clear();
+         for (std::size_t i = start + 1; i < this->propagator.getTrail().size(); ++i) {
+            const int implied = this->propagator.getTrail()[i];
+            const cnf::ClauseRef reason = this->propagator.getReason(static_cast<unsigned>(std::abs(implied)));
+            if (cnf::Propagator::NO_CLAUSE != reason && formula.getClause(reason).size() > 2) {
+               resolvents.push_back(implied);
+            }
+         }
+         this->propagator.backtrack(0);
+         if (resolvents.empty()) {
+            continue;
+         }
+
+         // a resolvent is only added if its literal isn't reached over the binary clauses yet, including the resolvents
+         // added before it. Otherwise the transitive reduction would remove it again
+         ++this->search;
+         this->markImplied(formula, literal, 0, cnf::Propagator::NO_CLAUSE);
+         for (const int implied : resolvents) {
+            assert(cnf::literalIndex(implied) < this->stamps.size());
+            if (this->search == this->stamps[cnf::literalIndex(implied)]) {
+               continue;
+            }
+            formula.push_back(cnf::Clause({-literal, implied}));
+            this->propagator.addClause(formula.back().getRef());
+            ++addedClauses;
+            this->markImplied(formula, implied, 0, cnf::Propagator::NO_CLAUSE);
+         }
+      }
+
+      util::Utility::logInfo("Added hyper binary resolvents:        ", addedClauses);
+      util::Utility::logInfo("Failed literals:                      ", failedLiterals);
+
+      return true;
+   }
+
+   void HyperBinaryResolution::removeTransitiveClauses(cnf::CNF& formula) {
+      std::vector<cnf::ClauseRef> binaries;
+      for (const auto& clause : formula) {
+         if (clause.size() == 2 && clause[0] != clause[1] && clause[0] != -clause[1]) {
+            binaries.push_back(clause.getRef());
+         }
+      }
+
+      // the removed clauses are only marked, so the search doesn't use them anymore, and erased in one pass at the end
+      this->resetStamps(formula);
+      unsigned removedClauses = 0;
+
+      for (const cnf::ClauseRef clause : binaries) {
+         if (this->visited >= this->budget) {
+            util::Utility::logInfo("Transitive reduction ran out of propagations");
+            break;
+         }
+
+         // the clause (a, b) implies b for -a, look for another path from -a to b
+         const cnf::ClauseView view = formula.getClause(clause);
+         ++this->search;
+         if (this->markImplied(formula, -view[0], view[1], clause)) {
+            if (clause >= this->transitive.size()) {
+               this->transitive.resize(clause + 1, false);
+            }
+            this->transitive[clause] = true;
+            ++removedClauses;
+         }
+      }
+
+      util::Utility::logInfo("Removed transitive binary clauses:    ", removedClauses);
+
+      if (0 != removedClauses) {
+         formula.eraseIf([this](const cnf::ClauseView clause) {
+            return clause.getRef() < this->transitive.size() && this->transitive[clause.getRef()];
+         });
+      }
+   }
+
+   bool HyperBinaryResolution::markImplied(cnf::CNF& formula, const int literal, const int target, const cnf::ClauseRef ignored) {
+      const cnf::BinaryImplications& implications = formula.getBinaryImplications();
+      const auto isUsable = [this, &formula, ignored](const cnf::Implication& implication) {
+         return implication.clause != ignored && !formula.isRemoved(implication.clause)
+            && (implication.clause >= this->transitive.size() || !this->transitive[implication.clause]);
+      };
+
+      assert(cnf::literalIndex(literal) < this->stamps.size());
+      this->stamps[cnf::literalIndex(literal)] = this->search;
+      this->stack.assign(1, literal);
+      while (!this->stack.empty()) {
+         const int current = this->stack.back();
+         this->stack.pop_back();
+         ++this->visited;
+         for (const auto* list : {&implications.getShared(current), &implications[current]}) {
+            for (const cnf::Implication& implication : *list) {
+               assert(cnf::literalIndex(implication.literal) < this->stamps.size());
+               if (!isUsable(implication) || this->search == this->stamps[cnf::literalIndex(implication.literal)]) {
+                  continue;
+               }
+               if (implication.literal == target) {
+                  return true;
+               }
+               this->stamps[cnf::literalIndex(implication.literal)] = this->search;
+               this->stack.push_back(implication.literal);
+            }
+         }
+      }
+      return false;
+   }
+
+   void HyperBinaryResolution::resetStamps(cnf::CNF& formula) {
+      // the implication lists don't shrink when variables leave the formula, so they can cover more literals than the clauses
+      const std::size_t range = std::max(2 * (static_cast<std::size_t>(formula.getMaxVariable()) + 1),
+         formula.getBinaryImplications().getIndexRange());
+      this->visited = 0;
+      this->transitive.clear();
+      this->stamps.assign(range, 0);
+   }
+
+}
@@ -0,0 +1,136 @@
+/**
+ * @file HyperBinaryResolution.h
+ * @author Anton Reinhard
+ * @brief Hyper Binary Resolution and Transitive Reduction header
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include "Procedure.h"
+#include "../Propagator.h"
+#include "../definitions.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace preppy::procedures {
+
+   /**
+    * @brief Class implementing Hyper Binary Resolution followed by a Transitive Reduction of the binary implication
+    * graph as a procedure
+    *
+    * @details The candidates of Failed Literal Probing are probed. Every literal a probe implies through a clause with
+    * more than two literals gets a binary clause with the negated probe, the hyper binary resolvent, so the implication
+    * graph reaches it directly. Probes that fail add their negation as a unit clause. Afterwards every binary clause
+    * is removed if its implication is reachable over other binary clauses. Both steps stop once they used up the
+    * budget of propagated literals.
+    * Application of this procedure will result in an equivalent output formula
+    */
+   class HyperBinaryResolution
+      : public Procedure {
+   public:
+
+      /**
+       * @brief Construct a new Hyper Binary Resolution procedure
+       *
+       * @param budget The number of literals each of the two steps may propagate in one application
+       */
+      explicit HyperBinaryResolution(std::size_t budget = 10000000);
+
+   protected:
+
+      /**
+       * @brief Apply Hyper Binary Resolution and Transitive Reduction to a formula
+       *
+       * @param formula The formula to apply to
+       * @return bool True on success
+       */
+      bool impl(cnf::CNF& formula) override;
+
+   private:
+
+      /**
+       * @brief Adds the hyper binary resolvents of the probed literals to the formula
+       *
+       * @param formula The formula
+       * @return bool False if the formula became unsatisfiable
+       */
+      bool addResolvents(cnf::CNF& formula);
+
+      /**
+       * @brief Removes the binary clauses whose implication is reachable over other binary clauses
+       *
+       * @param formula The formula
+       */
+      void removeTransitiveClauses(cnf::CNF& formula);
+
+      /**
+       * @brief Marks the literals reachable from a literal over the binary clauses with the current search, without
+       * using a given clause and the clauses marked as transitive. Literals marked already are not visited again
+       *
+       * @param formula The formula
+       * @param literal The literal to start at
+       * @param target The literal to look for, the search stops once it is marked
+       * @param ignored The clause not to use
+       * @return bool True if the target was reached
+       */
+      bool markImplied(cnf::CNF& formula, int literal, int target, cnf::ClauseRef ignored);
+
+      /**
+       * @brief Starts a step, clears the marks and sizes them for every literal of the clauses and of the binary
+       * implications
+       *
+       * @param formula The formula
+       */
+      void resetStamps(cnf::CNF& formula);
+
+      /**
+       * @brief The propagator bound to the formula, reused for every probe
+       *
+       */
+      cnf::Propagator propagator;
+
+      /**
+       * @brief The number of literals each step may propagate
+       *
+       */
+      const std::size_t budget;
+
+      /**
+       * @brief The number of literals visited by markImplied() in the current step
+       *
+       */
+      std::size_t visited = 0;
+
+      /**
+       * @brief The number of the current search of markImplied()
+       *
+       */
+      unsigned search = 0;
+
+      /**
+       * @brief The search every literal was last marked by, indexed by literalIndex()
+       *
+       */
+      std::vector<unsigned> stamps;
+
+      /**
+       * @brief The literals left to visit by markImplied()
+       *
+       */
+      cnf::Literals stack;
+
+      /**
+       * @brief Whether a clause was found to be transitive, indexed by clause reference
+       *
+       */
+      std::vector<bool> transitive;
+
+   };
+
+}
@@ -10,9 +10,7 @@
  */
 
 #include "OccurrenceSimplification.h"
-#include "BooleanConstraintPropagation.h"
 
-#include <map>
 #include <vector>
 #include <algorithm>
 
@@ -24,92 +22,91 @@ namespace preppy::procedures {
    }
 
    bool OccurrenceSimplification::impl(cnf::CNF& formula) {
+      const bool hadOccurrenceLists = formula.hasOccurrenceLists();
+      formula.enableOccurrenceLists();
+
       cnf::Literals literals = this->getIncidenceSortedLiterals(formula);
+      this->propagator.bind(formula);
 
       while (!literals.empty()) {
          // get most common literal from the list and remove it from the list
          const int literal = literals[0];
          literals.erase(literals.begin());
 
-         this->applySingleLiteral(formula, literal);
+         this->strengthenOccurrences(formula, literal);
       }
 
       //remove any clauses that became empty
-      formula.erase(
-         std::remove_if(formula.begin(), formula.end(), [](const std::unique_ptr<cnf::Clause>& clause){
-            return clause->size() == 0;
-         }), 
-         formula.end()
-      );
+      formula.eraseIf([](const cnf::ClauseView clause) {
+         return clause.size() == 0;
+      });
+
+      if (!hadOccurrenceLists) {
+         formula.disableOccurrenceLists();
+      }
 
       return false;
    }
 
    void OccurrenceSimplification::applySingleLiteral(cnf::CNF& formula, int literal) {
-      procedures::BooleanConstraintPropagation bcp;
+      this->propagator.bind(formula);
+      this->strengthenOccurrences(formula, literal);
+   }
+
+   void OccurrenceSimplification::strengthenOccurrences(cnf::CNF& formula, const int literal) {
+      // only the clauses containing the literal are visited. The list is copied, since the literal is erased from
+      // clauses while iterating
+      formula.enableOccurrenceLists();
+      const std::vector<cnf::ClauseRef> occurrences = formula.getOccurrences(literal);
+      for (const cnf::ClauseRef ref : occurrences) {
+         if (formula.isRemoved(ref)) {
+            continue;
+         }
+         cnf::ClauseView clause = formula.getClause(ref);
 
-      for (auto& clause : formula) {
          // unit clauses can't have their literals removed by this anyways -> skip
          if (clause->size() == 1) {
             continue;
          }
-         // consider only clauses that contain the literal
-         if (!clause->containsLiteral(literal)) {
-            continue;
+
+         // propagate the literal and the complement of the rest of the clause, instead of adding them to the formula
+         bool unsatisfiable = cnf::Propagator::NO_CLAUSE != this->propagator.propagate() || !this->propagator.assume(literal);
+         for (auto it = clause.begin(); !unsatisfiable && it != clause.end(); ++it) {
+            unsatisfiable = *it != literal && !this->propagator.assume(-*it);
          }
+         unsatisfiable = unsatisfiable || cnf::Propagator::NO_CLAUSE != this->propagator.propagate();
+         this->propagator.backtrack(0);
 
-         // make possible new clause
-         cnf::Clause newClause = *clause;
-         newClause.erase(std::find(newClause.begin(), newClause.end(), literal));
-         
-         formula.push_back(std::make_unique<cnf::Clause>(newClause.getComplement()));
-         formula.push_back(std::make_unique<cnf::Clause>(std::initializer_list<int>({literal})));
-         cnf::Literals bcpLiterals = bcp.getBcp(formula);
-         // remove the two clauses again
-         formula.pop_back();
-         formula.pop_back();
-
-         if (!bcpLiterals.empty() && bcpLiterals[0] == 0) {
+         if (unsatisfiable) {
             // if it became unsatisfiable the literal can be removed from the clause
-            clause->erase(std::find(clause->begin(), clause->end(), literal));
+            formula.eraseLiteral(ref, literal);
+            this->propagator.eraseLiteral(ref);
          }
       }
    }
 
    cnf::Literals OccurrenceSimplification::getIncidenceSortedLiterals(cnf::CNF& formula) const {
-      // map from the literal onto its number of occurrences in the formula
-      std::map<int, int> literalOccurenceMap;
+      // the occurrence lists count the clauses of every literal
+      formula.enableOccurrenceLists();
       
       // the sorted list of literals to return at the end
       cnf::Literals literals;
       literals.reserve(formula.getVariables() * 2);
 
-      // Add every literal positive and negative to the map and to list of literals
-      for (auto var = 1; var <= formula.getVariables(); ++var) {
-         literalOccurenceMap[var] = 0;
-         literalOccurenceMap[-var] = 0;
-         literals.emplace_back(var);
-         literals.emplace_back(-var);
-      }
-
-      // Collect their number of occurrences
-      for (const auto& clause : formula) {
-         for (const auto& literal : *clause) {
-            ++literalOccurenceMap[literal];
+      // Add every literal positive and negative that appears to the list of literals
+      for (unsigned var = 1; var <= formula.getMaxVariable(); ++var) {
+         const int literal = static_cast<int>(var);
+         if (formula.getOccurrenceCount(literal) != 0) {
+            literals.emplace_back(literal);
+         }
+         if (formula.getOccurrenceCount(-literal) != 0) {
+            literals.emplace_back(-literal);
          }
       }
 
-      // remove any literals that don't appear at all
-      literals.erase(
-         std::remove_if(literals.begin(), literals.end(), [&](int l) {
-            return literalOccurenceMap[l] == 0;
-         }),
-         literals.end()
-      );
-
       // sort literals by occurrence
-      std::sort(literals.begin(), literals.end(), [&](int a, int b) {
-         return literalOccurenceMap[a] > literalOccurenceMap[b];
+      std::sort(literals.begin(), literals.end(), [&formula](int a, int b) {
+         return formula.getOccurrenceCount(a) > formula.getOccurrenceCount(b);
       });
 
       return literals;
@@ -12,6 +12,7 @@
 #pragma once
 
 #include "Procedure.h"
+#include "../Propagator.h"
 
 namespace preppy::procedures {
 
@@ -63,6 +64,21 @@ namespace preppy::procedures {
        */
       cnf::Literals getIncidenceSortedLiterals(cnf::CNF& formula) const;
 
+      /**
+       * @brief Removes a literal from every clause containing it, for which the rest of the clause is implied by the
+       * formula and the literal. Requires the propagator to be bound to the formula
+       * 
+       * @param formula The formula
+       * @param literal The literal
+       */
+      void strengthenOccurrences(cnf::CNF& formula, int literal);
+
+      /**
+       * @brief The propagator bound to the formula, reused for every clause the literals are removed from
+       * 
+       */
+      cnf::Propagator propagator;
+
    };
 
 }
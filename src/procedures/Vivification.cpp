@@ -10,10 +10,11 @@
  */
 
 #include "Vivification.h"
-#include "BooleanConstraintPropagation.h"
+#include "../Propagator.h"
 #include "../Utility.h"
 
-#include <algorithm>
+#include <cstddef>
+#include <memory>
 
 namespace preppy::procedures {
 
@@ -23,38 +24,36 @@ namespace preppy::procedures {
    }
 
    bool Vivification::impl(cnf::CNF &formula) {
-      cnf::CNF newFormula = formula.getMetadataCopy();
+      // the vivified clauses are added to the end of the formula, so a single propagator stays bound to formula ∪
+      // newFormula while the clauses are taken out of it one after the other
+      cnf::Propagator propagator(formula);
 
-      procedures::BooleanConstraintPropagation bcp;
+      int totalPropagateCalls = 0;
+      util::clock::duration propagateDuration(0);
 
-      int totalBcpCalls = 0;
-      util::clock::duration bcpDuration(0);
-
-      while (formula.size() != 0) {
-         // copy first clause and delete it from the formula
-         std::unique_ptr<cnf::Clause> currentClause = std::make_unique<cnf::Clause>(*formula[0]);
+      for (std::size_t clauses = formula.size(); clauses != 0; --clauses) {
+         // copy first clause and delete it from the formula, only marks it as removed so this stays constant time
+         std::unique_ptr<cnf::Clause> currentClause = std::make_unique<cnf::Clause>(formula.front().toClause());
+         const cnf::ClauseRef currentRef = formula.front().getRef();
          formula.erase(formula.begin());
+         propagator.removeClause(currentRef);
 
          cnf::Clause newClause;
 
-         cnf::CNF tempFormula = formula;
-         tempFormula.joinFormula(newFormula);
-         // take bcp of formula ∪ newFormula
-
-         util::Utility::startTimer("getBcp");
-         auto bcpLiterals = bcp.getBcp(tempFormula);
-         ++totalBcpCalls;
-         bcpDuration += util::Utility::stopTimer("getBcp");
-
-         bool satisfied = false;
+         // take bcp of formula ∪ newFormula, only what wasn't propagated yet on level 0 is visited. If there is a
+         // conflict every clause is satisfied
+         util::Utility::startTimer("propagate");
+         bool satisfied = cnf::Propagator::NO_CLAUSE != propagator.propagate();
+         ++totalPropagateCalls;
+         propagateDuration += util::Utility::stopTimer("propagate");
 
-         while (currentClause->size() != 0) {
-            // choose literal from currentClause such that its negation is not part of bcpLiterals
+         while (!satisfied && currentClause->size() != 0) {
+            // choose literal from currentClause such that its negation is not part of the propagated literals
             int l = 0;
             for (size_t i = 0; i < currentClause->size(); ++i) {
                int lit = (*currentClause)[i];
-               if (std::find(bcpLiterals.begin(), bcpLiterals.end(), -lit) == bcpLiterals.end()) {
-                  // -l wasn't found -> choose this l
+               if (0 != lit && cnf::LITERAL_VALUE::FALSE != propagator.getValue(lit)) {
+                  // -l isn't true -> choose this l
                   l = lit;
                   currentClause->erase(currentClause->begin() + i);
                   break;
@@ -69,33 +68,27 @@ namespace preppy::procedures {
             // add l to newClause
             newClause.push_back(l);
 
-            // take bcp of formula ∪ newFormula
-            tempFormula.push_back(std::make_unique<cnf::Clause>(newClause.getComplement()));
-
-            util::Utility::startTimer("getBcp");
-            bcpLiterals = bcp.getBcp(tempFormula);
-            ++totalBcpCalls;
-            bcpDuration += util::Utility::stopTimer("getBcp");
-
-            //delete complementaryNewClause again
-            tempFormula.erase(tempFormula.end() - 1);
-
-            if (!bcpLiterals.empty() && bcpLiterals[0] == 0) {
-               // if new Clause is satisfied -> break
-               satisfied = true;
-               break;
-            }
+            // take bcp of formula ∪ newFormula ∪ ¬newClause, the literals of newClause are assumed one at a time
+            util::Utility::startTimer("propagate");
+            satisfied = !propagator.assume(-l) || cnf::Propagator::NO_CLAUSE != propagator.propagate();
+            ++totalPropagateCalls;
+            propagateDuration += util::Utility::stopTimer("propagate");
          }
 
+         // take back the literals of newClause
+         propagator.backtrack(0);
+
          if (!satisfied) {
-            newFormula.push_back(std::make_unique<cnf::Clause>(newClause));
+            formula.push_back(newClause);
+            propagator.addClause(formula.back().getRef());
          }
       }
 
-      formula = newFormula;
+      // the removed clauses are still stored in front of the vivified ones
+      formula.collectGarbage();
 
-      util::Utility::logInfo("Total getBcp Calls: ", totalBcpCalls);
-      util::Utility::logInfo("Total getBcp Time:  ", util::Utility::durationToString(bcpDuration));
+      util::Utility::logInfo("Total propagate Calls: ", totalPropagateCalls);
+      util::Utility::logInfo("Total propagate Time:  ", util::Utility::durationToString(propagateDuration));
 
       return true;
    }
@@ -0,0 +1,603 @@
+/**
+ * @file CDCL.cpp
+ * @author Anton Reinhard
+ * @brief Built-in CDCL solver implementation
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "CDCL.h"
+#include "../CNF.h"
+
+#include <algorithm>
+
+namespace preppy::solvers {
+
+   CDCL::CDCL(const util::clock::duration& timeout)
+      : Solver("cdcl")
+      , timeout(timeout) {
+   }
+
+   bool CDCL::isSatisfiable(cnf::CNF& formula) {
+      util::Utility::logDebug("Satisfiability check using solver ", this->getName());
+
+      this->load(formula);
+      const cnf::LITERAL_VALUE result = this->run({}, true);
+      this->backtrack(0);
+
+      if (cnf::LITERAL_VALUE::TRUE == result) {
+         util::Utility::logDebug("Formula is satisfiable");
+         return true;
+      }
+      if (cnf::LITERAL_VALUE::FALSE == result) {
+         util::Utility::logDebug("Formula is unsatisfiable");
+         return false;
+      }
+      util::Utility::logDebug("Formula timed out");
+      return false;
+   }
+
+   cnf::Model CDCL::getModel(cnf::CNF& formula) {
+      util::Utility::logDebug("Getting model using solver ", this->getName());
+
+      this->load(formula);
+      return this->solve();
+   }
+
+   void CDCL::load(const cnf::CNF& formula) {
+      this->arena.clear();
+      this->clauses.clear();
+      this->learnts.clear();
+      this->watched.clear();
+      this->glues.clear();
+      this->watches.clear();
+      this->values.clear();
+      this->phases.clear();
+      this->levels.clear();
+      this->reasons.clear();
+      this->trail.clear();
+      this->levelStarts.clear();
+      this->propagated = 0;
+      this->activities.clear();
+      this->increment = 1;
+      this->heap.clear();
+      this->heapPositions.clear();
+      this->seen.clear();
+      this->levelStamps.clear();
+      this->conflicts = 0;
+      this->inconsistent = false;
+
+      for (const auto& clause : formula) {
+         this->addLiterals(clause.begin(), clause.end());
+      }
+
+      this->maxLearnts = std::max(static_cast<double>(this->clauses.size()) / 3, 2000.);
+   }
+
+   void CDCL::addClause(const cnf::Clause& clause) {
+      this->addLiterals(clause.data(), clause.data() + clause.size());
+   }
+
+   cnf::Model CDCL::solve(const cnf::Literals& assumptions) {
+      if (cnf::LITERAL_VALUE::TRUE != this->run(assumptions, false)) {
+         this->backtrack(0);
+         return cnf::Model();
+      }
+
+      // an empty model means unsatisfiable, so a formula without variables still gets the unused variable 0
+      cnf::Model model(std::max<std::size_t>(this->values.size(), 1));
+      for (std::size_t variable = 1; variable < this->values.size(); ++variable) {
+         model.assign(variable, this->values[variable] > 0);
+      }
+      this->backtrack(0);
+      return model;
+   }
+
+   cnf::LITERAL_VALUE CDCL::run(const cnf::Literals& assumptions, const bool limited) {
+      if (this->inconsistent) {
+         return cnf::LITERAL_VALUE::FALSE;
+      }
+      for (const int literal : assumptions) {
+         this->addVariable(static_cast<std::size_t>(std::abs(literal)));
+      }
+      this->backtrack(0);
+      this->deadline = util::clock::now() + this->timeout;
+
+      cnf::LITERAL_VALUE result = cnf::LITERAL_VALUE::UNASSIGNED;
+      for (std::uint64_t restarts = 0; cnf::LITERAL_VALUE::UNASSIGNED == result; ++restarts) {
+         if (limited && util::clock::now() > this->deadline) {
+            break;
+         }
+         result = this->search(100 * luby(restarts), assumptions);
+      }
+      return result;
+   }
+
+   cnf::LITERAL_VALUE CDCL::search(const std::uint64_t conflicts, const cnf::Literals& assumptions) {
+      std::uint64_t conflictsHere = 0;
+
+      while (true) {
+         const cnf::ClauseRef conflict = this->propagate();
+         if (cnf::Propagator::NO_CLAUSE != conflict) {
+            ++this->conflicts;
+            ++conflictsHere;
+            if (0 == this->getLevel()) {
+               this->inconsistent = true;
+               return cnf::LITERAL_VALUE::FALSE;
+            }
+
+            std::uint32_t glue = 0;
+            const std::size_t level = this->analyze(conflict, glue);
+            this->backtrack(level);
+            if (1 == this->learnt.size()) {
+               this->assign(this->learnt[0], cnf::Propagator::NO_CLAUSE);
+            }
+            else {
+               const cnf::ClauseRef ref = this->arena.add(this->learnt.data(), this->learnt.data() + this->learnt.size());
+               this->learnts.push_back(ref);
+               this->watchClause(ref);
+               this->glues[ref] = glue;
+               this->assign(this->learnt[0], ref);
+            }
+
+            // growing the increment instead of decaying all activities, rescaled in bumpVariable()
+            this->increment /= 0.95;
+            continue;
+         }
+
+         if (conflictsHere >= conflicts) {
+            this->backtrack(0);
+            return cnf::LITERAL_VALUE::UNASSIGNED;
+         }
+         if (static_cast<double>(this->learnts.size()) >= this->maxLearnts + static_cast<double>(this->trail.size())) {
+            this->reduceLearnts();
+         }
+
+         // the assumptions are decided first, one decision level each
+         int next = 0;
+         while (this->getLevel() < assumptions.size()) {
+            const int assumption = assumptions[this->getLevel()];
+            const cnf::LITERAL_VALUE value = this->getValue(assumption);
+            if (cnf::LITERAL_VALUE::TRUE == value) {
+               this->levelStarts.push_back(this->trail.size());
+            }
+            else if (cnf::LITERAL_VALUE::FALSE == value) {
+               return cnf::LITERAL_VALUE::FALSE;
+            }
+            else {
+               next = assumption;
+               break;
+            }
+         }
+
+         if (0 == next) {
+            next = this->pickBranchLiteral();
+            if (0 == next) {
+               return cnf::LITERAL_VALUE::TRUE;
+            }
+         }
+         this->levelStarts.push_back(this->trail.size());
+         this->assign(next, cnf::Propagator::NO_CLAUSE);
+      }
+   }
+
+   void CDCL::addLiterals(const int* first, const int* last) {
+      if (this->inconsistent) {
+         return;
+      }
+      this->backtrack(0);
+
+      this->buffer.assign(first, last);
+      std::sort(this->buffer.begin(), this->buffer.end(), cnf::literalLess);
+      this->buffer.erase(std::unique(this->buffer.begin(), this->buffer.end()), this->buffer.end());
+      for (const int literal : this->buffer) {
+         this->addVariable(static_cast<std::size_t>(std::abs(literal)));
+      }
+
+      // literals false on decision level 0 are dropped, clauses true there or tautologies are never needed
+      std::size_t kept = 0;
+      for (std::size_t i = 0; i < this->buffer.size(); ++i) {
+         const int literal = this->buffer[i];
+         if (0 == literal) {
+            continue;
+         }
+         if (i > 0 && this->buffer[i - 1] == -literal) {
+            return;
+         }
+         const cnf::LITERAL_VALUE value = this->getValue(literal);
+         if (cnf::LITERAL_VALUE::TRUE == value) {
+            return;
+         }
+         if (cnf::LITERAL_VALUE::UNASSIGNED == value) {
+            this->buffer[kept++] = literal;
+         }
+      }
+      this->buffer.resize(kept);
+
+      if (this->buffer.empty()) {
+         this->inconsistent = true;
+      }
+      else if (1 == this->buffer.size()) {
+         this->assign(this->buffer[0], cnf::Propagator::NO_CLAUSE);
+         this->inconsistent = cnf::Propagator::NO_CLAUSE != this->propagate();
+      }
+      else {
+         const cnf::ClauseRef ref = this->arena.add(this->buffer.data(), this->buffer.data() + this->buffer.size());
+         this->clauses.push_back(ref);
+         this->watchClause(ref);
+      }
+   }
+
+   void CDCL::addVariable(const std::size_t variable) {
+      if (variable < this->values.size()) {
+         return;
+      }
+      const std::size_t first = this->values.size();
+      const std::size_t size = variable + 1;
+      this->values.resize(size, 0);
+      this->phases.resize(size, -1);
+      this->levels.resize(size, 0);
+      this->reasons.resize(size, cnf::Propagator::NO_CLAUSE);
+      this->activities.resize(size, 0);
+      this->heapPositions.resize(size, NOT_IN_HEAP);
+      this->seen.resize(size, false);
+      this->watches.resize(2 * size);
+      for (std::size_t newVariable = std::max<std::size_t>(first, 1); newVariable < size; ++newVariable) {
+         this->heapInsert(newVariable);
+      }
+   }
+
+   void CDCL::assign(const int literal, const cnf::ClauseRef reason) {
+      const std::size_t variable = static_cast<std::size_t>(std::abs(literal));
+      this->values[variable] = (literal < 0) ? -1 : 1;
+      this->levels[variable] = this->getLevel();
+      this->reasons[variable] = reason;
+      this->trail.push_back(literal);
+   }
+
+   cnf::ClauseRef CDCL::propagate() {
+      while (this->propagated < this->trail.size()) {
+         const int falsified = -this->trail[this->propagated++];
+         std::vector<cnf::Watch>& list = this->watches[cnf::literalIndex(falsified)];
+
+         std::size_t kept = 0;
+         for (std::size_t i = 0; i < list.size(); ++i) {
+            const cnf::Watch watch = list[i];
+            if (cnf::LITERAL_VALUE::TRUE == this->getValue(watch.blocker)) {
+               list[kept++] = watch;
+               continue;
+            }
+            if (this->arena.isDeleted(watch.clause)) {
+               continue;
+            }
+
+            std::array<int, 2>& pair = this->watched[watch.clause];
+            if (pair[0] == falsified) {
+               std::swap(pair[0], pair[1]);
+            }
+            const int other = pair[0];
+            if (other != watch.blocker && cnf::LITERAL_VALUE::TRUE == this->getValue(other)) {
+               list[kept++] = {watch.clause, other};
+               continue;
+            }
+
+            // look for a literal to watch instead of the falsified one
+            bool moved = false;
+            if (this->arena.size(watch.clause) > 2) {
+               for (const int* literal = this->arena.begin(watch.clause); literal != this->arena.end(watch.clause); ++literal) {
+                  if (*literal != other && *literal != falsified && cnf::LITERAL_VALUE::FALSE != this->getValue(*literal)) {
+                     pair[1] = *literal;
+                     this->watches[cnf::literalIndex(*literal)].push_back({watch.clause, other});
+                     moved = true;
+                     break;
+                  }
+               }
+            }
+            if (moved) {
+               continue;
+            }
+
+            list[kept++] = {watch.clause, other};
+            if (cnf::LITERAL_VALUE::FALSE == this->getValue(other)) {
+               for (++i; i < list.size(); ++i) {
+                  list[kept++] = list[i];
+               }
+               list.resize(kept);
+               this->propagated = this->trail.size();
+               return watch.clause;
+            }
+            this->assign(other, watch.clause);
+         }
+         list.resize(kept);
+      }
+      return cnf::Propagator::NO_CLAUSE;
+   }
+
+   std::size_t CDCL::analyze(const cnf::ClauseRef conflict, std::uint32_t& glue) {
+      this->learnt.assign(1, 0);
+      std::size_t paths = 0;
+      int implied = 0;
+      std::size_t index = this->trail.size();
+      cnf::ClauseRef reason = conflict;
+
+      // resolve the literals of the current decision level away until only one is left
+      do {
+         for (const int* literal = this->arena.begin(reason); literal != this->arena.end(reason); ++literal) {
+            const std::size_t variable = static_cast<std::size_t>(std::abs(*literal));
+            if (*literal == implied || this->seen[variable] || 0 == this->levels[variable]) {
+               continue;
+            }
+            this->bumpVariable(variable);
+            this->seen[variable] = true;
+            if (this->levels[variable] >= this->getLevel()) {
+               ++paths;
+            }
+            else {
+               this->learnt.push_back(*literal);
+            }
+         }
+
+         while (!this->seen[static_cast<std::size_t>(std::abs(this->trail[--index]))]) {
+         }
+         implied = this->trail[index];
+         reason = this->reasons[static_cast<std::size_t>(std::abs(implied))];
+         this->seen[static_cast<std::size_t>(std::abs(implied))] = false;
+         --paths;
+      } while (paths > 0);
+      this->learnt[0] = -implied;
+
+      // drop the literals implied by the other literals of the clause, the marks have to stay until all are checked
+      const std::size_t marked = this->learnt.size();
+      std::size_t kept = 1;
+      for (std::size_t i = 1; i < marked; ++i) {
+         if (!this->isRedundant(this->learnt[i])) {
+            std::swap(this->learnt[kept++], this->learnt[i]);
+         }
+      }
+      for (std::size_t i = 1; i < marked; ++i) {
+         this->seen[static_cast<std::size_t>(std::abs(this->learnt[i]))] = false;
+      }
+      this->learnt.resize(kept);
+
+      glue = 1;
+      if (1 == this->learnt.size()) {
+         return 0;
+      }
+
+      // the literal of the highest other decision level is watched, it is unassigned first after backtracking
+      std::size_t highest = 1;
+      for (std::size_t i = 2; i < this->learnt.size(); ++i) {
+         if (this->levels[static_cast<std::size_t>(std::abs(this->learnt[i]))] > this->levels[static_cast<std::size_t>(std::abs(this->learnt[highest]))]) {
+            highest = i;
+         }
+      }
+      std::swap(this->learnt[1], this->learnt[highest]);
+
+      // the glue is the number of distinct decision levels in the clause
+      this->levelStamps.resize(this->getLevel() + 1, 0);
+      glue = 0;
+      for (const int literal : this->learnt) {
+         const std::size_t level = this->levels[static_cast<std::size_t>(std::abs(literal))];
+         if (this->conflicts != this->levelStamps[level]) {
+            this->levelStamps[level] = this->conflicts;
+            ++glue;
+         }
+      }
+      return this->levels[static_cast<std::size_t>(std::abs(this->learnt[1]))];
+   }
+
+   bool CDCL::isRedundant(const int literal) const {
+      const cnf::ClauseRef reason = this->reasons[static_cast<std::size_t>(std::abs(literal))];
+      if (cnf::Propagator::NO_CLAUSE == reason) {
+         return false;
+      }
+      for (const int* other = this->arena.begin(reason); other != this->arena.end(reason); ++other) {
+         const std::size_t variable = static_cast<std::size_t>(std::abs(*other));
+         if (*other != -literal && !this->seen[variable] && 0 != this->levels[variable]) {
+            return false;
+         }
+      }
+      return true;
+   }
+
+   void CDCL::backtrack(const std::size_t level) {
+      if (this->getLevel() <= level) {
+         return;
+      }
+      for (std::size_t i = this->levelStarts[level]; i < this->trail.size(); ++i) {
+         const std::size_t variable = static_cast<std::size_t>(std::abs(this->trail[i]));
+         this->phases[variable] = this->values[variable];
+         this->values[variable] = 0;
+         this->heapInsert(variable);
+      }
+      this->trail.resize(this->levelStarts[level]);
+      this->levelStarts.resize(level);
+      this->propagated = std::min(this->propagated, this->trail.size());
+   }
+
+   int CDCL::pickBranchLiteral() {
+      while (!this->heap.empty()) {
+         const std::size_t variable = this->heapPop();
+         if (0 == this->values[variable]) {
+            const int literal = static_cast<int>(variable);
+            return (this->phases[variable] > 0) ? literal : -literal;
+         }
+      }
+      return 0;
+   }
+
+   void CDCL::watchClause(const cnf::ClauseRef ref) {
+      if (ref >= this->watched.size()) {
+         this->watched.resize(ref + 1);
+         this->glues.resize(ref + 1, 0);
+      }
+      const int* literals = this->arena.begin(ref);
+      this->watched[ref] = {literals[0], literals[1]};
+      this->watches[cnf::literalIndex(literals[0])].push_back({ref, literals[1]});
+      this->watches[cnf::literalIndex(literals[1])].push_back({ref, literals[0]});
+   }
+
+   bool CDCL::isLocked(const cnf::ClauseRef ref) const {
+      // the literal a clause implied is always one of its watched literals
+      for (const int literal : this->watched[ref]) {
+         if (cnf::LITERAL_VALUE::TRUE == this->getValue(literal) && ref == this->reasons[static_cast<std::size_t>(std::abs(literal))]) {
+            return true;
+         }
+      }
+      return false;
+   }
+
+   void CDCL::reduceLearnts() {
+      std::sort(this->learnts.begin(), this->learnts.end(), [this](const cnf::ClauseRef a, const cnf::ClauseRef b) {
+         if (this->glues[a] != this->glues[b]) {
+            return this->glues[a] > this->glues[b];
+         }
+         return this->arena.size(a) > this->arena.size(b);
+      });
+
+      const std::size_t limit = this->learnts.size() / 2;
+      std::size_t kept = 0;
+      for (std::size_t i = 0; i < this->learnts.size(); ++i) {
+         const cnf::ClauseRef ref = this->learnts[i];
+         if (i < limit && this->glues[ref] > 2 && !this->isLocked(ref)) {
+            this->arena.remove(ref);
+         }
+         else {
+            this->learnts[kept++] = ref;
+         }
+      }
+      util::Utility::logDebug("Removed ", this->learnts.size() - kept, " of ", this->learnts.size(), " learned clauses");
+      this->learnts.resize(kept);
+      this->maxLearnts *= 1.1;
+
+      if (this->arena.isFragmented()) {
+         this->collectGarbage();
+      }
+   }
+
+   void CDCL::collectGarbage() {
+      std::vector<cnf::ClauseRef> order(this->clauses);
+      order.insert(order.end(), this->learnts.begin(), this->learnts.end());
+      const std::vector<cnf::ClauseRef> previous(order);
+
+      std::vector<cnf::ClauseRef> moved(this->arena.getClauses(), cnf::Propagator::NO_CLAUSE);
+      this->arena.compact(order);
+
+      std::vector<std::array<int, 2>> newWatched(order.size());
+      std::vector<std::uint32_t> newGlues(order.size(), 0);
+      for (std::size_t i = 0; i < order.size(); ++i) {
+         moved[previous[i]] = order[i];
+         newWatched[order[i]] = this->watched[previous[i]];
+         newGlues[order[i]] = this->glues[previous[i]];
+      }
+      this->watched = std::move(newWatched);
+      this->glues = std::move(newGlues);
+      this->clauses.assign(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(this->clauses.size()));
+      this->learnts.assign(order.begin() + static_cast<std::ptrdiff_t>(this->clauses.size()), order.end());
+
+      // reasons are locked, so they are never removed
+      for (const int literal : this->trail) {
+         cnf::ClauseRef& reason = this->reasons[static_cast<std::size_t>(std::abs(literal))];
+         if (cnf::Propagator::NO_CLAUSE != reason) {
+            reason = moved[reason];
+         }
+      }
+
+      for (auto& list : this->watches) {
+         list.clear();
+      }
+      for (const cnf::ClauseRef ref : order) {
+         const std::array<int, 2>& pair = this->watched[ref];
+         this->watches[cnf::literalIndex(pair[0])].push_back({ref, pair[1]});
+         this->watches[cnf::literalIndex(pair[1])].push_back({ref, pair[0]});
+      }
+   }
+
+   void CDCL::bumpVariable(const std::size_t variable) {
+      this->activities[variable] += this->increment;
+      if (this->activities[variable] > 1e100) {
+         for (double& activity : this->activities) {
+            activity *= 1e-100;
+         }
+         this->increment *= 1e-100;
+      }
+      if (NOT_IN_HEAP != this->heapPositions[variable]) {
+         this->heapUp(this->heapPositions[variable]);
+      }
+   }
+
+   void CDCL::heapUp(std::size_t position) {
+      const std::size_t variable = this->heap[position];
+      while (position > 0) {
+         const std::size_t parent = (position - 1) / 2;
+         if (this->activities[this->heap[parent]] >= this->activities[variable]) {
+            break;
+         }
+         this->heap[position] = this->heap[parent];
+         this->heapPositions[this->heap[position]] = position;
+         position = parent;
+      }
+      this->heap[position] = variable;
+      this->heapPositions[variable] = position;
+   }
+
+   void CDCL::heapDown(std::size_t position) {
+      const std::size_t variable = this->heap[position];
+      while (2 * position + 1 < this->heap.size()) {
+         std::size_t child = 2 * position + 1;
+         if (child + 1 < this->heap.size() && this->activities[this->heap[child + 1]] > this->activities[this->heap[child]]) {
+            ++child;
+         }
+         if (this->activities[this->heap[child]] <= this->activities[variable]) {
+            break;
+         }
+         this->heap[position] = this->heap[child];
+         this->heapPositions[this->heap[position]] = position;
+         position = child;
+      }
+      this->heap[position] = variable;
+      this->heapPositions[variable] = position;
+   }
+
+   void CDCL::heapInsert(const std::size_t variable) {
+      if (NOT_IN_HEAP != this->heapPositions[variable]) {
+         return;
+      }
+      this->heapPositions[variable] = this->heap.size();
+      this->heap.push_back(variable);
+      this->heapUp(this->heap.size() - 1);
+   }
+
+   std::size_t CDCL::heapPop() {
+      const std::size_t variable = this->heap.front();
+      this->heapPositions[variable] = NOT_IN_HEAP;
+      const std::size_t last = this->heap.back();
+      this->heap.pop_back();
+      if (!this->heap.empty()) {
+         this->heap.front() = last;
+         this->heapPositions[last] = 0;
+         this->heapDown(0);
+      }
+      return variable;
+   }
+
+   std::uint64_t CDCL::luby(std::uint64_t index) {
+      // find the finite subsequence containing the index and its size
+      std::uint64_t size = 1;
+      std::uint64_t sequence = 0;
+      while (size < index + 1) {
+         ++sequence;
+         size = 2 * size + 1;
+      }
+      while (size - 1 != index) {
+         size = (size - 1) >> 1;
+         --sequence;
+         index = index % size;
+      }
+      return std::uint64_t(1) << sequence;
+   }
+
+}
@@ -0,0 +1,429 @@
+/**
+ * @file CDCL.h
+ * @author Anton Reinhard
+ * @brief Built-in CDCL solver header
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include "Solver.h"
+#include "../ClauseArena.h"
+#include "../WatchLists.h"
+#include "../Propagator.h"
+#include "../Utility.h"
+#include "../Model.h"
+#include "../definitions.h"
+
+#include <array>
+#include <vector>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+namespace preppy::solvers {
+
+   /**
+    * @brief A conflict driven clause learning solver running in the same process
+    *
+    * @details The solver keeps its clauses, learned clauses and variable activities between calls of solve(), so a
+    * formula is loaded once and then queried under many different assumptions without writing files or starting a
+    * process. Long clauses are watched with two literals, the decisions follow the variable activities (VSIDS) with
+    * saved phases, conflicts are analyzed to their first unique implication point, restarts follow the Luby sequence
+    * and the learned clauses with the highest glue are removed regularly.
+    *
+    * Like clasp, only isSatisfiable() is limited by the timeout, where a timeout counts as unsatisfiable. getModel()
+    * and solve() always run until they found a model or proved there is none, since their callers need a definite
+    * answer.
+    */
+   class CDCL
+      : public Solver {
+   public:
+
+      /**
+       * @brief Construct a new CDCL solver
+       *
+       * @param timeout Timeout for isSatisfiable(), getModel() and solve() aren't limited
+       */
+      explicit CDCL(const util::clock::duration& timeout);
+
+      /**
+       * @brief Checks whether a formula is satisfiable, loads the formula
+       *
+       * @param formula The formula to check
+       * @return bool True if satisfiable, False if unsatisfiable or the timeout ran out
+       */
+      bool isSatisfiable(cnf::CNF& formula) override;
+
+      /**
+       * @brief Gets a model for the formula, loads the formula. The timeout doesn't apply
+       *
+       * @param formula The formula to get a model for
+       * @return cnf::Model A single model for the formula, or empty if the formula is unsatisfiable
+       */
+      cnf::Model getModel(cnf::CNF& formula) override;
+
+      /**
+       * @brief Loads a formula, the clauses learned for the formula loaded before are dropped
+       *
+       * @param formula The formula to load
+       */
+      void load(const cnf::CNF& formula) override;
+
+      /**
+       * @brief Adds a clause to the loaded formula, the learned clauses stay valid
+       *
+       * @param clause The clause to add
+       */
+      void addClause(const cnf::Clause& clause) override;
+
+      /**
+       * @brief Gets a model for the loaded formula in which all the given literals are true. The timeout doesn't apply
+       *
+       * @param assumptions The literals assumed to be true for this call only
+       * @return cnf::Model A single model, or empty if the loaded formula is unsatisfiable under the assumptions
+       */
+      cnf::Model solve(const cnf::Literals& assumptions = {}) override;
+
+   private:
+
+      /**
+       * @brief Marks a variable that isn't in the decision heap
+       *
+       */
+      static constexpr std::size_t NOT_IN_HEAP = std::numeric_limits<std::size_t>::max();
+
+      /**
+       * @brief Searches for a model under the assumptions, the model is left on the trail
+       *
+       * @param assumptions The literals assumed to be true
+       * @param limited Whether the timeout applies
+       * @return cnf::LITERAL_VALUE TRUE if a model was found, FALSE if there is none and UNASSIGNED on timeout
+       */
+      cnf::LITERAL_VALUE run(const cnf::Literals& assumptions, bool limited);
+
+      /**
+       * @brief Searches until a model is found, the assumptions are refuted or the given number of conflicts happened
+       *
+       * @param conflicts The number of conflicts before restarting
+       * @param assumptions The literals assumed to be true
+       * @return cnf::LITERAL_VALUE TRUE if a model was found, FALSE if there is none and UNASSIGNED for a restart
+       */
+      cnf::LITERAL_VALUE search(std::uint64_t conflicts, const cnf::Literals& assumptions);
+
+      /**
+       * @brief Adds a clause on decision level 0, dropping literals that are false there
+       *
+       * @param first The first literal of the clause
+       * @param last The end of the clause
+       */
+      void addLiterals(const int* first, const int* last);
+
+      /**
+       * @brief Makes sure all data of the solver covers a variable
+       *
+       * @param variable The variable
+       */
+      void addVariable(std::size_t variable);
+
+      /**
+       * @brief Get the value of a literal
+       *
+       * @param literal The literal
+       * @return cnf::LITERAL_VALUE The value under the current assignment
+       */
+      inline cnf::LITERAL_VALUE getValue(const int literal) const {
+         const signed char value = this->values[static_cast<std::size_t>(std::abs(literal))];
+         return static_cast<cnf::LITERAL_VALUE>((literal < 0) ? -value : value);
+      }
+
+      /**
+       * @brief Get the current decision level
+       *
+       * @return std::size_t The number of decisions on the trail
+       */
+      inline std::size_t getLevel() const {
+         return this->levelStarts.size();
+      }
+
+      /**
+       * @brief Assigns a literal true on the current decision level
+       *
+       * @param literal The literal, has to be unassigned
+       * @param reason The clause that implied the literal or cnf::Propagator::NO_CLAUSE
+       */
+      void assign(int literal, cnf::ClauseRef reason);
+
+      /**
+       * @brief Propagates all literals of the trail that weren't propagated yet
+       *
+       * @return cnf::ClauseRef The conflicting clause or cnf::Propagator::NO_CLAUSE
+       */
+      cnf::ClauseRef propagate();
+
+      /**
+       * @brief Analyzes a conflict, leaves the learned clause in learnt with the asserting literal first and the
+       * literal of the highest other decision level second
+       *
+       * @param conflict The conflicting clause
+       * @param glue Will contain the glue of the learned clause
+       * @return std::size_t The decision level to backtrack to
+       */
+      std::size_t analyze(cnf::ClauseRef conflict, std::uint32_t& glue);
+
+      /**
+       * @brief Checks whether a literal of the learned clause is implied by the other literals of the clause
+       *
+       * @param literal The literal
+       * @return bool True if the literal can be removed from the clause
+       */
+      bool isRedundant(int literal) const;
+
+      /**
+       * @brief Unassigns all literals above a decision level and saves their phases
+       *
+       * @param level The decision level to keep
+       */
+      void backtrack(std::size_t level);
+
+      /**
+       * @brief Picks the unassigned variable with the highest activity and returns it in its saved phase
+       *
+       * @return int The literal to decide or 0 if all variables are assigned
+       */
+      int pickBranchLiteral();
+
+      /**
+       * @brief Watches the first two literals of a clause
+       *
+       * @param ref The clause
+       */
+      void watchClause(cnf::ClauseRef ref);
+
+      /**
+       * @brief Checks whether a clause is the reason of an assigned literal
+       *
+       * @param ref The clause
+       * @return bool True if it is a reason
+       */
+      bool isLocked(cnf::ClauseRef ref) const;
+
+      /**
+       * @brief Removes the half of the learned clauses with the highest glue, keeps clauses with a glue of at most 2
+       *
+       */
+      void reduceLearnts();
+
+      /**
+       * @brief Compacts the clause storage and rebuilds the watch lists with the new clause references
+       *
+       */
+      void collectGarbage();
+
+      /**
+       * @brief Increases the activity of a variable
+       *
+       * @param variable The variable
+       */
+      void bumpVariable(std::size_t variable);
+
+      /**
+       * @brief Moves a variable of the decision heap up to its place
+       *
+       * @param position The position of the variable in the heap
+       */
+      void heapUp(std::size_t position);
+
+      /**
+       * @brief Moves a variable of the decision heap down to its place
+       *
+       * @param position The position of the variable in the heap
+       */
+      void heapDown(std::size_t position);
+
+      /**
+       * @brief Inserts a variable into the decision heap, if it isn't in there already
+       *
+       * @param variable The variable
+       */
+      void heapInsert(std::size_t variable);
+
+      /**
+       * @brief Removes the variable with the highest activity from the decision heap
+       *
+       * @return std::size_t The variable
+       */
+      std::size_t heapPop();
+
+      /**
+       * @brief Get an element of the Luby sequence 1, 1, 2, 1, 1, 2, 4, ...
+       *
+       * @param index The index of the element
+       * @return std::uint64_t The element
+       */
+      static std::uint64_t luby(std::uint64_t index);
+
+      /**
+       * @brief Timeout for checking satisfiability
+       *
+       */
+      util::clock::duration timeout;
+
+      /**
+       * @brief The point in time the current call of run() has to stop at, if limited
+       *
+       */
+      util::clock::time_point deadline;
+
+      /**
+       * @brief The clauses of the formula and the learned clauses
+       *
+       */
+      cnf::ClauseArena arena;
+
+      /**
+       * @brief The clauses of the formula with more than one literal
+       *
+       */
+      std::vector<cnf::ClauseRef> clauses;
+
+      /**
+       * @brief The learned clauses with more than one literal
+       *
+       */
+      std::vector<cnf::ClauseRef> learnts;
+
+      /**
+       * @brief The two watched literals of every clause, indexed by clause reference
+       *
+       */
+      std::vector<std::array<int, 2>> watched;
+
+      /**
+       * @brief The glue of every learned clause, the number of decision levels of its literals when it was learned
+       *
+       */
+      std::vector<std::uint32_t> glues;
+
+      /**
+       * @brief The clauses watching every literal, indexed by literalIndex()
+       *
+       */
+      std::vector<std::vector<cnf::Watch>> watches;
+
+      /**
+       * @brief The value of every variable, 1 for true, -1 for false and 0 for unassigned
+       *
+       */
+      std::vector<signed char> values;
+
+      /**
+       * @brief The last value of every variable, used as its phase when it is decided
+       *
+       */
+      std::vector<signed char> phases;
+
+      /**
+       * @brief The decision level of every assigned variable
+       *
+       */
+      std::vector<std::size_t> levels;
+
+      /**
+       * @brief The clause that implied every assigned variable
+       *
+       */
+      std::vector<cnf::ClauseRef> reasons;
+
+      /**
+       * @brief The assigned literals in order of assignment
+       *
+       */
+      cnf::Literals trail;
+
+      /**
+       * @brief The position of the first literal of every decision level on the trail
+       *
+       */
+      std::vector<std::size_t> levelStarts;
+
+      /**
+       * @brief The position of the first literal on the trail that wasn't propagated yet
+       *
+       */
+      std::size_t propagated = 0;
+
+      /**
+       * @brief The activity of every variable
+       *
+       */
+      std::vector<double> activities;
+
+      /**
+       * @brief The amount an activity is increased by, grows with every conflict instead of decaying all activities
+       *
+       */
+      double increment = 1;
+
+      /**
+       * @brief The unassigned variables as a binary heap ordered by activity
+       *
+       */
+      std::vector<std::size_t> heap;
+
+      /**
+       * @brief The position of every variable in the heap or NOT_IN_HEAP
+       *
+       */
+      std::vector<std::size_t> heapPositions;
+
+      /**
+       * @brief Marks the variables visited by analyze()
+       *
+       */
+      std::vector<bool> seen;
+
+      /**
+       * @brief The conflict every decision level was last counted for in the glue of, indexed by decision level
+       *
+       */
+      std::vector<std::uint64_t> levelStamps;
+
+      /**
+       * @brief The clause learned by the last call of analyze()
+       *
+       */
+      cnf::Literals learnt;
+
+      /**
+       * @brief The literals of the clause being added
+       *
+       */
+      cnf::Literals buffer;
+
+      /**
+       * @brief The number of conflicts since the formula was loaded
+       *
+       */
+      std::uint64_t conflicts = 0;
+
+      /**
+       * @brief The number of learned clauses that triggers the next reduction
+       *
+       */
+      double maxLearnts = 0;
+
+      /**
+       * @brief Whether the loaded formula is unsatisfiable without any assumptions
+       *
+       */
+      bool inconsistent = false;
+
+   };
+
+}
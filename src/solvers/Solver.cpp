@@ -23,11 +23,29 @@ namespace preppy::solvers {
       return this->solvername;
    }
 
+   void Solver::load(const cnf::CNF& formula) {
+      this->loadedFormula = formula.snapshot();
+   }
+
+   void Solver::addClause(const cnf::Clause& clause) {
+      this->loadedFormula.push_back(clause);
+   }
+
+   cnf::Model Solver::solve(const cnf::Literals& assumptions) {
+      this->loadedFormula.beginTransaction();
+      for (const int literal : assumptions) {
+         this->loadedFormula.push_back(cnf::Clause({literal}));
+      }
+      cnf::Model model = this->getModel(this->loadedFormula);
+      this->loadedFormula.rollback();
+      return model;
+   }
+
    bool Solver::executeSolver(const std::string& command, cnf::CNF& formula, std::string& solution) {
       util::Utility::startTimer("writeFile");
 
       // Write formula to file
-      if (!formula.writeToFile(this->inFileName, true)) {
+      if (!formula.writeToFile(this->inFileName, true, util::Utility::getThreads())) {
          util::Utility::logError("Couldn't write formula to file ", this->inFileName);
          return false;
       }
@@ -52,6 +52,31 @@ namespace preppy::solvers {
        */
       virtual cnf::Model getModel(cnf::CNF& formula) = 0;
 
+      /**
+       * @brief Loads a formula for a sequence of solve() calls, replacing the formula loaded before
+       * 
+       * @param formula The formula to load, the solver works on its own copy
+       */
+      virtual void load(const cnf::CNF& formula);
+
+      /**
+       * @brief Adds a clause to the loaded formula, it stays for all following calls of solve()
+       * 
+       * @param clause The clause to add
+       */
+      virtual void addClause(const cnf::Clause& clause);
+
+      /**
+       * @brief Gets a model for the loaded formula in which all the given literals are true
+       * 
+       * @details The default implementation adds the assumptions as unit clauses to the loaded formula for the time of
+       * one call of getModel(). Solvers that can keep their state across calls override this
+       * 
+       * @param assumptions The literals assumed to be true for this call only
+       * @return cnf::Model A single model, or empty if the loaded formula is unsatisfiable under the assumptions, or on timeout or error
+       */
+      virtual cnf::Model solve(const cnf::Literals& assumptions = {});
+
       /**
        * @brief Returns the name of this solver
        * 
@@ -77,6 +102,12 @@ namespace preppy::solvers {
        */
       const std::string inFileName = "in.cnf";
 
+      /**
+       * @brief The formula loaded by the default implementation of load()
+       * 
+       */
+      cnf::CNF loadedFormula;
+
    private:
 
       /**
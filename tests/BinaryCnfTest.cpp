@@ -0,0 +1,120 @@
+/**
+ * @file BinaryCnfTest.cpp
+ * @author Anton Reinhard
+ * @brief Tests of the binary cnf format
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "TestUtility.h"
+#include "CNF.h"
+#include "Clause.h"
+#include "io/BinaryCnf.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace preppy;
+
+namespace {
+
+   /**
+    * @brief Get a formula with sparse variables
+    *
+    * @return cnf::CNF The formula
+    */
+   cnf::CNF getFormula() {
+      cnf::CNF formula = {cnf::Clause({1, -7, 20}), cnf::Clause({-20}), cnf::Clause({7, 3}), cnf::Clause({-1, -3, 7, 20})};
+      formula.addProcedure("First Procedure");
+      formula.addProcedure("Second Procedure");
+      formula.setEquivalence(cnf::EQUIVALENCE_TYPE::UNEQUIVALENT);
+      return formula;
+   }
+
+   /**
+    * @brief The clauses, statistics and metadata of a formula survive writing and reading the binary format, the
+    * compression of the formula included
+    *
+    */
+   void testRoundTrip() {
+      cnf::CNF formula = getFormula();
+      const std::vector<cnf::Literals> original = test::getClauses(formula);
+      formula.compress();
+      CHECK(formula.writeToFile("roundtrip.pcnf", true));
+      CHECK(io::hasBinaryCnfExtension("roundtrip.pcnf"));
+      CHECK(!io::hasBinaryCnfExtension("roundtrip.cnf"));
+      CHECK(io::isBinaryCnf("roundtrip.pcnf"));
+
+      io::BinaryCnfReader reader;
+      CHECK(reader.open("roundtrip.pcnf"));
+      CHECK(4 == reader.getClauses());
+      CHECK(10 == reader.getLiterals());
+      CHECK(cnf::EQUIVALENCE_TYPE::UNEQUIVALENT == reader.getMetadata().equivalence);
+      CHECK((reader.getMetadata().procedures == std::vector<std::string>{"First Procedure", "Second Procedure"}));
+      CHECK(4 == reader.getMetadata().maxVariable);
+
+      cnf::CNF read;
+      CHECK(read.readFromFile("roundtrip.pcnf"));
+      CHECK(test::getClauses(formula) == test::getClauses(read));
+      CHECK(test::hasExactStatistics(read));
+      read.decompress();
+      CHECK(original == test::getClauses(read));
+   }
+
+   /**
+    * @brief The binary format is used for any file name when asked for, and detected when reading
+    *
+    */
+   void testExplicitBinary() {
+      cnf::CNF formula = getFormula();
+      CHECK(formula.writeToFile("explicit.cnf", true, 1, true));
+      CHECK(io::isBinaryCnf("explicit.cnf"));
+      cnf::CNF read;
+      CHECK(read.readFromFile("explicit.cnf"));
+      CHECK(test::getClauses(formula) == test::getClauses(read));
+
+      CHECK(formula.writeToFile("text.cnf", true));
+      CHECK(!io::isBinaryCnf("text.cnf"));
+   }
+
+   /**
+    * @brief Damaged files are rejected instead of read
+    *
+    */
+   void testDamagedFiles() {
+      cnf::CNF formula = getFormula();
+      CHECK(formula.writeToFile("valid.pcnf", true));
+      const std::string valid = test::readFile("valid.pcnf");
+      io::BinaryCnfReader reader;
+
+      CHECK(!reader.open(test::writeFile("header.pcnf", valid.substr(0, sizeof(io::BinaryCnfHeader) / 2))));
+      CHECK(!reader.open(test::writeFile("truncated.pcnf", valid.substr(0, valid.size() - 1))));
+
+      // the first literal behind the header and the offset table of the 4 clauses
+      std::string invalidLiteral = valid;
+      const std::int32_t literal = 1000;
+      std::memcpy(&invalidLiteral[sizeof(io::BinaryCnfHeader) + 5 * sizeof(std::uint64_t)], &literal, sizeof(literal));
+      CHECK(!reader.open(test::writeFile("literal.pcnf", invalidLiteral)));
+
+      std::string invalidOffset = valid;
+      const std::uint64_t offset = 1000;
+      std::memcpy(&invalidOffset[sizeof(io::BinaryCnfHeader) + sizeof(std::uint64_t)], &offset, sizeof(offset));
+      CHECK(!reader.open(test::writeFile("offset.pcnf", invalidOffset)));
+
+      cnf::CNF read;
+      CHECK(!read.readFromFile("literal.pcnf"));
+   }
+
+}
+
+int main() {
+   testRoundTrip();
+   testExplicitBinary();
+   testDamagedFiles();
+   return test::result();
+}
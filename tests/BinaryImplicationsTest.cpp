@@ -0,0 +1,171 @@
+/**
+ * @file BinaryImplicationsTest.cpp
+ * @author Anton Reinhard
+ * @brief Tests of the implication graph of the binary clauses
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "TestUtility.h"
+#include "BinaryImplications.h"
+#include "CNF.h"
+#include "Clause.h"
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+using namespace preppy;
+
+namespace {
+
+   /**
+    * @brief Get the literals implied by a literal, from the shared and the own lists
+    *
+    * @param implications The implication graph
+    * @param literal The literal that is set to true
+    * @param removed The references of the removed clauses
+    * @return cnf::Literals The implied literals of clauses that are not removed, sorted
+    */
+   cnf::Literals getImplied(const cnf::BinaryImplications& implications, const int literal,
+                            const std::vector<cnf::ClauseRef>& removed = {}) {
+      cnf::Literals implied;
+      for (const auto* list : {&implications.getShared(literal), &implications[literal]}) {
+         for (const cnf::Implication& implication : *list) {
+            if (std::find(removed.begin(), removed.end(), implication.clause) == removed.end()) {
+               implied.push_back(implication.literal);
+            }
+         }
+      }
+      std::sort(implied.begin(), implied.end());
+      return implied;
+   }
+
+   /**
+    * @brief A binary clause is stored as its two implications, which are removed and restored together
+    *
+    */
+   void testAddRemoveRestore() {
+      cnf::BinaryImplications implications;
+      CHECK(implications.empty());
+      CHECK((cnf::Literals{} == getImplied(implications, 7)));
+
+      implications.add(0, 1, -2);
+      implications.add(1, 1, 3);
+      implications.add(2, -1, 4);
+      CHECK(3 == implications.size());
+      CHECK(10 == implications.getIndexRange());
+      CHECK((cnf::Literals{-2, 3} == getImplied(implications, -1)));
+      CHECK((cnf::Literals{1} == getImplied(implications, 2)));
+      CHECK((cnf::Literals{4} == getImplied(implications, 1)));
+
+      implications.remove(1, 1, 3);
+      CHECK(2 == implications.size());
+      CHECK((cnf::Literals{-2} == getImplied(implications, -1)));
+      CHECK((cnf::Literals{} == getImplied(implications, -3)));
+
+      // removing a clause that isn't stored changes nothing
+      implications.remove(1, 1, 3);
+      CHECK(2 == implications.size());
+
+      implications.restore(1, 1, 3);
+      CHECK(3 == implications.size());
+      CHECK((cnf::Literals{-2, 3} == getImplied(implications, -1)));
+
+      implications.clear(10);
+      CHECK(implications.empty());
+      CHECK(22 == implications.getIndexRange());
+      CHECK((cnf::Literals{} == getImplied(implications, -1)));
+   }
+
+   /**
+    * @brief Shared lists stay unchanged while removals are only counted, and unsharing drops the removed clauses
+    *
+    */
+   void testShare() {
+      std::vector<cnf::ClauseRef> removed;
+      const auto isRemoved = [&removed](const cnf::ClauseRef clause) {
+         return std::find(removed.begin(), removed.end(), clause) != removed.end();
+      };
+
+      cnf::BinaryImplications implications;
+      implications.add(0, 1, 2);
+      implications.add(1, -1, 3);
+      cnf::BinaryImplications copy = implications.share(isRemoved);
+      CHECK(implications.hasShared());
+      CHECK(!implications.isLastSharer());
+      CHECK(implications[-1].empty());
+      CHECK(1 == implications.getShared(-1).size());
+      CHECK(2 == copy.size());
+
+      implications.add(2, 4, 5);
+      removed.push_back(0);
+      implications.remove(0, 1, 2);
+      CHECK(2 == implications.size());
+      CHECK(2 == copy.size());
+      CHECK(12 == implications.getIndexRange());
+      CHECK((cnf::Literals{} == getImplied(implications, -1, removed)));
+      CHECK((cnf::Literals{2} == getImplied(copy, -1)));
+
+      // giving the removed clause back only counts it again
+      removed.clear();
+      implications.restore(0, 1, 2);
+      CHECK(3 == implications.size());
+      CHECK(implications[-1].empty());
+
+      removed.push_back(1);
+      implications.remove(1, -1, 3);
+      implications.unshare(isRemoved);
+      CHECK(!implications.hasShared());
+      CHECK(2 == implications.size());
+      CHECK((cnf::Literals{2} == getImplied(implications, -1)));
+      CHECK((cnf::Literals{} == getImplied(implications, 1)));
+      CHECK((cnf::Literals{5} == getImplied(implications, -4)));
+
+      // the copy still sees the shared clauses and takes the lists over when unsharing
+      CHECK(copy.isLastSharer());
+      copy.unshare([](cnf::ClauseRef) {
+         return false;
+      });
+      CHECK(2 == copy.size());
+      CHECK((cnf::Literals{3} == getImplied(copy, 1)));
+   }
+
+   /**
+    * @brief The graph of a formula holds exactly its binary clauses while clauses are added, removed and shortened
+    *
+    */
+   void testFormula() {
+      cnf::CNF formula = {cnf::Clause({1, -2}), cnf::Clause({1, 2, 3}), cnf::Clause({-3, 4}), cnf::Clause({5})};
+      CHECK(2 == formula.getBinaryImplications().size());
+      CHECK((cnf::Literals{1} == getImplied(formula.getBinaryImplications(), 2)));
+
+      formula.erase(formula.begin());
+      formula.push_back(cnf::Clause({-4, -5}));
+      CHECK(2 == formula.getBinaryImplications().size());
+      CHECK((cnf::Literals{} == getImplied(formula.getBinaryImplications(), 2)));
+      CHECK((cnf::Literals{-5} == getImplied(formula.getBinaryImplications(), 4)));
+
+      // shortening a clause to two literals adds it to the graph
+      formula.eraseIf([](cnf::ClauseView clause) {
+         return clause.setLiteral(-2);
+      });
+      CHECK(3 == formula.getBinaryImplications().size());
+      CHECK((cnf::Literals{3} == getImplied(formula.getBinaryImplications(), -1)));
+
+      formula.pop_back();
+      CHECK(2 == formula.getBinaryImplications().size());
+      CHECK((cnf::Literals{} == getImplied(formula.getBinaryImplications(), 4)));
+   }
+
+}
+
+int main() {
+   testAddRemoveRestore();
+   testShare();
+   testFormula();
+   return test::result();
+}
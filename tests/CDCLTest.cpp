@@ -0,0 +1,226 @@
+/**
+ * @file CDCLTest.cpp
+ * @author Anton Reinhard
+ * @brief Tests of the built-in CDCL solver
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "TestUtility.h"
+#include "CNF.h"
+#include "Clause.h"
+#include "Model.h"
+#include "solvers/CDCL.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace preppy;
+
+namespace {
+
+   /**
+    * @brief Checks whether a model satisfies a formula and all assumptions
+    *
+    * @param model The model
+    * @param formula The formula
+    * @param assumptions The assumed literals
+    * @return bool True if the model satisfies both
+    */
+   bool isSolution(const cnf::Model& model, const cnf::CNF& formula, const cnf::Literals& assumptions) {
+      for (const int literal : assumptions) {
+         if (!model.isTrue(literal)) {
+            return false;
+         }
+      }
+      return model.satisfies(formula);
+   }
+
+   /**
+    * @brief Checks by trying every assignment whether a formula is satisfiable under assumptions
+    *
+    * @param clauses The clauses of the formula
+    * @param variables The number of variables
+    * @param assumptions The assumed literals
+    * @return bool True if an assignment satisfies all clauses and assumptions
+    */
+   bool isSatisfiableByEnumeration(const std::vector<cnf::Literals>& clauses, const unsigned variables,
+      const cnf::Literals& assumptions) {
+      const auto isTrue = [](const unsigned assignment, const int literal) {
+         const bool value = 0 != (assignment >> (std::abs(literal) - 1) & 1u);
+         return (literal > 0) == value;
+      };
+      for (unsigned assignment = 0; assignment < (1u << variables); ++assignment) {
+         bool satisfied = true;
+         for (const int literal : assumptions) {
+            satisfied = satisfied && isTrue(assignment, literal);
+         }
+         for (const auto& clause : clauses) {
+            bool clauseSatisfied = false;
+            for (const int literal : clause) {
+               clauseSatisfied = clauseSatisfied || isTrue(assignment, literal);
+            }
+            satisfied = satisfied && clauseSatisfied;
+         }
+         if (satisfied) {
+            return true;
+         }
+      }
+      return false;
+   }
+
+   /**
+    * @brief A session answers satisfiable and unsatisfiable assumptions and keeps added clauses
+    *
+    */
+   void testSession() {
+      cnf::CNF formula;
+      formula.push_back(cnf::Clause({1, 2}));
+      formula.push_back(cnf::Clause({-1, 3}));
+      formula.push_back(cnf::Clause({-2, 3}));
+
+      solvers::CDCL solver(std::chrono::seconds(5));
+      solver.load(formula);
+
+      const cnf::Model model = solver.solve();
+      CHECK(!model.empty());
+      CHECK(isSolution(model, formula, {}));
+
+      // both ways to satisfy the first clause imply 3
+      CHECK(solver.solve({-3}).empty());
+
+      const cnf::Model withoutOne = solver.solve({-1});
+      CHECK(!withoutOne.empty());
+      CHECK(isSolution(withoutOne, formula, {-1}));
+      CHECK(withoutOne.isTrue(2));
+
+      // assumptions only hold for their own call
+      CHECK(solver.solve({-3}).empty());
+      CHECK(!solver.solve({1, 2}).empty());
+      CHECK(!solver.solve().empty());
+
+      solver.addClause(cnf::Clause({-1}));
+      formula.push_back(cnf::Clause({-1}));
+      const cnf::Model added = solver.solve();
+      CHECK(isSolution(added, formula, {}));
+      CHECK(solver.solve({1}).empty());
+
+      solver.addClause(cnf::Clause({-3}));
+      CHECK(solver.solve().empty());
+      CHECK(solver.solve({2}).empty());
+
+      // loading a formula drops the clauses of the last session
+      solver.load(formula);
+      CHECK(!solver.solve().empty());
+   }
+
+   /**
+    * @brief A formula without clauses still gets a non empty model, an empty model means unsatisfiable
+    *
+    */
+   void testEmptyFormula() {
+      const cnf::CNF formula;
+      solvers::CDCL solver(std::chrono::seconds(5));
+      solver.load(formula);
+      CHECK(!solver.solve().empty());
+
+      solver.addClause(cnf::Clause({4}));
+      const cnf::Model model = solver.solve();
+      CHECK(model.isTrue(4));
+      CHECK(solver.solve({-4}).empty());
+   }
+
+   /**
+    * @brief The pigeon hole formula with 4 pigeons and 3 holes is unsatisfiable
+    *
+    */
+   void testPigeonHole() {
+      const int pigeons = 4;
+      const int holes = 3;
+      const auto variable = [holes](const int pigeon, const int hole) {
+         return pigeon * holes + hole + 1;
+      };
+
+      cnf::CNF formula;
+      for (int pigeon = 0; pigeon < pigeons; ++pigeon) {
+         cnf::Clause clause;
+         for (int hole = 0; hole < holes; ++hole) {
+            clause.push_back(variable(pigeon, hole));
+         }
+         formula.push_back(clause);
+      }
+      for (int hole = 0; hole < holes; ++hole) {
+         for (int first = 0; first < pigeons; ++first) {
+            for (int second = first + 1; second < pigeons; ++second) {
+               formula.push_back(cnf::Clause({-variable(first, hole), -variable(second, hole)}));
+            }
+         }
+      }
+
+      solvers::CDCL solver(std::chrono::seconds(5));
+      CHECK(!solver.isSatisfiable(formula));
+      CHECK(solver.getModel(formula).empty());
+   }
+
+   /**
+    * @brief Random formulas around the phase transition, solved under random assumptions and with clauses added
+    * between the calls, agree with enumerating all assignments
+    *
+    */
+   void testRandomFormulas() {
+      const unsigned variables = 10;
+      std::mt19937 random(42);
+      std::uniform_int_distribution<int> variableDistribution(1, static_cast<int>(variables));
+      std::bernoulli_distribution signDistribution(0.5);
+      const auto randomLiteral = [&]() {
+         const int variable = variableDistribution(random);
+         return signDistribution(random) ? variable : -variable;
+      };
+
+      for (unsigned round = 0; round < 40; ++round) {
+         cnf::CNF formula;
+         std::vector<cnf::Literals> clauses;
+         for (unsigned i = 0; i < 40; ++i) {
+            clauses.push_back({randomLiteral(), randomLiteral(), randomLiteral()});
+            formula.push_back(cnf::Clause({clauses.back()[0], clauses.back()[1], clauses.back()[2]}));
+         }
+
+         solvers::CDCL solver(std::chrono::seconds(5));
+         solver.load(formula);
+         for (unsigned call = 0; call < 8; ++call) {
+            cnf::Literals assumptions;
+            for (unsigned i = 0; i < call % 4; ++i) {
+               assumptions.push_back(randomLiteral());
+            }
+
+            const cnf::Model model = solver.solve(assumptions);
+            const bool expected = isSatisfiableByEnumeration(clauses, variables, assumptions);
+            CHECK(expected == !model.empty());
+            if (!model.empty()) {
+               CHECK(isSolution(model, formula, assumptions));
+            }
+
+            if (1 == call % 3) {
+               clauses.push_back({randomLiteral(), randomLiteral()});
+               const cnf::Clause clause({clauses.back()[0], clauses.back()[1]});
+               formula.push_back(clause);
+               solver.addClause(clause);
+            }
+         }
+      }
+   }
+
+}
+
+int main() {
+   testSession();
+   testEmptyFormula();
+   testPigeonHole();
+   testRandomFormulas();
+   return test::result();
+}
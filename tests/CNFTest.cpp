@@ -0,0 +1,399 @@
+/**
+ * @file CNFTest.cpp
+ * @author Anton Reinhard
+ * @brief Tests of the clause management of CNF
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "TestUtility.h"
+#include "CNF.h"
+#include "Clause.h"
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <vector>
+
+using namespace preppy;
+
+namespace {
+
+   /**
+    * @brief Get a formula with one clause per variable
+    *
+    * @param clauses The number of clauses
+    * @return cnf::CNF The formula with the clauses {i, -(i + 1), i + 2}
+    */
+   cnf::CNF getFormula(const int clauses) {
+      cnf::CNF formula;
+      for (int i = 1; i <= clauses; ++i) {
+         formula.push_back(cnf::Clause({i, -(i + 1), i + 2}));
+      }
+      return formula;
+   }
+
+   /**
+    * @brief Removed clauses are skipped by iteration and indexing while their references stay valid until the
+    * garbage is collected
+    *
+    */
+   void testRemovedClausesAreSkipped() {
+      cnf::CNF formula = getFormula(6);
+      const cnf::ClauseRef last = formula[5].getRef();
+
+      formula.erase(formula.begin());
+      formula.erase(std::next(formula.begin(), 2));
+      CHECK(4 == formula.size());
+      CHECK((test::getClauses(formula) == std::vector<cnf::Literals>{{2, -3, 4}, {3, -4, 5}, {5, -6, 7}, {6, -7, 8}}));
+      CHECK((cnf::Literals{5, -6, 7} == test::getLiterals(formula[2])));
+      CHECK(4 == std::distance(formula.begin(), formula.end()));
+
+      // the references of the other clauses are unchanged
+      CHECK(!formula.isRemoved(last));
+      CHECK((cnf::Literals{6, -7, 8} == test::getLiterals(formula.getClause(last))));
+      CHECK(test::hasExactStatistics(formula));
+
+      formula.erase(formula.begin(), formula.end());
+      CHECK(0 == formula.size());
+      CHECK(formula.begin() == formula.end());
+      CHECK(test::hasExactStatistics(formula));
+   }
+
+   /**
+    * @brief Collecting garbage compacts the clause storage once most of it is removed, keeping the clause order
+    *
+    */
+   void testCollectGarbage() {
+      cnf::CNF formula = getFormula(10);
+      for (int i = 0; i < 7; ++i) {
+         formula.erase(std::next(formula.begin(), 1));
+      }
+      const std::vector<cnf::Literals> clauses = test::getClauses(formula);
+      CHECK(3 == clauses.size());
+
+      formula.collectGarbage();
+      CHECK(clauses == test::getClauses(formula));
+      for (cnf::ClauseRef ref = 0; ref < 3; ++ref) {
+         CHECK(!formula.isRemoved(ref));
+         CHECK(clauses[ref] == test::getLiterals(formula.getClause(ref)));
+      }
+      CHECK(test::hasExactStatistics(formula));
+
+      // after compaction new clauses are added behind the kept ones
+      formula.push_back(cnf::Clause({-1, -2}));
+      CHECK(3 == formula.back().getRef());
+   }
+
+   /**
+    * @brief eraseIf removes every clause in one pass, and may change the clauses it keeps
+    *
+    */
+   void testEraseIf() {
+      cnf::CNF formula = getFormula(5);
+      formula.eraseIf([](cnf::ClauseView clause) {
+         return clause.setLiteral(-3);
+      });
+      CHECK((test::getClauses(formula) == std::vector<cnf::Literals>{{1, -2}, {-4, 5}, {4, -5, 6}, {5, -6, 7}}));
+      CHECK(test::hasExactStatistics(formula));
+
+      formula.eraseIf([](cnf::ClauseView) {
+         return true;
+      });
+      CHECK(0 == formula.size());
+      CHECK(0 == formula.getVariables());
+   }
+
+   /**
+    * @brief A snapshot and its formula keep their own clauses through every kind of change without copying the clause
+    * storage, and the snapshot outlives the formula
+    *
+    */
+   void testSnapshot() {
+      cnf::CNF formula = getFormula(4);
+      formula.enableOccurrenceLists();
+      const std::vector<cnf::Literals> clauses = test::getClauses(formula);
+
+      cnf::CNF snapshot = formula.snapshot();
+      CHECK(formula.isShared());
+      CHECK(clauses == test::getClauses(snapshot));
+      const cnf::ClauseRef first = formula[0].getRef();
+
+      // changes of the formula leave the snapshot alone
+      formula.push_back(cnf::Clause({-1, -2}));
+      formula.erase(formula.begin());
+      formula.eraseIf([](cnf::ClauseView clause) {
+         return clause.setLiteral(-3);
+      });
+      formula.renameVariable(6, 7);
+      CHECK(clauses == test::getClauses(snapshot));
+      CHECK(test::hasExactStatistics(snapshot));
+      CHECK(test::hasExactStatistics(formula));
+      const std::vector<cnf::Literals> changed = test::getClauses(formula);
+      CHECK((changed == std::vector<cnf::Literals>{{-4, 5}, {4, -5, 7}, {-1, -2}}));
+      // the removed clause is only removed from the formula, which still shares the storage
+      CHECK(formula.isShared());
+      CHECK(formula.isRemoved(first));
+      CHECK(!snapshot.isRemoved(first));
+      CHECK(1 == formula.getOccurrenceCount(7) && 0 == formula.getOccurrenceCount(6));
+
+      // giving back a shared clause doesn't change the storage either
+      snapshot.beginTransaction();
+      snapshot.erase(snapshot.begin());
+      CHECK(snapshot.isRemoved(first));
+      CHECK(snapshot.rollback());
+      CHECK(clauses == test::getClauses(snapshot));
+      CHECK(!snapshot.isRemoved(first));
+      CHECK(test::hasExactStatistics(snapshot));
+
+      // and changes of the snapshot leave the formula alone
+      snapshot.pop_back();
+      snapshot.push_back(cnf::Clause({8, -9}));
+      snapshot.erase(snapshot.begin());
+      CHECK((test::getClauses(snapshot) == std::vector<cnf::Literals>{{2, -3, 4}, {3, -4, 5}, {8, -9}}));
+      CHECK(changed == test::getClauses(formula));
+      CHECK(1 == snapshot.getBinaryImplications().size());
+      CHECK(2 == formula.getBinaryImplications().size());
+
+      // a snapshot of a snapshot is independent of both
+      cnf::CNF nested = snapshot.snapshot();
+      nested.disableOccurrenceLists();
+      nested.renameVariable(3, 1);
+      CHECK((test::getClauses(nested) == std::vector<cnf::Literals>{{2, -1, 4}, {1, -4, 5}, {8, -9}}));
+      CHECK(test::hasExactStatistics(nested));
+      nested.eraseIf([](cnf::ClauseView) {
+         return true;
+      });
+      CHECK(0 == nested.size());
+      CHECK(3 == snapshot.size());
+      CHECK(snapshot.isShared());
+
+      // a compaction is rolled back while a snapshot shares the compacted storage
+      cnf::CNF compacted = getFormula(4);
+      compacted.beginTransaction();
+      compacted.erase(compacted.begin());
+      compacted.compact();
+      const cnf::CNF compactedSnapshot = compacted.snapshot();
+      CHECK(compacted.rollback());
+      CHECK(test::getClauses(compacted) == clauses);
+      CHECK((test::getClauses(compactedSnapshot) == std::vector<cnf::Literals>(clauses.begin() + 1, clauses.end())));
+
+      formula = cnf::CNF();
+      CHECK((test::getClauses(snapshot) == std::vector<cnf::Literals>{{2, -3, 4}, {3, -4, 5}, {8, -9}}));
+      snapshot.collectGarbage();
+      CHECK((test::getClauses(snapshot) == std::vector<cnf::Literals>{{2, -3, 4}, {3, -4, 5}, {8, -9}}));
+      CHECK(test::hasExactStatistics(snapshot));
+   }
+
+   /**
+    * @brief Rolling a transaction back restores the clauses in their order, the lists and the statistics, committing
+    * keeps the changes until an enclosing transaction is rolled back
+    *
+    */
+   void testTransactions() {
+      cnf::CNF formula = getFormula(5);
+      formula.enableOccurrenceLists();
+      const std::vector<cnf::Literals> clauses = test::getClauses(formula);
+      const std::vector<unsigned> occurrences = formula.countVariables();
+      CHECK(!formula.commit());
+      CHECK(!formula.rollback());
+
+      formula.beginTransaction();
+      formula.push_back(cnf::Clause({-1, 8}));
+      formula.erase(std::next(formula.begin()));
+      formula.eraseLiteral(formula[0].getRef(), -2);
+      CHECK(formula.rollback());
+      CHECK(clauses == test::getClauses(formula));
+      CHECK(occurrences == formula.countVariables());
+      CHECK(test::hasExactStatistics(formula));
+      CHECK(0 == formula.getBinaryImplications().size());
+      CHECK(1 == formula.getOccurrenceCount(-2));
+
+      // changes of the whole formula are undone as well
+      formula.beginTransaction();
+      formula.eraseIf([](cnf::ClauseView clause) {
+         return clause.setLiteral(4);
+      });
+      formula.renameVariable(7, 9);
+      formula.compact();
+      CHECK(3 == formula.size());
+      CHECK(formula.rollback());
+      CHECK(clauses == test::getClauses(formula));
+      CHECK(test::hasExactStatistics(formula));
+      CHECK(1 == formula.getOccurrenceCount(7));
+      CHECK(0 == formula.getOccurrenceCount(9));
+
+      // a committed inner transaction is undone with the outer one
+      formula.beginTransaction();
+      formula.pop_back();
+      formula.beginTransaction();
+      formula.push_back(cnf::Clause({2, 3}));
+      CHECK(formula.commit());
+      const std::vector<cnf::Literals> changed = test::getClauses(formula);
+      CHECK((changed.back() == cnf::Literals{2, 3}));
+      CHECK(5 == changed.size());
+      formula.beginTransaction();
+      formula.erase(formula.begin(), formula.end());
+      CHECK(formula.rollback());
+      CHECK(changed == test::getClauses(formula));
+      CHECK(formula.rollback());
+      CHECK(clauses == test::getClauses(formula));
+      CHECK(test::hasExactStatistics(formula));
+
+      formula.beginTransaction();
+      formula.pop_back();
+      CHECK(formula.commit());
+      CHECK(!formula.rollback());
+      CHECK(4 == formula.size());
+   }
+
+   /**
+    * @brief The statistics kept by the formula match a count over the clauses after every change, including changes
+    * inside transactions that are rolled back
+    *
+    */
+   void testStatistics() {
+      std::mt19937 random(17);
+      std::uniform_int_distribution<int> operations(0, 9);
+      std::uniform_int_distribution<int> variables(1, 12);
+      std::bernoulli_distribution sign(0.5);
+      const auto randomLiteral = [&]() {
+         const int variable = variables(random);
+         return sign(random) ? variable : -variable;
+      };
+
+      cnf::CNF formula = getFormula(8);
+      formula.beginTransaction();
+      for (unsigned step = 0; step < 3000; ++step) {
+         const std::size_t size = formula.size();
+         switch (operations(random)) {
+         case 0:
+         case 1:
+         {
+            cnf::Clause clause;
+            for (int length = 1 + variables(random) % 4; length > 0; --length) {
+               const int literal = randomLiteral();
+               if (!clause.containsLiteral(literal) && !clause.containsLiteral(-literal)) {
+                  clause.push_back(literal);
+               }
+            }
+            formula.push_back(clause);
+            break;
+         }
+         case 2:
+            if (0 != size) {
+               formula.erase(std::next(formula.begin(), variables(random) % size));
+            }
+            break;
+         case 3:
+            if (0 != size) {
+               formula.pop_back();
+            }
+            break;
+         case 4:
+         {
+            // an empty clause would end the formula, so only literals that leave a literal in every clause are set
+            const int literal = randomLiteral();
+            const bool conflicts = std::any_of(formula.begin(), formula.end(), [literal](const cnf::ClauseView& clause) {
+               return std::all_of(clause.begin(), clause.end(), [literal](const int other) {
+                  return other == -literal;
+               });
+            });
+            if (!conflicts) {
+               formula.eraseIf([literal](cnf::ClauseView clause) {
+                  return clause.setLiteral(literal);
+               });
+            }
+            break;
+         }
+         case 5:
+            if (0 != size) {
+               const auto clause = *std::next(formula.begin(), variables(random) % size);
+               if (clause.size() > 1) {
+                  formula.eraseLiteral(clause.getRef(), clause[0]);
+               }
+            }
+            break;
+         case 6:
+            // renaming onto a used variable merges the occurrences
+            formula.renameVariable(variables(random), variables(random));
+            break;
+         case 7:
+            formula.collectGarbage();
+            break;
+         case 8:
+            if (formula.rollback()) {
+               CHECK(test::hasExactStatistics(formula));
+            }
+            formula.beginTransaction();
+            break;
+         default:
+            formula.commit();
+            formula.beginTransaction();
+            break;
+         }
+         CHECK(test::hasExactStatistics(formula));
+      }
+   }
+
+   /**
+    * @brief Moving takes the clauses, lists and statistics over, clones are independent of their formula
+    *
+    */
+   void testMoveAndClone() {
+      cnf::CNF formula = getFormula(4);
+      formula.enableOccurrenceLists();
+      const std::vector<cnf::Literals> clauses = test::getClauses(formula);
+
+      cnf::CNF moved(std::move(formula));
+      CHECK(0 == formula.size());
+      CHECK(clauses == test::getClauses(moved));
+      CHECK(moved.hasOccurrenceLists());
+      CHECK(1 == moved.getOccurrenceCount(-3));
+      CHECK(test::hasExactStatistics(moved));
+
+      // move assignment swaps the content
+      cnf::CNF other = {cnf::Clause({-1, 2})};
+      other = std::move(moved);
+      CHECK(clauses == test::getClauses(other));
+      CHECK((test::getClauses(moved) == std::vector<cnf::Literals>{{-1, 2}}));
+      CHECK(1 == moved.getBinaryImplications().size());
+
+      cnf::CNF clone = other.clone();
+      CHECK(!clone.isShared() && !other.isShared());
+      clone.eraseIf([](cnf::ClauseView clause) {
+         return clause.setLiteral(3);
+      });
+      clone.renameVariable(6, 1);
+      CHECK(clauses == test::getClauses(other));
+      CHECK((test::getClauses(clone) == std::vector<cnf::Literals>{{2, 4}, {4, -5, 1}}));
+      CHECK(clone.hasOccurrenceLists());
+      CHECK(1 == clone.getOccurrenceCount(1));
+      CHECK(1 == other.getOccurrenceCount(1));
+      CHECK(test::hasExactStatistics(clone));
+      CHECK(test::hasExactStatistics(other));
+
+      // replacing a formula inside a transaction is undone by the rollback
+      other.beginTransaction();
+      other = std::move(clone);
+      CHECK(2 == other.size());
+      CHECK(other.rollback());
+      CHECK(clauses == test::getClauses(other));
+      CHECK(test::hasExactStatistics(other));
+   }
+
+}
+
+int main() {
+   testRemovedClausesAreSkipped();
+   testCollectGarbage();
+   testEraseIf();
+   testSnapshot();
+   testTransactions();
+   testStatistics();
+   testMoveAndClone();
+   return test::result();
+}
@@ -0,0 +1,158 @@
+/**
+ * @file ClauseArenaTest.cpp
+ * @author Anton Reinhard
+ * @brief Tests of the contiguous clause storage
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "TestUtility.h"
+#include "ClauseArena.h"
+
+#include <vector>
+
+using namespace preppy;
+
+namespace {
+
+   /**
+    * @brief Get the literals of a clause in an arena
+    *
+    * @param arena The arena
+    * @param ref The clause
+    * @return cnf::Literals The literals of the clause
+    */
+   cnf::Literals getLiterals(const cnf::ClauseArena& arena, const cnf::ClauseRef ref) {
+      return cnf::Literals(arena.begin(ref), arena.end(ref));
+   }
+
+   /**
+    * @brief Added clauses get consecutive references and keep their literals, also when copied from the arena itself
+    *
+    */
+   void testAdd() {
+      cnf::ClauseArena arena;
+      const cnf::Literals first = {3, -1, 2};
+      const cnf::Literals second = {-4};
+      CHECK(0 == arena.add(first.data(), first.data() + first.size()));
+      CHECK(1 == arena.add(second.data(), second.data() + second.size()));
+      CHECK(2 == arena.add(nullptr, nullptr));
+
+      // adding a clause from the arena itself reallocates the buffer while copying
+      for (unsigned i = 0; i < 100; ++i) {
+         arena.add(arena.begin(0), arena.end(0));
+      }
+      CHECK(103 == arena.getClauses());
+      CHECK(first == getLiterals(arena, 0));
+      CHECK(second == getLiterals(arena, 1));
+      CHECK(0 == arena.size(2));
+      CHECK(first == getLiterals(arena, 102));
+      CHECK(0 == *arena.end(102));
+
+      CHECK(!arena.isNormalized(0));
+      CHECK(arena.isNormalized(1));
+   }
+
+   /**
+    * @brief A 0 terminated buffer is taken over as it is
+    *
+    */
+   void testAdopt() {
+      cnf::ClauseArena arena;
+      arena.adopt({1, 2, 0, -3, 0, 5, 4, 0}, 3);
+      CHECK(3 == arena.getClauses());
+      CHECK((cnf::Literals{1, 2} == getLiterals(arena, 0)));
+      CHECK((cnf::Literals{-3} == getLiterals(arena, 1)));
+      CHECK((cnf::Literals{5, 4} == getLiterals(arena, 2)));
+      CHECK(arena.isNormalized(0));
+      CHECK(!arena.isNormalized(2));
+      CHECK(0 == arena.getWastedLiterals());
+   }
+
+   /**
+    * @brief Removed clauses and literals are counted as wasted until the arena is compacted
+    *
+    */
+   void testRemoveAndCompact() {
+      cnf::ClauseArena arena;
+      arena.adopt({1, 2, 3, 0, -1, 0, 4, 5, 6, 7, 0, 2, -3, 0}, 4);
+
+      arena.remove(2);
+      CHECK(arena.isDeleted(2));
+      CHECK(5 == arena.getWastedLiterals());
+      arena.remove(2);
+      CHECK(5 == arena.getWastedLiterals());
+      arena.restore(2);
+      CHECK(!arena.isDeleted(2));
+      CHECK(0 == arena.getWastedLiterals());
+
+      arena.remove(2);
+      arena.resize(0, 1);
+      CHECK((cnf::Literals{1} == getLiterals(arena, 0)));
+      CHECK(7 == arena.getWastedLiterals());
+      CHECK(!arena.isFragmented());
+      arena.remove(3);
+      CHECK(arena.isFragmented());
+
+      std::vector<cnf::ClauseRef> order = {1, 0};
+      arena.compact(order);
+      CHECK((order == std::vector<cnf::ClauseRef>{0, 1}));
+      CHECK(2 == arena.getClauses());
+      CHECK((cnf::Literals{-1} == getLiterals(arena, 0)));
+      CHECK((cnf::Literals{1} == getLiterals(arena, 1)));
+      CHECK(0 == arena.getWastedLiterals());
+      CHECK(!arena.isDeleted(0) && !arena.isDeleted(1));
+   }
+
+   /**
+    * @brief Truncating gives the slots of the dropped clauses back
+    *
+    */
+   void testTruncate() {
+      cnf::ClauseArena arena;
+      arena.adopt({1, 2, 0, 3, 0, 4, 5, 0}, 3);
+      arena.remove(1);
+      arena.resize(0, 1);
+      CHECK(3 == arena.getWastedLiterals());
+      arena.truncate(1);
+      CHECK(1 == arena.getClauses());
+      CHECK(1 == arena.getWastedLiterals());
+      arena.truncate(5);
+      CHECK(1 == arena.getClauses());
+   }
+
+   /**
+    * @brief Setting literals on a view satisfies the clause, removes false literals and leaves {0} when all are false
+    *
+    */
+   void testSetLiteral() {
+      cnf::ClauseArena arena;
+      arena.adopt({1, -2, 3, 0, 2, 0}, 2);
+
+      cnf::ClauseView clause(&arena, 0);
+      CHECK(!clause.setLiteral(4));
+      CHECK(3 == clause.size());
+      CHECK(!clause.setLiteral(2));
+      CHECK((cnf::Literals{1, 3} == getLiterals(arena, 0)));
+      CHECK(!clause.containsLiteral(-2));
+      CHECK(clause.setLiteral(3));
+      CHECK(clause.empty());
+
+      cnf::ClauseView unit(&arena, 1);
+      CHECK(!unit.setLiteral(-2));
+      CHECK((cnf::Literals{0} == getLiterals(arena, 1)));
+   }
+
+}
+
+int main() {
+   testAdd();
+   testAdopt();
+   testRemoveAndCompact();
+   testTruncate();
+   testSetLiteral();
+   return test::result();
+}
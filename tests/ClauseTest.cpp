@@ -0,0 +1,215 @@
+/**
+ * @file ClauseTest.cpp
+ * @author Anton Reinhard
+ * @brief Tests of clauses and their signatures
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "TestUtility.h"
+#include "Clause.h"
+#include "ClauseArena.h"
+#include "SmallVector.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace preppy;
+
+namespace {
+
+   /**
+    * @brief Checks whether every literal of a clause has its bit in the clause's signature
+    *
+    * @param clause The clause
+    * @return bool True if the signature covers the literals
+    */
+   bool coversLiterals(const cnf::Clause& clause) {
+      for (const int literal : clause) {
+         if (0 == (clause.getSignature() & cnf::literalSignature(literal))) {
+            return false;
+         }
+      }
+      return true;
+   }
+
+   /**
+    * @brief The signature covers the literals through every change of the clause
+    *
+    */
+   void testSignature() {
+      cnf::Clause clause({3, -70, 5});
+      CHECK(cnf::computeSignature(clause.data(), clause.data() + clause.size()) == clause.getSignature());
+      // literals 64 indices apart share a bit
+      CHECK(cnf::literalSignature(1) == cnf::literalSignature(33));
+      CHECK(cnf::literalSignature(1) != cnf::literalSignature(-1));
+
+      clause.push_back(-8);
+      clause.insert(clause.begin(), 100);
+      CHECK(coversLiterals(clause));
+      clause.erase(clause.begin() + 1);
+      CHECK(cnf::computeSignature(clause.data(), clause.data() + clause.size()) == clause.getSignature());
+      clause.renameVariable(5, 6);
+      CHECK(coversLiterals(clause));
+      CHECK(clause.containsLiteral(6));
+      CHECK(!clause.containsLiteral(5));
+      CHECK(!clause.setLiteral(-6));
+      CHECK(coversLiterals(clause));
+      CHECK(!clause.containsLiteral(6));
+   }
+
+   /**
+    * @brief Subsumption with signatures agrees with comparing the literals, for clauses and for clauses in an arena,
+    * normalized or not
+    *
+    */
+   void testSubsumption() {
+      std::mt19937 random(11);
+      // few variables make subsumption likely, variables far apart make signature bits collide
+      std::uniform_int_distribution<int> variables(0, 5);
+      std::uniform_int_distribution<int> lengths(0, 4);
+      std::bernoulli_distribution sign(0.5);
+      const auto randomClause = [&]() {
+         cnf::Clause clause;
+         const int length = lengths(random);
+         while (static_cast<int>(clause.size()) < length) {
+            const int variable = 1 + variables(random) * 32;
+            const int literal = sign(random) ? variable : -variable;
+            if (!clause.containsLiteral(literal)) {
+               clause.push_back(literal);
+            }
+         }
+         return clause;
+      };
+
+      unsigned subsumed = 0;
+      for (unsigned round = 0; round < 2000; ++round) {
+         cnf::Clause first = randomClause();
+         cnf::Clause second = randomClause();
+         if (0 == round % 2) {
+            first.normalize();
+            second.normalize();
+         }
+         const bool expected = std::all_of(first.begin(), first.end(), [&second](const int literal) {
+            return std::find(second.begin(), second.end(), literal) != second.end();
+         });
+         subsumed += expected ? 1 : 0;
+         CHECK(expected == first.subsumes(second));
+
+         cnf::ClauseArena arena;
+         const cnf::ClauseRef firstRef = arena.add(first.data(), first.data() + first.size());
+         const cnf::ClauseRef secondRef = arena.add(second.data(), second.data() + second.size());
+         CHECK(expected == cnf::ClauseView(&arena, firstRef).subsumes(cnf::ClauseView(&arena, secondRef)));
+      }
+      CHECK(subsumed > 100);
+   }
+
+   /**
+    * @brief Normalized clauses are sorted and free of duplicates, and stay that way while literals are added in order
+    *
+    */
+   void testNormalize() {
+      cnf::Clause clause({5, -2, 5, 2, -7, -2});
+      CHECK(!clause.isNormalized());
+      clause.normalize();
+      CHECK(clause.isNormalized());
+      CHECK((cnf::Literals{2, -2, 5, -7} == cnf::Literals(clause.begin(), clause.end())));
+
+      // push_back inserts at the sorted position and skips literals that are already there
+      clause.push_back(-5);
+      clause.push_back(1);
+      clause.push_back(2);
+      CHECK(clause.isNormalized());
+      CHECK((cnf::Literals{1, 2, -2, 5, -5, -7} == cnf::Literals(clause.begin(), clause.end())));
+      CHECK(clause.containsLiteral(-5));
+      CHECK(!clause.containsLiteral(7));
+
+      CHECK(!clause.setLiteral(-1));
+      CHECK(clause.isNormalized());
+      CHECK(!clause.containsLiteral(1));
+
+      clause.insert(clause.begin(), 9);
+      CHECK(!clause.isNormalized());
+      CHECK(clause.containsLiteral(9));
+      CHECK(clause.containsLiteral(-7));
+
+      cnf::ClauseArena arena;
+      const cnf::Literals sorted = {1, -1, 4};
+      const cnf::Literals unsorted = {4, 1};
+      CHECK(arena.isNormalized(arena.add(sorted.data(), sorted.data() + sorted.size())));
+      CHECK(!arena.isNormalized(arena.add(unsorted.data(), unsorted.data() + unsorted.size())));
+   }
+
+   /**
+    * @brief The small vector behaves like std::vector while it moves between inline and heap storage
+    *
+    */
+   void testSmallVector() {
+      std::mt19937 random(5);
+      std::uniform_int_distribution<int> operations(0, 6);
+      std::uniform_int_distribution<int> values(-50, 50);
+
+      util::SmallVector<int, 4> small;
+      std::vector<int> expected;
+      for (unsigned step = 0; step < 5000; ++step) {
+         const int value = values(random);
+         switch (operations(random)) {
+         case 0:
+         case 1:
+            small.push_back(value);
+            expected.push_back(value);
+            break;
+         case 2:
+            if (!expected.empty()) {
+               small.pop_back();
+               expected.pop_back();
+            }
+            break;
+         case 3:
+         {
+            const std::size_t position = expected.empty() ? 0 : static_cast<std::size_t>(std::abs(value)) % expected.size();
+            small.insert(small.begin() + position, 2, value);
+            expected.insert(expected.begin() + position, 2, value);
+            break;
+         }
+         case 4:
+            if (!expected.empty()) {
+               const std::size_t position = static_cast<std::size_t>(std::abs(value)) % expected.size();
+               small.erase(small.begin() + position);
+               expected.erase(expected.begin() + position);
+            }
+            break;
+         case 5:
+         {
+            const std::size_t size = static_cast<std::size_t>(std::abs(value)) % 7;
+            small.resize(size, value);
+            expected.resize(size, value);
+            break;
+         }
+         default:
+         {
+            // copies and moves keep the elements, inline or not
+            util::SmallVector<int, 4> copy(small);
+            small = std::move(copy);
+            break;
+         }
+         }
+         CHECK(expected == std::vector<int>(small.begin(), small.end()));
+         CHECK(small.isInline() == (small.capacity() == 4));
+      }
+   }
+
+}
+
+int main() {
+   testSignature();
+   testSubsumption();
+   testNormalize();
+   testSmallVector();
+   return test::result();
+}
@@ -0,0 +1,123 @@
+/**
+ * @file CompressedInputTest.cpp
+ * @author Anton Reinhard
+ * @brief Tests of reading compressed cnf input
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "TestUtility.h"
+#include "CNF.h"
+#include "io/StreamingInput.h"
+
+#include <string>
+#include <vector>
+
+#ifdef PREPPY_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+using namespace preppy;
+
+namespace {
+
+   /**
+    * @brief Generates a cnf text, large enough to fill several blocks of the streaming input
+    *
+    * @param clauses The number of clauses
+    * @return std::string The cnf text
+    */
+   std::string generateCnf(const unsigned clauses) {
+      std::string text = "c generated\np cnf 1000 " + std::to_string(clauses) + "\n";
+      for (unsigned clause = 0; clause < clauses; ++clause) {
+         const int variable = static_cast<int>(clause % 997) + 1;
+         text += std::to_string(variable) + " -" + std::to_string(1000 - variable) + " " + std::to_string(variable + 3)
+            + " 0\n";
+      }
+      return text;
+   }
+
+   /**
+    * @brief Uncompressed files are detected as such
+    *
+    */
+   void testDetectPlain() {
+      const std::string file = test::writeFile("plain.cnf", generateCnf(10));
+      CHECK(io::COMPRESSION::NONE == io::detectCompression(file));
+      CHECK(io::COMPRESSION::NONE == io::detectCompression("missing.cnf"));
+   }
+
+#ifdef PREPPY_HAVE_ZLIB
+
+   /**
+    * @brief Writes a gzip compressed file
+    *
+    * @param name The file name
+    * @param content The uncompressed content
+    * @return std::string The file name
+    */
+   std::string writeGzip(const std::string& name, const std::string& content) {
+      gzFile file = gzopen(name.c_str(), "wb");
+      gzwrite(file, content.data(), static_cast<unsigned>(content.size()));
+      gzclose(file);
+      return name;
+   }
+
+   /**
+    * @brief A gzip file spanning several blocks reads the same clauses as the plain file
+    *
+    */
+   void testGzip() {
+      const std::string text = generateCnf(300000);
+      CHECK(text.size() > 3 << 20);
+
+      cnf::CNF plain;
+      CHECK(plain.readFromFile(test::writeFile("large.cnf", text)));
+      const std::string file = writeGzip("large.cnf.gz", text);
+      CHECK(io::COMPRESSION::GZIP == io::detectCompression(file));
+      cnf::CNF compressed;
+      CHECK(compressed.readFromFile(file));
+      CHECK(300000 == compressed.size());
+      CHECK(test::getClauses(plain) == test::getClauses(compressed));
+      CHECK(test::hasExactStatistics(compressed));
+   }
+
+   /**
+    * @brief Concatenated gzip members are read one after the other
+    *
+    */
+   void testConcatenatedMembers() {
+      const std::string first = test::readFile(writeGzip("first.gz", "p cnf 3 2\n1 2 0\n-2 "));
+      const std::string second = test::readFile(writeGzip("second.gz", "3 0\n"));
+
+      cnf::CNF formula;
+      CHECK(formula.readFromFile(test::writeFile("concatenated.cnf.gz", first + second)));
+      CHECK((test::getClauses(formula) == std::vector<cnf::Literals>{{1, 2}, {-2, 3}}));
+   }
+
+   /**
+    * @brief Truncated compressed input is an error
+    *
+    */
+   void testTruncated() {
+      const std::string compressed = test::readFile(writeGzip("complete.cnf.gz", generateCnf(1000)));
+      cnf::CNF formula;
+      CHECK(!formula.readFromFile(test::writeFile("truncated.cnf.gz", compressed.substr(0, compressed.size() / 2))));
+   }
+
+#endif
+
+}
+
+int main() {
+   testDetectPlain();
+#ifdef PREPPY_HAVE_ZLIB
+   testGzip();
+   testConcatenatedMembers();
+   testTruncated();
+#endif
+   return test::result();
+}
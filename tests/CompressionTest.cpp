@@ -0,0 +1,149 @@
+/**
+ * @file CompressionTest.cpp
+ * @author Anton Reinhard
+ * @brief Tests of compressing and decompressing the variables of formulas and models
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "TestUtility.h"
+#include "CNF.h"
+#include "Clause.h"
+#include "Model.h"
+
+#include <vector>
+
+using namespace preppy;
+
+namespace {
+
+   /**
+    * @brief Get the original formula of the tests, using the variables 1, 2, 3, 6 and 9
+    *
+    * @return cnf::CNF The formula
+    */
+   cnf::CNF getFormula() {
+      return cnf::CNF({cnf::Clause({1, -3}), cnf::Clause({3, 6, -9}), cnf::Clause({-1, 9}), cnf::Clause({-6, 1}),
+                       cnf::Clause({2})});
+   }
+
+   /**
+    * @brief Finds a model of a formula by trying every assignment
+    *
+    * @param formula The formula, with at most 20 variables
+    * @param model The model to fill
+    * @return bool True if the formula is satisfiable
+    */
+   bool findModel(cnf::CNF& formula, cnf::Model& model) {
+      const unsigned variables = formula.getMaxVariable();
+      for (unsigned assignment = 0; assignment < (1u << variables); ++assignment) {
+         model = cnf::Model(variables + 1);
+         for (unsigned variable = 1; variable <= variables; ++variable) {
+            model.assign(variable, 0 != ((assignment >> (variable - 1)) & 1));
+         }
+         if (model.satisfies(formula)) {
+            return true;
+         }
+      }
+      return false;
+   }
+
+   /**
+    * @brief Compressing makes the variables dense, renames single literals consistently and is undone by decompressing
+    *
+    */
+   void testRoundTrip() {
+      cnf::CNF formula = getFormula();
+      const std::vector<cnf::Literals> original = test::getClauses(formula);
+      CHECK(!formula.isCompressed());
+
+      formula.compress();
+      CHECK(formula.isCompressed());
+      CHECK(5 == formula.getMaxVariable());
+      CHECK(5 == formula.getVariables());
+      CHECK(test::hasExactStatistics(formula));
+
+      std::vector<cnf::Literals> renamed = original;
+      for (auto& clause : renamed) {
+         for (int& literal : clause) {
+            const int compressed = formula.compress(literal);
+            CHECK(literal == formula.decompress(compressed));
+            literal = compressed;
+         }
+      }
+      CHECK(renamed == test::getClauses(formula));
+
+      // compressing again changes nothing
+      formula.compress();
+      CHECK(renamed == test::getClauses(formula));
+
+      formula.decompress();
+      CHECK(original == test::getClauses(formula));
+      CHECK(9 == formula.getMaxVariable());
+      CHECK(test::hasExactStatistics(formula));
+   }
+
+   /**
+    * @brief A model of the compressed formula becomes a model of the original, and a model of the original one of the
+    * compressed formula
+    *
+    */
+   void testModels() {
+      cnf::CNF formula = getFormula();
+      cnf::CNF original = formula.clone();
+      formula.compress();
+
+      cnf::Model model;
+      CHECK(findModel(formula, model));
+      formula.decompress(model);
+      CHECK(model.satisfies(original));
+      for (const unsigned variable : {1u, 2u, 3u, 6u, 9u}) {
+         CHECK(model.isAssigned(variable));
+      }
+
+      formula.compress(model);
+      CHECK(model.satisfies(formula));
+   }
+
+   /**
+    * @brief Variables that were removed with a value get it back when a model is decompressed
+    *
+    */
+   void testBackpropagated() {
+      cnf::CNF formula = getFormula();
+      cnf::CNF original = formula.clone();
+
+      // a procedure removes the unit clause and the variable with it
+      formula.pop_back();
+      formula.setLiteralBackpropagated(2);
+      CHECK(6 == formula.getMaxVariable());
+      CHECK(0 == formula.compress(2));
+      CHECK(2 == formula.compress(9));
+      formula.compress();
+      CHECK(formula.isCompressed());
+      CHECK(4 == formula.getMaxVariable());
+
+      cnf::Model model;
+      CHECK(findModel(formula, model));
+      formula.decompress(model);
+      CHECK(model.isTrue(2));
+      CHECK(model.satisfies(original));
+
+      formula.decompress();
+      CHECK(9 == formula.getMaxVariable());
+      CHECK(4 == formula.getVariables());
+      original.pop_back();
+      CHECK(test::getClauses(original) == test::getClauses(formula));
+   }
+
+}
+
+int main() {
+   testRoundTrip();
+   testModels();
+   testBackpropagated();
+   return test::result();
+}
@@ -0,0 +1,137 @@
+/**
+ * @file DimacsParserTest.cpp
+ * @author Anton Reinhard
+ * @brief Tests of the DIMACS parser
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "TestUtility.h"
+#include "CNF.h"
+#include "io/DimacsParser.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace preppy;
+
+namespace {
+
+   /**
+    * @brief Normalizing clauses with repeated literals takes the duplicates back from the statistics
+    *
+    */
+   void testNormalizedDuplicates() {
+      const std::string input = "p cnf 7 3\n7 2 2 0\n-3 3 -3 3 0\n5 5 5 0\n";
+
+      io::DimacsParser parser(0, true);
+      CHECK(parser.parse(input.data(), input.data() + input.size()));
+      CHECK(parser.finish());
+      CHECK((parser.getLiterals() == cnf::Literals{2, 7, 0, 3, -3, 0, 5, 0}));
+      const std::vector<unsigned>& occurrences = parser.getVariableOccurrences();
+      CHECK(occurrences.size() > 7);
+      CHECK(1 == occurrences[2]);
+      CHECK(1 == occurrences[7]);
+      CHECK(2 == occurrences[3]);
+      CHECK(1 == occurrences[5]);
+      CHECK(4 == parser.getVariables());
+      CHECK(7 == parser.getMaxVariable());
+
+      cnf::CNF formula;
+      CHECK(formula.readFromFile(test::writeFile("duplicates.cnf", input), 1, true));
+      CHECK(3 == formula.size());
+      CHECK(test::hasExactStatistics(formula));
+   }
+
+   /**
+    * @brief A mapped file is read with comments, clauses spread over lines, an unterminated last clause and an end marker
+    *
+    */
+   void testMappedFile() {
+      const std::string input = "c a comment\np cnf 4 3\n1 -2\n\t3 0 c trailing comment\n-4 0 2\n  4 0\n%\n1 0\n";
+
+      cnf::CNF formula;
+      CHECK(formula.readFromFile(test::writeFile("mapped.cnf", input)));
+      CHECK((test::getClauses(formula) == std::vector<cnf::Literals>{{1, -2, 3}, {-4}, {2, 4}}));
+      CHECK(test::hasExactStatistics(formula));
+      CHECK(4 == formula.getVariables());
+
+      cnf::CNF unterminated;
+      CHECK(unterminated.readFromFile(test::writeFile("unterminated.cnf", "p cnf 3 2\n1 2 0\n-3 2")));
+      CHECK((test::getClauses(unterminated) == std::vector<cnf::Literals>{{1, 2}, {-3, 2}}));
+      CHECK(test::hasExactStatistics(unterminated));
+   }
+
+   /**
+    * @brief Malformed input is rejected
+    *
+    */
+   void testMalformedInput() {
+      cnf::CNF formula;
+      CHECK(!formula.readFromFile(test::writeFile("letter.cnf", "p cnf 2 1\n1 x 0\n")));
+      CHECK(!formula.readFromFile(test::writeFile("overflow.cnf", "p cnf 2 1\n1 99999999999 0\n")));
+      CHECK(!formula.readFromFile(test::writeFile("glued.cnf", "p cnf 2 1\n1 2x 0\n")));
+      CHECK(!formula.readFromFile(test::writeFile("problem.cnf", "p cnf 2 1\np cnf 2 1\n1 2 0\n")));
+      CHECK(!formula.readFromFile(test::writeFile("noproblem.cnf", "1 2 0\n")));
+      CHECK(!formula.readFromFile("missing.cnf"));
+   }
+
+   /**
+    * @brief Parsing a large input with several threads gives the same clauses and statistics as a single thread
+    *
+    */
+   void testParallelParsing() {
+      // the parser doesn't split ranges below 1 MiB, so the input needs a few MiB
+      std::mt19937 random(7);
+      std::uniform_int_distribution<int> variables(1, 5000);
+      std::uniform_int_distribution<int> lengths(1, 6);
+      std::string input = "c generated\np cnf 5000 400000\n";
+      for (unsigned clause = 0; clause < 400000; ++clause) {
+         if (0 == clause % 1000) {
+            input += "c 1 2 0 inside a comment\n";
+         }
+         const int length = lengths(random);
+         for (int i = 0; i < length; ++i) {
+            const int variable = variables(random);
+            input += std::to_string((0 == (variable & 1)) ? variable : -variable);
+            // some clauses continue on the next line
+            input += (3 == i) ? "\n" : " ";
+         }
+         input += "0\n";
+      }
+      CHECK(input.size() > 4 << 20);
+
+      io::DimacsParser sequential;
+      CHECK(sequential.parse(input.data(), input.data() + input.size()));
+      CHECK(sequential.finish());
+      io::DimacsParser parallel;
+      CHECK(parallel.parseParallel(input.data(), input.data() + input.size(), 4));
+      CHECK(parallel.finish());
+      CHECK(400000 == parallel.getClauses());
+      CHECK(sequential.getLiterals() == parallel.getLiterals());
+      CHECK(sequential.getVariableOccurrences() == parallel.getVariableOccurrences());
+      CHECK(sequential.getMaxVariable() == parallel.getMaxVariable());
+      CHECK(sequential.getVariables() == parallel.getVariables());
+
+      const std::string file = test::writeFile("parallel.cnf", input);
+      cnf::CNF single;
+      CHECK(single.readFromFile(file, 1));
+      cnf::CNF threaded;
+      CHECK(threaded.readFromFile(file, 4));
+      CHECK(test::getClauses(single) == test::getClauses(threaded));
+      CHECK(test::hasExactStatistics(threaded));
+   }
+
+}
+
+int main() {
+   testNormalizedDuplicates();
+   testMappedFile();
+   testMalformedInput();
+   testParallelParsing();
+   return test::result();
+}
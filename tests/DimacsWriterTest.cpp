@@ -0,0 +1,120 @@
+/**
+ * @file DimacsWriterTest.cpp
+ * @author Anton Reinhard
+ * @brief Tests of the DIMACS writer
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "TestUtility.h"
+#include "CNF.h"
+#include "Clause.h"
+#include "io/DimacsWriter.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace preppy;
+
+namespace {
+
+   /**
+    * @brief Generates a formula with clauses of different lengths
+    *
+    * @param clauses The number of clauses
+    * @return cnf::CNF The formula
+    */
+   cnf::CNF generateFormula(const unsigned clauses) {
+      std::mt19937 random(3);
+      std::uniform_int_distribution<int> literals(-100000, 100000);
+      std::uniform_int_distribution<int> lengths(1, 8);
+      cnf::CNF formula;
+      for (unsigned i = 0; i < clauses; ++i) {
+         cnf::Clause clause;
+         const int length = lengths(random);
+         while (static_cast<int>(clause.size()) < length) {
+            const int literal = literals(random);
+            if (0 != literal) {
+               clause.push_back(literal);
+            }
+         }
+         formula.push_back(clause);
+      }
+      return formula;
+   }
+
+   /**
+    * @brief Clauses are formatted as 0 terminated lines, including the longest literals
+    *
+    */
+   void testClauseLine() {
+      CHECK("1 -2147483647 2147483647 0\n" == cnf::Clause({1, -2147483647, 2147483647}).toCNFLine());
+      CHECK("-5 0\n" == cnf::Clause({-5}).toCNFLine());
+      CHECK("0\n" == cnf::Clause().toCNFLine());
+   }
+
+   /**
+    * @brief Text and clauses are written in order, even if the buffer has to be flushed in between
+    *
+    */
+   void testSmallBuffer() {
+      const cnf::CNF formula = {cnf::Clause({-3, 12}), cnf::Clause({7}), cnf::Clause({1, -2, 3})};
+      io::DimacsWriter writer(8);
+      CHECK(writer.open("small.cnf"));
+      CHECK(writer.write("p cnf 12 4\n"));
+      CHECK(writer.writeClause(cnf::Clause({123456789, -1})));
+      CHECK(writer.writeClauses(formula));
+      CHECK(writer.close());
+      CHECK("p cnf 12 4\n123456789 -1 0\n-3 12 0\n7 0\n1 -2 3 0\n" == test::readFile("small.cnf"));
+   }
+
+   /**
+    * @brief Formatting with several threads gives the same bytes as a single thread
+    *
+    */
+   void testThreads() {
+      const cnf::CNF formula = generateFormula(200000);
+      std::string expected;
+      for (const auto& clause : formula) {
+         expected += cnf::Clause(clause.begin(), clause.end()).toCNFLine();
+      }
+
+      for (const unsigned threads : {1u, 4u}) {
+         const std::string file = "threads" + std::to_string(threads) + ".cnf";
+         io::DimacsWriter writer(1 << 16, threads);
+         CHECK(writer.open(file));
+         CHECK(writer.writeClauses(formula));
+         CHECK(writer.close());
+         CHECK(expected == test::readFile(file));
+      }
+   }
+
+   /**
+    * @brief A written formula reads back to the same clauses
+    *
+    */
+   void testRoundTrip() {
+      cnf::CNF formula = generateFormula(5000);
+      CHECK(formula.writeToFile("roundtrip.cnf", true, 2));
+      cnf::CNF read;
+      CHECK(read.readFromFile("roundtrip.cnf"));
+      CHECK(test::getClauses(formula) == test::getClauses(read));
+      CHECK(formula.getMaxVariable() == read.getMaxVariable());
+
+      // existing files are only replaced when forced
+      CHECK(!formula.writeToFile("roundtrip.cnf", false));
+   }
+
+}
+
+int main() {
+   testClauseLine();
+   testSmallBuffer();
+   testThreads();
+   testRoundTrip();
+   return test::result();
+}
@@ -0,0 +1,211 @@
+/**
+ * @file ModelTest.cpp
+ * @author Anton Reinhard
+ * @brief Tests of the bit packed models
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "TestUtility.h"
+#include "CNF.h"
+#include "Clause.h"
+#include "Model.h"
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <vector>
+
+using namespace preppy;
+
+namespace {
+
+   /**
+    * @brief The values of a model as one entry per variable
+    *
+    */
+   typedef std::vector<int> Values;
+
+   /**
+    * @brief Checks a model against the values it should have
+    *
+    * @param model The model
+    * @param expected 1 for every true, -1 for every false and 0 for every unassigned variable
+    * @return bool True if the model assigns exactly the expected values
+    */
+   bool hasValues(const cnf::Model& model, const Values& expected) {
+      std::size_t assigned = 0;
+      std::size_t next = model.nextAssigned(1);
+      for (std::size_t variable = 1; variable < expected.size(); ++variable) {
+         const int value = expected[variable];
+         if (model.isAssigned(variable) != (0 != value) || model.isTrue(static_cast<int>(variable)) != (1 == value)
+             || model.isTrue(-static_cast<int>(variable)) != (-1 == value)) {
+            return false;
+         }
+         if (0 != value) {
+            if (next != variable) {
+               return false;
+            }
+            next = model.nextAssigned(variable + 1);
+            ++assigned;
+         }
+      }
+      return model.size() == next && assigned == model.countAssigned();
+   }
+
+   /**
+    * @brief Get a model with random values
+    *
+    * @param random The random number generator
+    * @param size The number of variables, including 0
+    * @param model The model to fill
+    * @return Values The values that were assigned
+    */
+   Values randomModel(std::mt19937& random, const std::size_t size, cnf::Model& model) {
+      std::uniform_int_distribution<int> values(-1, 1);
+      model = cnf::Model(size);
+      Values expected(size, 0);
+      for (std::size_t variable = 1; variable < size; ++variable) {
+         expected[variable] = values(random);
+         if (0 != expected[variable]) {
+            model.assign(variable, 1 == expected[variable]);
+         }
+      }
+      return expected;
+   }
+
+   /**
+    * @brief Assigning and unassigning across word boundaries, and growing and shrinking the model
+    *
+    */
+   void testAssign() {
+      std::mt19937 random(19);
+      std::uniform_int_distribution<std::size_t> variables(1, 199);
+      std::bernoulli_distribution value(0.5);
+
+      cnf::Model model;
+      CHECK(model.empty());
+      CHECK(!model.isTrue(5) && !model.isTrue(-5));
+      Values expected(200, 0);
+      for (unsigned step = 0; step < 2000; ++step) {
+         const std::size_t variable = variables(random);
+         if (value(random)) {
+            const bool assigned = value(random);
+            model.assign(variable, assigned);
+            expected[variable] = assigned ? 1 : -1;
+         }
+         else {
+            model.unassign(variable);
+            expected[variable] = 0;
+         }
+      }
+      model.resize(200);
+      CHECK(hasValues(model, expected));
+
+      // shrinking drops the values behind the new end, growing adds unassigned variables
+      model.resize(70);
+      model.resize(200);
+      std::fill(expected.begin() + 70, expected.end(), 0);
+      CHECK(hasValues(model, expected));
+
+      model.clear();
+      CHECK(model.empty());
+      CHECK(0 == model.countAssigned());
+   }
+
+   /**
+    * @brief Intersection keeps equal values, difference keeps opposite values, also for models of different sizes
+    *
+    */
+   void testIntersectAndDifference() {
+      std::mt19937 random(7);
+      for (const std::size_t otherSize : {200, 150, 64, 1}) {
+         cnf::Model model;
+         cnf::Model other;
+         const Values values = randomModel(random, 200, model);
+         Values otherValues = randomModel(random, otherSize, other);
+         otherValues.resize(200, 0);
+
+         Values intersection(200, 0);
+         Values difference(200, 0);
+         for (std::size_t variable = 1; variable < 200; ++variable) {
+            if (0 != values[variable] && values[variable] == otherValues[variable]) {
+               intersection[variable] = values[variable];
+            }
+            if (0 != values[variable] && values[variable] == -otherValues[variable]) {
+               difference[variable] = values[variable];
+            }
+         }
+
+         cnf::Model intersected = model;
+         intersected.intersect(other);
+         CHECK(hasValues(intersected, intersection));
+         cnf::Model differing = model;
+         differing.difference(other);
+         CHECK(hasValues(differing, difference));
+      }
+   }
+
+   /**
+    * @brief Renaming moves the values, dropping variables renamed to 0 and keeping variables behind the names
+    *
+    */
+   void testRename() {
+      cnf::Model model;
+      model.assign(1, true);
+      model.assign(2, false);
+      model.assign(3, true);
+      model.assign(100, false);
+      model.renameVariables({0, 70, 0, 1});
+      Values expected(101, 0);
+      expected[70] = 1;
+      expected[1] = 1;
+      expected[100] = -1;
+      CHECK(hasValues(model, expected));
+      CHECK(101 == model.size());
+   }
+
+   /**
+    * @brief A model satisfies a formula if it sets a literal of every clause to true, and survives a round trip
+    * through its string
+    *
+    */
+   void testSatisfiesAndRead() {
+      cnf::CNF formula = {cnf::Clause({1, -2}), cnf::Clause({2, 3, -70}), cnf::Clause({-1, 70})};
+      cnf::Model model;
+      model.assign(1, true);
+      model.assign(3, false);
+      CHECK(!model.satisfies(formula));
+      model.assign(70, true);
+      CHECK(!model.satisfies(formula));
+      model.assign(2, true);
+      CHECK(model.satisfies(formula));
+      model.unassign(3);
+      CHECK(model.satisfies(formula));
+      model.unassign(2);
+      CHECK(!model.satisfies(formula));
+
+      model.assign(2, false);
+      std::istringstream input("c a comment\nv " + model.toString() + "\nv 5 0\n");
+      cnf::Model read;
+      CHECK(read.readFromStream(input));
+      Values expected(71, 0);
+      expected[1] = 1;
+      expected[2] = -1;
+      expected[5] = 1;
+      expected[70] = 1;
+      CHECK(hasValues(read, expected));
+   }
+
+}
+
+int main() {
+   testAssign();
+   testIntersectAndDifference();
+   testRename();
+   testSatisfiesAndRead();
+   return test::result();
+}
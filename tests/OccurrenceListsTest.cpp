@@ -0,0 +1,157 @@
+/**
+ * @file OccurrenceListsTest.cpp
+ * @author Anton Reinhard
+ * @brief Tests of the occurrence lists kept by CNF
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "TestUtility.h"
+#include "CNF.h"
+#include "Clause.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace preppy;
+
+namespace {
+
+   /**
+    * @brief Checks the occurrence lists and counters of every literal up to a variable against the clauses
+    *
+    * @param formula The formula, with occurrence lists enabled
+    * @param maxVariable The largest variable to check
+    * @return bool True if the live entries of every list are exactly the clauses containing the literal
+    */
+   bool hasExactOccurrences(cnf::CNF& formula, const unsigned maxVariable) {
+      for (int variable = 1; variable <= static_cast<int>(maxVariable); ++variable) {
+         for (const int literal : {variable, -variable}) {
+            std::vector<cnf::ClauseRef> expected;
+            for (const auto& clause : formula) {
+               if (std::find(clause.begin(), clause.end(), literal) != clause.end()) {
+                  expected.push_back(clause.getRef());
+               }
+            }
+            std::vector<cnf::ClauseRef> listed;
+            for (const cnf::ClauseRef clause : formula.getOccurrences(literal)) {
+               if (!formula.isRemoved(clause)) {
+                  listed.push_back(clause);
+               }
+            }
+            std::sort(expected.begin(), expected.end());
+            std::sort(listed.begin(), listed.end());
+            if (expected != listed || expected.size() != formula.getOccurrenceCount(literal)) {
+               return false;
+            }
+         }
+      }
+      return true;
+   }
+
+   /**
+    * @brief The lists follow clauses being added and removed
+    *
+    */
+   void testAddAndRemove() {
+      cnf::CNF formula = {cnf::Clause({1, -2, 3}), cnf::Clause({-1, 2}), cnf::Clause({2, 3, 4})};
+      CHECK(!formula.hasOccurrenceLists());
+      formula.enableOccurrenceLists();
+      CHECK(formula.hasOccurrenceLists());
+      CHECK(hasExactOccurrences(formula, 5));
+      CHECK(2 == formula.getOccurrenceCount(2));
+
+      formula.push_back(cnf::Clause({-4, 5}));
+      formula.erase(formula.begin());
+      CHECK(hasExactOccurrences(formula, 5));
+      CHECK(0 == formula.getOccurrenceCount(1));
+
+      formula.pop_back();
+      CHECK(hasExactOccurrences(formula, 5));
+      CHECK(0 == formula.getOccurrenceCount(5));
+
+      formula.eraseIf([](cnf::ClauseView clause) {
+         return clause.setLiteral(-3);
+      });
+      CHECK(hasExactOccurrences(formula, 5));
+      CHECK(0 == formula.getOccurrenceCount(3));
+
+      formula.collectGarbage();
+      CHECK(hasExactOccurrences(formula, 5));
+
+      formula.disableOccurrenceLists();
+      CHECK(!formula.hasOccurrenceLists());
+   }
+
+   /**
+    * @brief Erasing a literal updates its list and keeps the clause watched by literals it still has
+    *
+    */
+   void testEraseLiteral() {
+      cnf::CNF formula = {cnf::Clause({1, 2, 3, 4}), cnf::Clause({-1, -2, 3})};
+      formula.enableOccurrenceLists();
+
+      formula.eraseLiteral(formula[0].getRef(), 1);
+      formula.eraseLiteral(formula[1].getRef(), -2);
+      CHECK(hasExactOccurrences(formula, 4));
+      CHECK(test::hasExactStatistics(formula));
+      CHECK((test::getClauses(formula) == std::vector<cnf::Literals>{{2, 3, 4}, {-1, 3}}));
+
+      // the binary clause now lives in the implication graph
+      formula.eraseLiteral(formula[0].getRef(), 3);
+      CHECK(hasExactOccurrences(formula, 4));
+      CHECK(formula.getBinaryImplications().size() == 2);
+   }
+
+   /**
+    * @brief Renaming a variable moves its lists, onto an unused as well as onto a used variable
+    *
+    */
+   void testRename() {
+      cnf::CNF formula = {cnf::Clause({1, -2, 3}), cnf::Clause({-1, 4}), cnf::Clause({2, 4, 6})};
+      formula.enableOccurrenceLists();
+
+      formula.renameVariable(6, 5);
+      CHECK(hasExactOccurrences(formula, 6));
+      CHECK(1 == formula.getOccurrenceCount(5));
+      CHECK(0 == formula.getOccurrenceCount(6));
+
+      // clauses of 3 and 4 are not listed twice
+      formula.renameVariable(3, 4);
+      CHECK(hasExactOccurrences(formula, 6));
+      CHECK(3 == formula.getOccurrenceCount(4));
+      CHECK(test::hasExactStatistics(formula));
+   }
+
+   /**
+    * @brief Copies and assigned formulas keep their own lists
+    *
+    */
+   void testCopy() {
+      cnf::CNF formula = {cnf::Clause({1, -2}), cnf::Clause({2, 3, -1})};
+      formula.enableOccurrenceLists();
+
+      cnf::CNF copy(formula);
+      copy.push_back(cnf::Clause({-1, -3}));
+      CHECK(copy.hasOccurrenceLists());
+      CHECK(hasExactOccurrences(copy, 3));
+      CHECK(hasExactOccurrences(formula, 3));
+      CHECK(1 == formula.getOccurrenceCount(-1));
+
+      formula = copy;
+      CHECK(hasExactOccurrences(formula, 3));
+      CHECK(2 == formula.getOccurrenceCount(-1));
+   }
+
+}
+
+int main() {
+   testAddAndRemove();
+   testEraseLiteral();
+   testRename();
+   testCopy();
+   return test::result();
+}
@@ -0,0 +1,317 @@
+/**
+ * @file ProceduresTest.cpp
+ * @author Anton Reinhard
+ * @brief Tests of the simplification procedures
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "TestUtility.h"
+#include "CNF.h"
+#include "Clause.h"
+#include "Model.h"
+#include "procedures/BipartitionAndElimination.h"
+#include "procedures/BooleanConstraintPropagation.h"
+#include "procedures/FailedLiteralProbing.h"
+#include "procedures/HyperBinaryResolution.h"
+#include "procedures/OccurrenceSimplification.h"
+#include "procedures/Vivification.h"
+#include "solvers/CDCL.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace preppy;
+
+namespace {
+
+   /**
+    * @brief The number of variables of the random formulas
+    *
+    */
+   constexpr unsigned VARIABLES = 8;
+
+   /**
+    * @brief Get a random formula without tautologies or duplicate literals
+    *
+    * @param random The random number generator
+    * @param clauses The number of clauses
+    * @return cnf::CNF The formula over the variables 1 to VARIABLES
+    */
+   cnf::CNF randomFormula(std::mt19937& random, const unsigned clauses) {
+      std::uniform_int_distribution<int> variables(1, VARIABLES);
+      std::uniform_int_distribution<int> lengths(2, 4);
+      std::bernoulli_distribution sign(0.5);
+
+      cnf::CNF formula;
+      for (unsigned i = 0; i < clauses; ++i) {
+         cnf::Clause clause;
+         const int length = lengths(random);
+         while (static_cast<int>(clause.size()) < length) {
+            const int variable = variables(random);
+            if (!clause.containsLiteral(variable) && !clause.containsLiteral(-variable)) {
+               clause.push_back(sign(random) ? variable : -variable);
+            }
+         }
+         formula.push_back(clause);
+      }
+      return formula;
+   }
+
+   /**
+    * @brief Checks whether a formula has a clause with exactly the given literals, in any order
+    *
+    * @param formula The formula
+    * @param literals The literals of the clause
+    * @return bool True if the formula has the clause
+    */
+   bool hasClause(const cnf::CNF& formula, cnf::Literals literals) {
+      std::sort(literals.begin(), literals.end());
+      for (cnf::Literals clause : test::getClauses(formula)) {
+         std::sort(clause.begin(), clause.end());
+         if (clause == literals) {
+            return true;
+         }
+      }
+      return false;
+   }
+
+   /**
+    * @brief Checks whether a formula has a model by trying every assignment of the variables
+    *
+    * @param formula The formula
+    * @return bool True if an assignment of the variables 1 to VARIABLES satisfies the formula
+    */
+   bool isSatisfiable(const cnf::CNF& formula) {
+      cnf::Model model(VARIABLES + 1);
+      for (unsigned assignment = 0; assignment < (1u << VARIABLES); ++assignment) {
+         for (unsigned variable = 1; variable <= VARIABLES; ++variable) {
+            model.assign(variable, 0 != ((assignment >> (variable - 1)) & 1));
+         }
+         if (model.satisfies(formula)) {
+            return true;
+         }
+      }
+      return false;
+   }
+
+   /**
+    * @brief Checks whether two formulas have the same models by trying every assignment of the variables
+    *
+    * @param first The first formula
+    * @param second The second formula
+    * @return bool True if every assignment of the variables 1 to VARIABLES satisfies both formulas or neither
+    */
+   bool isEquivalent(const cnf::CNF& first, const cnf::CNF& second) {
+      cnf::Model model(VARIABLES + 1);
+      for (unsigned assignment = 0; assignment < (1u << VARIABLES); ++assignment) {
+         for (unsigned variable = 1; variable <= VARIABLES; ++variable) {
+            model.assign(variable, 0 != ((assignment >> (variable - 1)) & 1));
+         }
+         if (model.satisfies(first) != model.satisfies(second)) {
+            return false;
+         }
+      }
+      return true;
+   }
+
+   /**
+    * @brief Vivification keeps random formulas equivalent, and drops a clause implied by the others
+    *
+    */
+   void testVivification() {
+      std::mt19937 random(21);
+      for (unsigned round = 0; round < 200; ++round) {
+         cnf::CNF formula = randomFormula(random, 4 + round % 30);
+         const cnf::CNF original = formula.clone();
+         procedures::Vivification vivification;
+         CHECK(vivification.apply(formula));
+         CHECK(isEquivalent(original, formula));
+         CHECK(formula.getLiterals() <= original.getLiterals());
+         CHECK(test::hasExactStatistics(formula));
+      }
+
+      // {1, 3, 4} follows from {1, 2} and {-2, 3}
+      cnf::CNF formula = {cnf::Clause({1, 2}), cnf::Clause({-2, 3}), cnf::Clause({1, 3, 4})};
+      procedures::Vivification vivification;
+      vivification.apply(formula);
+      CHECK(2 == formula.size());
+      CHECK(4 == formula.getLiterals());
+   }
+
+   /**
+    * @brief Occurrence Simplification keeps random formulas equivalent, and removes a literal whose clause still
+    * follows without it
+    *
+    */
+   void testOccurrenceSimplification() {
+      std::mt19937 random(12);
+      for (unsigned round = 0; round < 200; ++round) {
+         cnf::CNF formula = randomFormula(random, 4 + round % 30);
+         const cnf::CNF original = formula.clone();
+         procedures::OccurrenceSimplification simplification;
+         simplification.apply(formula);
+         CHECK(isEquivalent(original, formula));
+         CHECK(formula.getLiterals() <= original.getLiterals());
+         CHECK(!formula.hasOccurrenceLists());
+         CHECK(test::hasExactStatistics(formula));
+      }
+
+      // with {-1, 2} the clause {1, 2, 3} is equivalent to {2, 3}
+      cnf::CNF formula = {cnf::Clause({1, 2, 3}), cnf::Clause({-1, 2})};
+      procedures::OccurrenceSimplification simplification;
+      simplification.applySingleLiteral(formula, 1);
+      CHECK((test::getClauses(formula) == std::vector<cnf::Literals>{{2, 3}, {-1, 2}}));
+   }
+
+   /**
+    * @brief Applying a batch of literals in one pass gives the same clauses as applying them one after the other, and
+    * BCP keeps random formulas satisfiable exactly when they were
+    *
+    */
+   void testBooleanConstraintPropagation() {
+      std::mt19937 random(22);
+      std::uniform_int_distribution<int> variables(1, VARIABLES);
+      std::bernoulli_distribution sign(0.5);
+      const procedures::BooleanConstraintPropagation bcp;
+      for (unsigned round = 0; round < 200; ++round) {
+         const cnf::CNF original = randomFormula(random, 4 + round % 30);
+         cnf::Literals literals;
+         for (unsigned i = round % 5; i > 0; --i) {
+            const int variable = variables(random);
+            const int literal = sign(random) ? variable : -variable;
+            if (std::find(literals.begin(), literals.end(), -literal) == literals.end()) {
+               literals.push_back(literal);
+            }
+         }
+
+         cnf::CNF batch = original.clone();
+         bcp.applyLiterals(batch, literals);
+         cnf::CNF single = original.clone();
+         for (const int literal : literals) {
+            bcp.applySingleLiteral(single, literal);
+         }
+         CHECK(test::getClauses(single) == test::getClauses(batch));
+         CHECK(test::hasExactStatistics(batch));
+
+         // with the literals as unit clauses the formula keeps its models
+         cnf::CNF withUnits = original.clone();
+         for (const int literal : literals) {
+            withUnits.push_back(cnf::Clause({literal}));
+         }
+         cnf::CNF equivalent = original.clone();
+         bcp.applyLiteralsEq(equivalent, literals);
+         CHECK(isEquivalent(withUnits, equivalent));
+
+         cnf::CNF propagated = original.clone();
+         procedures::BooleanConstraintPropagation procedure;
+         procedure.apply(propagated);
+         CHECK(isSatisfiable(original) == isSatisfiable(propagated));
+      }
+
+      cnf::CNF withoutUnits = {cnf::Clause({-1, 2}), cnf::Clause({-2, 3, 4})};
+      procedures::BooleanConstraintPropagation procedure;
+      CHECK(procedure.getBcp(withoutUnits).empty());
+
+      cnf::CNF formula = {cnf::Clause({1}), cnf::Clause({-1, 2}), cnf::Clause({-2, 3, 4}), cnf::Clause({-3, 5})};
+      CHECK((cnf::Literals{1, 2} == procedure.getBcp(formula)));
+      procedure.apply(formula);
+      CHECK((test::getClauses(formula) == std::vector<cnf::Literals>{{3, 4}, {-3, 5}}));
+
+      formula.push_back(cnf::Clause({-4}));
+      formula.push_back(cnf::Clause({-5}));
+      CHECK((cnf::Literals{0} == procedure.getBcp(formula)));
+   }
+
+   /**
+    * @brief Probing keeps random formulas equivalent, learns the negation of failed literals and the literals implied
+    * by both literals of a variable, and probes the roots of the implication graph first
+    *
+    */
+   void testFailedLiteralProbing() {
+      std::mt19937 random(23);
+      for (unsigned round = 0; round < 200; ++round) {
+         cnf::CNF formula = randomFormula(random, 4 + round % 30);
+         const cnf::CNF original = formula.clone();
+         procedures::FailedLiteralProbing probing;
+         CHECK(probing.apply(formula));
+         CHECK(isEquivalent(original, formula));
+         CHECK(test::hasExactStatistics(formula));
+      }
+
+      // 1 fails, so -1 is learned and satisfies both clauses
+      cnf::CNF failed = {cnf::Clause({-1, 2}), cnf::Clause({-1, -2}), cnf::Clause({1, 3, 4})};
+      procedures::FailedLiteralProbing probing;
+      probing.apply(failed);
+      CHECK((test::getClauses(failed) == std::vector<cnf::Literals>{{3, 4}, {-1}}));
+
+      // both 1 and -1 imply 2
+      cnf::CNF implied = {cnf::Clause({1, 2}), cnf::Clause({-1, 2}), cnf::Clause({-2, 3, 4})};
+      probing.apply(implied);
+      CHECK((test::getClauses(implied) == std::vector<cnf::Literals>{{3, 4}, {2}}));
+
+      cnf::CNF chain = {cnf::Clause({-1, 2}), cnf::Clause({-2, 3})};
+      CHECK((cnf::Literals{1, -3, 2} == probing.getCandidates(chain)));
+   }
+
+   /**
+    * @brief Hyper Binary Resolution keeps random formulas equivalent, adds the binary resolvent of a probe and removes
+    * binary clauses that are implied over other binary clauses, also with a budget that stops it early
+    *
+    */
+   void testHyperBinaryResolution() {
+      std::mt19937 random(24);
+      for (unsigned round = 0; round < 200; ++round) {
+         cnf::CNF formula = randomFormula(random, 4 + round % 30);
+         const cnf::CNF original = formula.clone();
+         procedures::HyperBinaryResolution resolution((0 == round % 4) ? 5 : 10000000);
+         CHECK(resolution.apply(formula));
+         CHECK(isEquivalent(original, formula));
+         CHECK(test::hasExactStatistics(formula));
+      }
+
+      // 1 implies 2 and 3 and with them 4
+      cnf::CNF resolvent = {cnf::Clause({-1, 2}), cnf::Clause({-1, 3}), cnf::Clause({-2, -3, 4})};
+      procedures::HyperBinaryResolution resolution;
+      resolution.apply(resolvent);
+      CHECK(hasClause(resolvent, {-1, 4}));
+      CHECK(4 == resolvent.size());
+
+      // 1 implies 3 over 2
+      cnf::CNF transitive = {cnf::Clause({-1, 2}), cnf::Clause({-2, 3}), cnf::Clause({-1, 3})};
+      resolution.apply(transitive);
+      CHECK((test::getClauses(transitive) == std::vector<cnf::Literals>{{-1, 2}, {-2, 3}}));
+   }
+
+   /**
+    * @brief Bipartition finds the variable defined by the others, with every check on the formula loaded once
+    *
+    */
+   void testBipartition() {
+      // 3 is equal to 1 or 2, while 1 and 2 are free
+      const cnf::CNF formula = {cnf::Clause({-3, 1, 2}), cnf::Clause({3, -1}), cnf::Clause({3, -2})};
+      procedures::BipartitionAndElimination bipartition(std::make_shared<solvers::CDCL>(std::chrono::seconds(5)));
+      CHECK((cnf::Variables{3} == bipartition.bipartition(formula)));
+
+      // 2 is equal to 1 and checked first, since it is in fewer clauses
+      const cnf::CNF equal = {cnf::Clause({-1, 2}), cnf::Clause({1, -2}), cnf::Clause({1, 3, 4})};
+      CHECK((cnf::Variables{2} == bipartition.bipartition(equal)));
+   }
+
+}
+
+int main() {
+   testVivification();
+   testOccurrenceSimplification();
+   testBooleanConstraintPropagation();
+   testFailedLiteralProbing();
+   testHyperBinaryResolution();
+   testBipartition();
+   return test::result();
+}
@@ -0,0 +1,240 @@
+/**
+ * @file PropagatorTest.cpp
+ * @author Anton Reinhard
+ * @brief Tests of the two watched literal unit propagation
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "TestUtility.h"
+#include "CNF.h"
+#include "Clause.h"
+#include "Propagator.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <random>
+#include <vector>
+
+using namespace preppy;
+
+namespace {
+
+   /**
+    * @brief Propagates by scanning all clauses until nothing changes
+    *
+    * @param formula The formula
+    * @param assumptions The literals set to true before propagating
+    * @param implied Set to every literal that is true afterwards, sorted
+    * @return bool False if a clause was falsified
+    */
+   bool propagateNaively(const cnf::CNF& formula, const cnf::Literals& assumptions, cnf::Literals& implied) {
+      implied = assumptions;
+      const auto isTrue = [&implied](const int literal) {
+         return std::find(implied.begin(), implied.end(), literal) != implied.end();
+      };
+      bool changed = true;
+      while (changed) {
+         changed = false;
+         for (const auto& clause : formula) {
+            if (std::any_of(clause.begin(), clause.end(), isTrue)) {
+               continue;
+            }
+            cnf::Literals open;
+            for (const int literal : clause) {
+               if (!isTrue(-literal)) {
+                  open.push_back(literal);
+               }
+            }
+            if (open.empty()) {
+               return false;
+            }
+            if (1 == open.size()) {
+               implied.push_back(open[0]);
+               changed = true;
+            }
+         }
+      }
+      std::sort(implied.begin(), implied.end());
+      return true;
+   }
+
+   /**
+    * @brief Get the assigned literals of a propagator
+    *
+    * @param propagator The propagator
+    * @return cnf::Literals The literals on the trail, sorted
+    */
+   cnf::Literals getAssigned(const cnf::Propagator& propagator) {
+      cnf::Literals assigned = propagator.getTrail();
+      std::sort(assigned.begin(), assigned.end());
+      return assigned;
+   }
+
+   /**
+    * @brief Checks that every implied literal on the trail has a reason clause whose other literals are false and
+    * were assigned before it
+    *
+    * @param formula The bound formula
+    * @param propagator The propagator
+    * @return bool True if all reasons are valid
+    */
+   bool hasValidReasons(cnf::CNF& formula, const cnf::Propagator& propagator) {
+      const cnf::Literals& trail = propagator.getTrail();
+      for (std::size_t position = 0; position < trail.size(); ++position) {
+         const unsigned variable = static_cast<unsigned>(std::abs(trail[position]));
+         const cnf::ClauseRef reason = propagator.getReason(variable);
+         if (cnf::Propagator::NO_CLAUSE == reason) {
+            continue;
+         }
+         const cnf::Literals clause = test::getLiterals(formula.getClause(reason));
+         if (std::find(clause.begin(), clause.end(), trail[position]) == clause.end()) {
+            return false;
+         }
+         for (const int literal : clause) {
+            const auto end = trail.begin() + static_cast<std::ptrdiff_t>(position);
+            if (literal != trail[position] && std::find(trail.begin(), end, -literal) == end) {
+               return false;
+            }
+         }
+      }
+      return true;
+   }
+
+   /**
+    * @brief Propagating random decisions on random formulas gives the same literals and conflicts as propagating
+    * naively, and backtracking gives back the assignment of the level
+    *
+    */
+   void testRandomFormulas() {
+      std::mt19937 random(20);
+      std::uniform_int_distribution<int> variables(1, 12);
+      std::uniform_int_distribution<int> lengths(1, 4);
+      std::bernoulli_distribution sign(0.5);
+      const auto randomLiteral = [&]() {
+         const int variable = variables(random);
+         return sign(random) ? variable : -variable;
+      };
+
+      cnf::Propagator propagator;
+      unsigned conflicts = 0;
+      for (unsigned round = 0; round < 300; ++round) {
+         cnf::CNF formula;
+         for (unsigned clauses = 0; clauses < 30; ++clauses) {
+            cnf::Clause clause;
+            // few unit clauses, so decisions have something left to do
+            const int length = (0 == clauses % 10) ? lengths(random) : 1 + lengths(random);
+            while (static_cast<int>(clause.size()) < length) {
+               const int literal = randomLiteral();
+               if (!clause.containsLiteral(literal) && !clause.containsLiteral(-literal)) {
+                  clause.push_back(literal);
+               }
+            }
+            formula.push_back(clause);
+         }
+
+         // the same propagator is bound to every formula
+         propagator.bind(formula);
+         cnf::Literals assumptions;
+         cnf::Literals expected;
+         bool consistent = propagateNaively(formula, assumptions, expected);
+         CHECK(consistent == (cnf::Propagator::NO_CLAUSE == propagator.propagate()));
+         if (!consistent) {
+            ++conflicts;
+            continue;
+         }
+         CHECK(expected == getAssigned(propagator));
+         const cnf::Literals levelZero = getAssigned(propagator);
+
+         while (consistent) {
+            const int literal = randomLiteral();
+            if (cnf::LITERAL_VALUE::UNASSIGNED != propagator.getValue(literal)) {
+               if (expected.size() == 12) {
+                  break;
+               }
+               continue;
+            }
+            CHECK(propagator.assume(literal));
+            CHECK(assumptions.size() + 1 == propagator.getLevel());
+            CHECK(propagator.getLevel() == propagator.getLevel(static_cast<unsigned>(std::abs(literal))));
+            CHECK(cnf::Propagator::NO_CLAUSE == propagator.getReason(static_cast<unsigned>(std::abs(literal))));
+            assumptions.push_back(literal);
+
+            consistent = propagateNaively(formula, assumptions, expected);
+            const cnf::ClauseRef conflict = propagator.propagate();
+            CHECK(consistent == (cnf::Propagator::NO_CLAUSE == conflict));
+            if (consistent) {
+               CHECK(expected == getAssigned(propagator));
+            }
+            else {
+               ++conflicts;
+               const cnf::Literals clause = test::getLiterals(formula.getClause(conflict));
+               CHECK(std::all_of(clause.begin(), clause.end(), [&propagator](const int other) {
+                  return cnf::LITERAL_VALUE::FALSE == propagator.getValue(other);
+               }));
+            }
+            CHECK(hasValidReasons(formula, propagator));
+         }
+
+         propagator.backtrack(0);
+         CHECK(0 == propagator.getLevel());
+         CHECK(levelZero == getAssigned(propagator));
+      }
+      CHECK(conflicts > 50);
+   }
+
+   /**
+    * @brief Clauses added to the bound formula and shortened clauses are propagated, removing a clause that implied a
+    * literal takes the literal back
+    *
+    */
+   void testChangedFormula() {
+      cnf::CNF formula = {cnf::Clause({-1, 2, 3}), cnf::Clause({-2, 4}), cnf::Clause({-3, -4, 5})};
+      cnf::Propagator propagator(formula);
+      CHECK(cnf::Propagator::NO_CLAUSE == propagator.propagate());
+      CHECK(propagator.getTrail().empty());
+
+      formula.push_back(cnf::Clause({1}));
+      propagator.addClause(formula.back().getRef());
+      CHECK(cnf::Propagator::NO_CLAUSE == propagator.propagate());
+      CHECK((cnf::Literals{1} == getAssigned(propagator)));
+
+      // {-1, 2, 3} becomes {-1, 2}
+      formula.eraseLiteral(formula[0].getRef(), 3);
+      propagator.eraseLiteral(formula[0].getRef());
+      CHECK(cnf::Propagator::NO_CLAUSE == propagator.propagate());
+      CHECK((cnf::Literals{1, 2, 4} == getAssigned(propagator)));
+      CHECK(formula[0].getRef() == propagator.getReason(2));
+
+      formula.push_back(cnf::Clause({-4, -2}));
+      propagator.addClause(formula.back().getRef());
+      const cnf::ClauseRef conflict = propagator.propagate();
+      CHECK(cnf::Propagator::NO_CLAUSE != conflict);
+
+      const cnf::ClauseRef unit = formula[3].getRef();
+      formula.erase(std::next(formula.begin(), 3));
+      propagator.removeClause(unit);
+      CHECK(cnf::Propagator::NO_CLAUSE == propagator.propagate());
+      CHECK(propagator.getTrail().empty());
+      CHECK(cnf::LITERAL_VALUE::UNASSIGNED == propagator.getValue(1));
+
+      CHECK(propagator.assume(1));
+      CHECK(!propagator.assign(-1));
+      CHECK(cnf::Propagator::NO_CLAUSE != propagator.propagate());
+      propagator.backtrack(0);
+      CHECK(propagator.assume(-2));
+      CHECK(cnf::Propagator::NO_CLAUSE == propagator.propagate());
+      CHECK((cnf::Literals{-2, -1} == getAssigned(propagator)));
+   }
+
+}
+
+int main() {
+   testRandomFormulas();
+   testChangedFormula();
+   return test::result();
+}
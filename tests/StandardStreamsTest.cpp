@@ -0,0 +1,94 @@
+/**
+ * @file StandardStreamsTest.cpp
+ * @author Anton Reinhard
+ * @brief Tests of reading from the standard input and writing to the standard output
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "TestUtility.h"
+#include "CNF.h"
+#include "Clause.h"
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef PREPPY_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+using namespace preppy;
+
+namespace {
+
+   /**
+    * @brief A formula is read from the standard input with -
+    *
+    */
+   void testReadStandardInput() {
+      test::writeFile("stdin.cnf", "c piped\np cnf 3 2\n1 -2 0\n2 3 0\n");
+      CHECK(nullptr != std::freopen("stdin.cnf", "rb", stdin));
+
+      cnf::CNF formula;
+      CHECK(formula.readFromFile("-"));
+      CHECK((test::getClauses(formula) == std::vector<cnf::Literals>{{1, -2}, {2, 3}}));
+      CHECK(test::hasExactStatistics(formula));
+   }
+
+#ifdef PREPPY_HAVE_ZLIB
+
+   /**
+    * @brief Compressed input is detected on the standard input as well
+    *
+    */
+   void testReadCompressedStandardInput() {
+      const std::string content = "p cnf 2 1\n-1 2 0\n";
+      gzFile file = gzopen("stdin.cnf.gz", "wb");
+      gzwrite(file, content.data(), static_cast<unsigned>(content.size()));
+      gzclose(file);
+      CHECK(nullptr != std::freopen("stdin.cnf.gz", "rb", stdin));
+
+      cnf::CNF formula;
+      CHECK(formula.readFromFile("-"));
+      CHECK((test::getClauses(formula) == std::vector<cnf::Literals>{{-1, 2}}));
+   }
+
+#endif
+
+   /**
+    * @brief A formula written to the standard output with - reads back to the same clauses, as DIMACS and in the
+    * binary format
+    *
+    */
+   void testWriteStandardOutput() {
+      cnf::CNF formula = {cnf::Clause({4, -1}), cnf::Clause({2}), cnf::Clause({-3, 1, 2})};
+
+      for (const bool binary : {false, true}) {
+         const std::string file = binary ? "stdout.pcnf" : "stdout.cnf";
+         std::cout.flush();
+         CHECK(nullptr != std::freopen(file.c_str(), "wb", stdout));
+         CHECK(formula.writeToFile("-", false, 1, binary));
+         std::cout.flush();
+         std::fflush(stdout);
+
+         cnf::CNF read;
+         CHECK(read.readFromFile(file));
+         CHECK(test::getClauses(formula) == test::getClauses(read));
+      }
+   }
+
+}
+
+int main() {
+   testReadStandardInput();
+#ifdef PREPPY_HAVE_ZLIB
+   testReadCompressedStandardInput();
+#endif
+   testWriteStandardOutput();
+   return test::result();
+}
@@ -0,0 +1,160 @@
+/**
+ * @file TestUtility.h
+ * @author Anton Reinhard
+ * @brief Helpers shared by the tests
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+#include "CNF.h"
+#include "definitions.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Checks a condition, a failed check is reported with its location and fails the test at the end
+ *
+ */
+#define CHECK(condition) preppy::test::check((condition), #condition, __FILE__, __LINE__)
+
+namespace preppy::test {
+
+   /**
+    * @brief Get the number of failed checks
+    *
+    * @return int& The number of failed checks so far
+    */
+   inline int& failures() {
+      static int failed = 0;
+      return failed;
+   }
+
+   /**
+    * @brief Reports a failed check
+    *
+    * @param condition The result of the check
+    * @param expression The checked expression
+    * @param file The file of the check
+    * @param line The line of the check
+    */
+   inline void check(const bool condition, const char* expression, const char* file, const int line) {
+      if (!condition) {
+         ++failures();
+         std::cerr << file << ":" << line << ": check failed: " << expression << std::endl;
+      }
+   }
+
+   /**
+    * @brief Get the exit code of the test
+    *
+    * @return int 0 if all checks passed
+    */
+   inline int result() {
+      if (0 != failures()) {
+         std::cerr << failures() << " checks failed" << std::endl;
+         return EXIT_FAILURE;
+      }
+      return EXIT_SUCCESS;
+   }
+
+   /**
+    * @brief Writes a string to a file in the working directory of the test
+    *
+    * @param name The file name
+    * @param content The content of the file
+    * @return std::string The file name
+    */
+   inline std::string writeFile(const std::string& name, const std::string& content) {
+      std::ofstream file(name, std::ios::binary | std::ios::trunc);
+      file << content;
+      return name;
+   }
+
+   /**
+    * @brief Reads a whole file
+    *
+    * @param name The file name
+    * @return std::string The content of the file
+    */
+   inline std::string readFile(const std::string& name) {
+      std::ifstream file(name, std::ios::binary);
+      return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+   }
+
+   /**
+    * @brief Get the literals of a clause
+    *
+    * @param clause The clause
+    * @return cnf::Literals The literals of the clause in order
+    */
+   inline cnf::Literals getLiterals(const cnf::ClauseView& clause) {
+      return cnf::Literals(clause.begin(), clause.end());
+   }
+
+   /**
+    * @brief Get the literals of all clauses of a formula
+    *
+    * @param formula The formula
+    * @return std::vector<cnf::Literals> The literals of every clause in order
+    */
+   inline std::vector<cnf::Literals> getClauses(const cnf::CNF& formula) {
+      std::vector<cnf::Literals> clauses;
+      for (const auto& clause : formula) {
+         clauses.emplace_back(clause->begin(), clause->end());
+      }
+      return clauses;
+   }
+
+   /**
+    * @brief Checks the statistics a formula maintains against a count over its clauses
+    *
+    * @param formula The formula
+    * @return bool True if the variable occurrences, the number of variables, the maximum variable and the number of
+    * literals match
+    */
+   inline bool hasExactStatistics(cnf::CNF& formula) {
+      std::vector<unsigned> occurrences;
+      unsigned literals = 0;
+      for (const auto& clause : formula) {
+         for (const int literal : *clause) {
+            ++literals;
+            const unsigned variable = static_cast<unsigned>(std::abs(literal));
+            if (0 == variable) {
+               // the literal of an unsatisfied clause counts as a literal, but not as a variable
+               continue;
+            }
+            if (variable >= occurrences.size()) {
+               occurrences.resize(variable + 1, 0);
+            }
+            ++occurrences[variable];
+         }
+      }
+
+      unsigned variables = 0;
+      unsigned maxVariable = 0;
+      for (unsigned variable = 1; variable < occurrences.size(); ++variable) {
+         if (0 != occurrences[variable]) {
+            ++variables;
+            maxVariable = variable;
+         }
+      }
+      std::vector<unsigned> counted = formula.countVariables();
+      occurrences.resize(std::max(counted.size(), occurrences.size()), 0);
+      counted.resize(occurrences.size(), 0);
+      return counted == occurrences && formula.getVariables() == variables && formula.getMaxVariable() == maxVariable
+         && formula.getLiterals() == literals;
+   }
+
+}
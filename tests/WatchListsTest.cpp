@@ -0,0 +1,116 @@
+/**
+ * @file WatchListsTest.cpp
+ * @author Anton Reinhard
+ * @brief Tests of the literal indexed watch lists
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#include "TestUtility.h"
+#include "WatchLists.h"
+
+#include <vector>
+
+using namespace preppy;
+
+namespace {
+
+   /**
+    * @brief Counts the watches of a clause in the list of a literal
+    *
+    * @param lists The watch lists
+    * @param literal The literal
+    * @param clause The clause
+    * @return std::size_t The number of watches of the clause
+    */
+   std::size_t countWatches(cnf::WatchLists& lists, const int literal, const cnf::ClauseRef clause) {
+      std::size_t count = 0;
+      for (const cnf::Watch& watch : lists[literal]) {
+         count += (watch.clause == clause) ? 1 : 0;
+      }
+      return count;
+   }
+
+   /**
+    * @brief Watches are added to the list of their literal, which grows on demand
+    *
+    */
+   void testWatch() {
+      cnf::WatchLists lists;
+      CHECK(lists.empty());
+      lists.watch(-3, 0, 5);
+      lists.watch(1000, 1, 2);
+      CHECK(!lists.empty());
+      CHECK(1 == lists[-3].size());
+      CHECK(0 == lists[-3][0].clause && 5 == lists[-3][0].blocker);
+      CHECK(lists[3].empty());
+      CHECK(1 == lists[1000].size());
+
+      lists.clear(10);
+      CHECK(lists.empty());
+      CHECK(lists[-3].empty());
+   }
+
+   /**
+    * @brief Watches of removed clauses stay until half of all watches are stale, then all lists are swept
+    *
+    */
+   void testLazyRemoval() {
+      cnf::WatchLists lists;
+      for (cnf::ClauseRef clause = 0; clause < 4; ++clause) {
+         lists.watch(1, clause, 2);
+         lists.watch(2, clause, 1);
+      }
+      std::vector<bool> removed(4, false);
+      const auto isRemoved = [&removed](const cnf::ClauseRef clause) {
+         return removed[clause];
+      };
+
+      removed[0] = true;
+      lists.remove(2, isRemoved);
+      removed[1] = true;
+      lists.remove(2, isRemoved);
+      CHECK(4 == lists[1].size());
+
+      removed[2] = true;
+      lists.remove(2, isRemoved);
+      removed[3] = true;
+      lists.remove(2, isRemoved);
+      CHECK(lists[1].empty());
+      CHECK(lists[2].empty());
+   }
+
+   /**
+    * @brief Unwatching drops the watches of a clause from one list right away, reserving keeps the lists in place
+    *
+    */
+   void testUnwatch() {
+      cnf::WatchLists lists;
+      lists.reserve(10);
+      const std::vector<cnf::Watch>* list = &lists[-10];
+      lists.watch(1, 0, 2);
+      lists.watch(2, 0, 1);
+      lists.watch(1, 1, 3);
+      CHECK(list == &lists[-10]);
+
+      lists.unwatch(1, 0);
+      CHECK(0 == countWatches(lists, 1, 0));
+      CHECK(1 == countWatches(lists, 1, 1));
+      CHECK(1 == countWatches(lists, 2, 0));
+
+      lists.unwatch(2, 0);
+      lists.unwatch(1, 1);
+      CHECK(lists.empty());
+   }
+
+}
+
+int main() {
+   testWatch();
+   testLazyRemoval();
+   testUnwatch();
+   return test::result();
+}